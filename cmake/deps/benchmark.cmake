@@ -0,0 +1,30 @@
+# Copyright 2024 openGemini Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+include_guard()
+include(FetchContent)
+
+message(STATUS "Looking for Google Benchmark.")
+find_package(benchmark)
+
+if (NOT benchmark_FOUND)
+    message(STATUS "Google Benchmark not found, try using FetchContent instead.")
+    set(BENCHMARK_ENABLE_TESTING OFF)
+    FetchContent_Declare(benchmark
+        GIT_REPOSITORY https://github.com/google/benchmark
+        GIT_TAG        v1.8.3
+        GIT_PROGRESS   TRUE
+    )
+    FetchContent_MakeAvailable(benchmark)
+endif()
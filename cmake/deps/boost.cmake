@@ -21,12 +21,12 @@ set(OPENGEMINI_BOOST_HEADER_TARGETS "Boost::headers")
 
 if(NOT Boost_FOUND AND OPENGEMINI_USE_FETCHCONTENT)
     message(STATUS "Boost not found, try using FetchContent instead.")
-    set(BOOST_INCLUDE_LIBRARIES asio beast functional coroutine serialization url)
+    set(BOOST_INCLUDE_LIBRARIES asio beast container core crc functional coroutine interprocess serialization url)
     set(BOOST_ENABLE_CMAKE ON)
     FetchContent_Declare(Boost
         URL      https://github.com/boostorg/boost/releases/download/boost-1.85.0/boost-1.85.0-cmake.7z
         URL_HASH SHA256=2399fb7b15c84c9dafc4ffb1be69c076da36e541fb960fd971b960c180023f2b
     )
     FetchContent_MakeAvailable(Boost)
-    set(OPENGEMINI_BOOST_HEADER_TARGETS "Boost::asio;Boost::beast;Boost::functional")
+    set(OPENGEMINI_BOOST_HEADER_TARGETS "Boost::asio;Boost::beast;Boost::container;Boost::core;Boost::crc;Boost::functional;Boost::interprocess")
 endif()
@@ -21,6 +21,31 @@
 #include <opengemini/Client.hpp>
 #include <opengemini/ClientConfigBuilder.hpp>
 #include <opengemini/Exception.hpp>
+#include <opengemini/Measurement.hpp>
+
+// A user-defined type with fixed schema.
+struct Weather {
+    std::string             city;
+    std::string             weather;
+    int64_t                 humidity;
+    double                  temperature;
+    opengemini::Point::Time time;
+};
+
+// Describes how the type is written as a measurement, the keys are escaped at
+// compile time.
+template<>
+struct opengemini::MeasurementTraits<Weather> {
+    static constexpr auto measurement =
+        schema::Measurement("ExampleMeasurement");
+    static constexpr auto tags =
+        std::make_tuple(schema::Tag("City", &Weather::city));
+    static constexpr auto fields =
+        std::make_tuple(schema::Field("Weather", &Weather::weather),
+                        schema::Field("Humidity", &Weather::humidity),
+                        schema::Field("Temperature", &Weather::temperature));
+    static constexpr auto time = &Weather::time;
+};
 
 int main(int argc, char** argv)
 {
@@ -70,6 +95,48 @@ int main(int argc, char** argv)
                      { std::move(point1), std::move(point2) });
     }
 
+    {
+        // Constructs a batch of points stored in columns, all columns must
+        // have the same number of rows.
+        opengemini::PointBatch batch{
+            "ExampleMeasurement",
+            {
+                { "Weather", std::vector<std::string>{ "sunny", "rainy" } },
+                { "Humidity", std::vector<int64_t>{ 521, 333 } },
+                { "Temperature", std::vector<double>{ 38.1, 36.5 } },
+            },
+            { std::chrono::system_clock::now(),
+              std::chrono::system_clock::now() },
+            { { "City", "Shenzhen" } },
+        };
+
+        // Writes the whole batch to server, the operation will
+        // block until completes or an exception is thrown.
+        client.Write("ExampleDatabase", std::move(batch));
+    }
+
+    {
+        // Writes objects of the user-defined type directly, the operation will
+        // block until completes or an exception is thrown.
+        client.Write("ExampleDatabase",
+                     std::vector<Weather>{
+                         { "Shenzhen", "sunny", 521, 38.1,
+                           std::chrono::system_clock::now() },
+                         { "Shanghai", "rainy", 333, 36.5,
+                           std::chrono::system_clock::now() },
+                     });
+    }
+
+    {
+        // Writes content already encoded in line protocol as it is, the
+        // operation will block until completes or an exception is thrown.
+        client.Write("ExampleDatabase",
+                     opengemini::RawLines{
+                         "ExampleMeasurement,City=Shenzhen Humidity=521i\n"
+                         "ExampleMeasurement,City=Shanghai Humidity=333i\n",
+                     });
+    }
+
     {
         // Performs a write request which will fail.
         try {
@@ -19,8 +19,13 @@
 
 #include "opengemini/ClientConfig.hpp"
 #include "opengemini/CompletionToken.hpp"
+#include "opengemini/FlatPoint.hpp"
+#include "opengemini/Measurement.hpp"
 #include "opengemini/Point.hpp"
+#include "opengemini/PointBatch.hpp"
+#include "opengemini/PointView.hpp"
 #include "opengemini/Query.hpp"
+#include "opengemini/RawLines.hpp"
 #include "opengemini/RetentionPolicy.hpp"
 
 namespace opengemini {
@@ -400,6 +405,9 @@ public:
     ///
     /// \~English
     /// @brief Write multiple points.
+    /// @details Timestamps are encoded in the precision of their points, which
+    /// is sent along with them. Points of different precisions are written by
+    /// one request per precision.
     /// @param database Name of the database.
     /// @param points A vector of points.
     /// @param retentionPolicy Name of the retention policy, default to empty
@@ -418,6 +426,8 @@ public:
     ///
     /// \~Chinese
     /// @brief 写入多个点位。
+    /// @details 时间戳按所属点位的精度编码，并随其一同发送该精度。
+    /// 不同精度的点位将按精度分别通过各自的请求写入。
     /// @param database 数据库名称。
     /// @param points 点位数组。
     /// @param retentionPolicy
@@ -438,6 +448,307 @@ public:
                              std::string_view   retentionPolicy = {},
                              COMPLETION_TOKEN&& token           = {});
 
+    ///
+    /// \~English
+    /// @brief Write a batch of points stored in columns.
+    /// @details Prefer this overload for large amounts of rows of the same
+    /// measurement, which avoids building a @ref Point for every row.
+    /// @param database Name of the database.
+    /// @param batch Rows of one measurement as @ref PointBatch .
+    /// @param retentionPolicy Name of the retention policy, default to empty
+    /// string (no retention policy is specified).
+    /// @param token The completion token which will be invoked when the task
+    /// complete. Default to @ref token::sync if this parameter is not
+    /// specified. If passing function object as token, the function signature
+    /// must be:
+    /// @code
+    /// void (
+    ///     // Result of operation, it means success if the value is nullptr,
+    ///     // otherwise, contains an exception.
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    /// \~Chinese
+    /// @brief 写入一批以列存储的点位。
+    /// @details 写入同一度量的大量数据行时推荐使用该重载，以避免为每一行构造
+    /// @ref Point 。
+    /// @param database 数据库名称。
+    /// @param batch 同一度量的多行数据 @ref PointBatch 。
+    /// @param retentionPolicy
+    /// 保留策略名称，默认值为空字符串（即不指定保留策略）。
+    /// @param token 任务完成令牌，将在任务完成后被调用。
+    /// 若没有指定该参数，则使用默认值：@ref token::sync 。
+    /// 若传递函数对象作为完成令牌，则其签名必须满足：
+    /// @code
+    /// void (
+    ///     // 执行结果，仅当值为nullptr时代表成功，否则将承载相关的异常。
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    template<typename COMPLETION_TOKEN = token::Sync>
+    [[nodiscard]] auto Write(std::string_view   database,
+                             PointBatch         batch,
+                             std::string_view   retentionPolicy = {},
+                             COMPLETION_TOKEN&& token           = {});
+
+    ///
+    /// \~English
+    /// @brief Write content already encoded in line protocol.
+    /// @details The content is sent as it is, which avoids parsing it back
+    /// into points only to encode them again, e.g. when relaying or replaying
+    /// line protocol. Its framing is only checked if @ref RawLines::validate
+    /// is set, otherwise malformed lines are rejected by the server.
+    /// @param database Name of the database.
+    /// @param lines Lines to be written as @ref RawLines .
+    /// @param retentionPolicy Name of the retention policy, default to empty
+    /// string (no retention policy is specified).
+    /// @param token The completion token which will be invoked when the task
+    /// complete. Default to @ref token::sync if this parameter is not
+    /// specified. If passing function object as token, the function signature
+    /// must be:
+    /// @code
+    /// void (
+    ///     // Result of operation, it means success if the value is nullptr,
+    ///     // otherwise, contains an exception.
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    /// \~Chinese
+    /// @brief 写入已按行协议编码的内容。
+    /// @details 内容将被原样发送，例如转发或回放行协议时，无需将其解析为点位后再次编码。
+    /// 仅当设置了 @ref RawLines::validate
+    /// 时才检查其格式，否则格式错误的行将由服务端拒绝。
+    /// @param database 数据库名称。
+    /// @param lines 待写入的 @ref RawLines 。
+    /// @param retentionPolicy
+    /// 保留策略名称，默认值为空字符串（即不指定保留策略）。
+    /// @param token 任务完成令牌，将在任务完成后被调用。
+    /// 若没有指定该参数，则使用默认值：@ref token::sync 。
+    /// 若传递函数对象作为完成令牌，则其签名必须满足：
+    /// @code
+    /// void (
+    ///     // 执行结果，仅当值为nullptr时代表成功，否则将承载相关的异常。
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    template<typename COMPLETION_TOKEN = token::Sync>
+    [[nodiscard]] auto Write(std::string_view   database,
+                             RawLines           lines,
+                             std::string_view   retentionPolicy = {},
+                             COMPLETION_TOKEN&& token           = {});
+
+    ///
+    /// \~English
+    /// @brief Write a @ref FlatPoint , a @ref PointView or an object of a
+    /// user-defined measurement type.
+    /// @details Only available for @ref FlatPoint , @ref PointView and types
+    /// which specialize @ref MeasurementTraits , the latter are encoded with
+    /// the keys escaped at compile time. A @ref PointView is encoded before
+    /// this function returns, so the data it refers to may be released right
+    /// after the call, whatever the completion token is.
+    /// @param database Name of the database.
+    /// @param point Single point.
+    /// @param retentionPolicy Name of the retention policy, default to empty
+    /// string (no retention policy is specified).
+    /// @param token The completion token which will be invoked when the task
+    /// complete. Default to @ref token::sync if this parameter is not
+    /// specified. If passing function object as token, the function signature
+    /// must be:
+    /// @code
+    /// void (
+    ///     // Result of operation, it means success if the value is nullptr,
+    ///     // otherwise, contains an exception.
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    /// \~Chinese
+    /// @brief 写入一个 @ref FlatPoint 、 @ref PointView
+    /// 或用户自定义度量类型的对象。
+    /// @details 仅适用于 @ref FlatPoint 、 @ref PointView 及特化了 @ref
+    /// MeasurementTraits 的类型，后者编码时使用编译期转义好的键名。 @ref
+    /// PointView 在本函数返回前即完成编码，因此无论使用何种完成令牌，
+    /// 其引用的数据均可在调用结束后立即释放。
+    /// @param database 数据库名称。
+    /// @param point 单个点位。
+    /// @param retentionPolicy
+    /// 保留策略名称，默认值为空字符串（即不指定保留策略）。
+    /// @param token 任务完成令牌，将在任务完成后被调用。
+    /// 若没有指定该参数，则使用默认值：@ref token::sync 。
+    /// 若传递函数对象作为完成令牌，则其签名必须满足：
+    /// @code
+    /// void (
+    ///     // 执行结果，仅当值为nullptr时代表成功，否则将承载相关的异常。
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    template<typename POINT_TYPE,
+             typename COMPLETION_TOKEN = token::Sync,
+             typename                  = std::enable_if_t<
+                 IsMeasurement_v<POINT_TYPE> ||
+                 std::is_same_v<POINT_TYPE, FlatPoint> ||
+                 std::is_same_v<POINT_TYPE, PointView>>>
+    [[nodiscard]] auto Write(std::string_view   database,
+                             POINT_TYPE         point,
+                             std::string_view   retentionPolicy = {},
+                             COMPLETION_TOKEN&& token           = {});
+
+    ///
+    /// \~English
+    /// @brief Write multiple @ref FlatPoint , @ref PointView or objects of a
+    /// user-defined measurement type.
+    /// @details Only available for @ref FlatPoint , @ref PointView and types
+    /// which specialize @ref MeasurementTraits , the latter are encoded with
+    /// the keys escaped at compile time. A @ref PointView is encoded before
+    /// this function returns, so the data it refers to may be released right
+    /// after the call, whatever the completion token is.
+    /// @param database Name of the database.
+    /// @param points A vector of points.
+    /// @param retentionPolicy Name of the retention policy, default to empty
+    /// string (no retention policy is specified).
+    /// @param token The completion token which will be invoked when the task
+    /// complete. Default to @ref token::sync if this parameter is not
+    /// specified. If passing function object as token, the function signature
+    /// must be:
+    /// @code
+    /// void (
+    ///     // Result of operation, it means success if the value is nullptr,
+    ///     // otherwise, contains an exception.
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    /// \~Chinese
+    /// @brief 写入多个 @ref FlatPoint 、 @ref PointView
+    /// 或用户自定义度量类型的对象。
+    /// @details 仅适用于 @ref FlatPoint 、 @ref PointView 及特化了 @ref
+    /// MeasurementTraits 的类型，后者编码时使用编译期转义好的键名。 @ref
+    /// PointView 在本函数返回前即完成编码，因此无论使用何种完成令牌，
+    /// 其引用的数据均可在调用结束后立即释放。
+    /// @param database 数据库名称。
+    /// @param points 点位数组。
+    /// @param retentionPolicy
+    /// 保留策略名称，默认值为空字符串（即不指定保留策略）。
+    /// @param token 任务完成令牌，将在任务完成后被调用。
+    /// 若没有指定该参数，则使用默认值：@ref token::sync 。
+    /// 若传递函数对象作为完成令牌，则其签名必须满足：
+    /// @code
+    /// void (
+    ///     // 执行结果，仅当值为nullptr时代表成功，否则将承载相关的异常。
+    ///     std::exception_ptr error
+    /// )
+    /// @endcode
+    ///
+    template<typename POINT_TYPE,
+             typename COMPLETION_TOKEN = token::Sync,
+             typename                  = std::enable_if_t<
+                 IsMeasurement_v<POINT_TYPE> ||
+                 std::is_same_v<POINT_TYPE, FlatPoint> ||
+                 std::is_same_v<POINT_TYPE, PointView>>>
+    [[nodiscard]] auto Write(std::string_view        database,
+                             std::vector<POINT_TYPE> points,
+                             std::string_view        retentionPolicy = {},
+                             COMPLETION_TOKEN&&      token           = {});
+
+    ///
+    /// \~English
+    /// @brief Returns the counters of the write budget.
+    /// @details All of the counters are zero if @ref ClientConfig::writeBudget
+    /// is not set.
+    /// @see WriteBudgetConfig
+    ///
+    /// \~Chinese
+    /// @brief 返回写入内存预算的统计计数。
+    /// @details 若未设置 @ref ClientConfig::writeBudget ，则所有计数均为零。
+    /// @see WriteBudgetConfig
+    ///
+    WriteBudgetStatistics GetWriteBudgetStatistics() const;
+
+    ///
+    /// \~English
+    /// @brief Returns the current state of batching.
+    /// @details All of the values are zero if @ref ClientConfig::batchConfig
+    /// is not set. With @ref ClientConfig::adaptiveBatchConfig set, the batch
+    /// size and the number of batches allowed in flight are those currently
+    /// picked by the client.
+    /// @see AdaptiveBatchConfig
+    ///
+    /// \~Chinese
+    /// @brief 返回批量策略的当前状态。
+    /// @details 若未设置 @ref ClientConfig::batchConfig ，则所有值均为零。
+    /// 若设置了 @ref ClientConfig::adaptiveBatchConfig
+    /// ，批量大小与允许同时发送的批次数量为客户端当前选取的值。
+    /// @see AdaptiveBatchConfig
+    ///
+    BatchStatistics GetBatchStatistics() const;
+
+    ///
+    /// \~English
+    /// @brief Returns the counters of the writes sent to each replica cluster,
+    /// in the order of @ref ClientConfig::replicas.
+    /// @see ReplicaConfig
+    ///
+    /// \~Chinese
+    /// @brief 返回发送到各副本集群的写入的统计计数，顺序与 @ref
+    /// ClientConfig::replicas 一致。
+    /// @see ReplicaConfig
+    ///
+    std::vector<ReplicaStatistics> GetReplicaStatistics() const;
+
+    ///
+    /// \~English
+    /// @brief Rolls a point up instead of writing it as it is.
+    /// @details The point is aggregated with the other points of its series
+    /// over the window it falls in, and one point per series is written once
+    /// the window has ended. A point without time falls in the current window,
+    /// the point is dropped if its window has already been written. Rolled up
+    /// points left are written when the client is destroyed.
+    /// @param database The name of database.
+    /// @param point The point to be rolled up.
+    /// @param retentionPolicy The name of retention policy, default to empty
+    /// string (no retention policy is specified).
+    /// @exception Exception @ref errc::LogicErrors::InvalidArgument if @ref
+    /// ClientConfig::rollupConfig is not set, or the point has no measurement
+    /// or no field.
+    /// @see RollupConfig
+    ///
+    /// \~Chinese
+    /// @brief 汇聚一个点位，而不是将其原样写入。
+    /// @details 点位将与所属时间线的其他点位在其所在窗口内聚合，
+    /// 窗口结束后每条时间线写入一个点位。没有时间的点位落在当前窗口内，
+    /// 若点位所在窗口已被写入，则该点位被丢弃。客户端析构时将写入剩余的汇聚点位。
+    /// @param database 数据库名称。
+    /// @param point 待汇聚的点位。
+    /// @param retentionPolicy
+    /// 保留策略名称，默认值为空字符串（即不指定保留策略）。
+    /// @exception Exception 若未设置 @ref ClientConfig::rollupConfig
+    /// ，或点位没有measurement或字段，则抛出 @ref
+    /// errc::LogicErrors::InvalidArgument 。
+    /// @see RollupConfig
+    ///
+    void Aggregate(std::string_view database,
+                   Point            point,
+                   std::string_view retentionPolicy = {});
+
+    ///
+    /// \~English
+    /// @brief Returns the counters of the client-side rollup.
+    /// @details All of the counters are zero if @ref ClientConfig::rollupConfig
+    /// is not set.
+    /// @see RollupConfig
+    ///
+    /// \~Chinese
+    /// @brief 返回客户端汇聚的统计计数。
+    /// @details 若未设置 @ref ClientConfig::rollupConfig ，则所有计数均为零。
+    /// @see RollupConfig
+    ///
+    RollupStatistics GetRollupStatistics() const;
+
 private:
     Client(const Client&)            = delete;
     Client& operator=(const Client&) = delete;
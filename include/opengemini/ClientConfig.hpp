@@ -101,6 +101,620 @@ struct BatchConfig {
     std::size_t batchSize;
 };
 
+///
+/// \~English
+/// @brief Hold the configs that adapt batching to the observed write latency.
+/// @details The batch size starts from @ref BatchConfig::batchSize and the
+/// number of batches in flight from one. Both grow while requests complete
+/// within the target latency, the batch size by a fixed step per request and
+/// the number of batches in flight by one per round of them, and both are
+/// halved once a request takes longer, or fails with a network error or one of
+/// the status codes 408, 429 and 5xx except 501, at most once per round trip.
+/// Full batches wait for one in flight to complete while there are as many in
+/// flight as currently allowed.
+///
+/// \~Chinese
+/// @brief 自适应批量配置，根据观测到的写入延迟调整批量策略。
+/// @details 批量大小从 @ref BatchConfig::batchSize
+/// 开始，同时发送的批次数量从1开始。
+/// 请求在目标延迟内完成时两者逐步增长：批量大小每个请求增加固定步长，
+/// 同时发送的批次数量每轮请求增加1；一旦请求超出目标延迟，或因网络错误、
+/// 状态码408、429及除501以外的5xx失败，两者减半，每个往返时间至多一次。
+/// 同时发送的批次达到当前上限时，已满的批次等待其中之一完成后再发送。
+///
+struct AdaptiveBatchConfig {
+    ///
+    /// \~English
+    /// @brief The minimum number of points that triggers a batching request.
+    ///
+    /// \~Chinese
+    /// @brief 触发批量请求的最小点位数量。
+    ///
+    std::size_t minBatchSize;
+
+    ///
+    /// \~English
+    /// @brief The maximum number of points that triggers a batching request.
+    ///
+    /// \~Chinese
+    /// @brief 触发批量请求的最大点位数量。
+    ///
+    std::size_t maxBatchSize;
+
+    ///
+    /// \~English
+    /// @brief The maximum number of batches in flight, default to 4.
+    ///
+    /// \~Chinese
+    /// @brief 同时发送的最大批次数量，默认值为4。
+    ///
+    std::size_t maxInFlight{ 4 };
+
+    ///
+    /// \~English
+    /// @brief The latency of a write request beyond which batching backs off,
+    /// default to 500 milliseconds.
+    ///
+    /// \~Chinese
+    /// @brief 写入请求的目标延迟，超出后批量策略将回退，默认值为500毫秒。
+    ///
+    std::chrono::milliseconds targetLatency{ 500 };
+};
+
+///
+/// \~English
+/// @brief Latency observed on one server by adaptive batching.
+///
+/// \~Chinese
+/// @brief 自适应批量在单个服务端上观测到的延迟。
+///
+struct EndpointLatency {
+    ///
+    /// \~English
+    /// @brief The server.
+    ///
+    /// \~Chinese
+    /// @brief 服务端。
+    ///
+    Endpoint endpoint;
+
+    ///
+    /// \~English
+    /// @brief The smoothed latency of the write requests to the server.
+    ///
+    /// \~Chinese
+    /// @brief 发往该服务端的写入请求的平滑延迟。
+    ///
+    std::chrono::microseconds latency{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of write requests to the server.
+    ///
+    /// \~Chinese
+    /// @brief 发往该服务端的写入请求数量。
+    ///
+    std::size_t requests{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of those which were late or failed as overloaded.
+    ///
+    /// \~Chinese
+    /// @brief 其中超出目标延迟或因过载失败的请求数量。
+    ///
+    std::size_t overloaded{ 0 };
+};
+
+///
+/// \~English
+/// @brief The current state of batching.
+///
+/// \~Chinese
+/// @brief 批量策略的当前状态。
+///
+struct BatchStatistics {
+    ///
+    /// \~English
+    /// @brief The number of points that currently triggers a batching request.
+    ///
+    /// \~Chinese
+    /// @brief 当前触发批量请求的点位数量。
+    ///
+    std::size_t batchSize{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of batches currently allowed in flight, zero if not
+    /// bounded.
+    ///
+    /// \~Chinese
+    /// @brief 当前允许同时发送的批次数量，为零时表示不受限制。
+    ///
+    std::size_t maxInFlight{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of batches in flight.
+    ///
+    /// \~Chinese
+    /// @brief 正在发送的批次数量。
+    ///
+    std::size_t inFlight{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of full batches waiting for one in flight to
+    /// complete.
+    ///
+    /// \~Chinese
+    /// @brief 等待发送中批次完成的已满批次数量。
+    ///
+    std::size_t queued{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The latency observed on each server, empty unless batching is
+    /// adaptive.
+    ///
+    /// \~Chinese
+    /// @brief 每个服务端上观测到的延迟，仅在自适应批量时非空。
+    ///
+    std::vector<EndpointLatency> endpoints;
+};
+
+///
+/// \~English
+/// @brief What happens to a write which does not fit into the write budget.
+///
+/// \~Chinese
+/// @brief 写入超出写入内存预算时的处理策略。
+///
+enum class WriteBudgetPolicy {
+    ///
+    /// \~English
+    /// @brief The caller waits until earlier writes have completed.
+    ///
+    /// \~Chinese
+    /// @brief 调用方等待，直到之前的写入完成。
+    ///
+    Block,
+
+    ///
+    /// \~English
+    /// @brief The write fails right away with @ref
+    /// errc::RuntimeErrors::WriteBudgetExceeded .
+    ///
+    /// \~Chinese
+    /// @brief 写入立即失败，错误为 @ref
+    /// errc::RuntimeErrors::WriteBudgetExceeded 。
+    ///
+    Fail,
+
+    ///
+    /// \~English
+    /// @brief The oldest writes not sent yet fail with @ref
+    /// errc::RuntimeErrors::WriteDropped to make room for the new one.
+    ///
+    /// \~Chinese
+    /// @brief 最早的尚未发送的写入以 @ref errc::RuntimeErrors::WriteDropped
+    /// 失败，为新的写入腾出空间。
+    ///
+    DropOldest,
+};
+
+///
+/// \~English
+/// @brief Hold the configs that bound the memory held by pending writes.
+/// @details Every write is charged its size in bytes from the call to @ref
+/// Write until it completes, i.e. while it is queued, batched or being sent.
+/// The size of points which are not encoded yet is estimated. A single write
+/// larger than the whole budget is let through once no other write is pending.
+///
+/// \~Chinese
+/// @brief 写入内存预算配置，限制未完成的写入所占用的内存。
+/// @details 每次写入从调用 @ref Write 起至其完成为止（即排队、
+/// 聚合或发送期间）都将计入其字节数。尚未编码的点位按估算值计入。
+/// 超出整个预算的单次写入将在没有其他未完成写入时被放行。
+///
+struct WriteBudgetConfig {
+    ///
+    /// \~English
+    /// @brief The maximum number of bytes held by pending writes.
+    ///
+    /// \~Chinese
+    /// @brief 未完成的写入所占用的最大字节数。
+    ///
+    std::size_t maxBytes;
+
+    ///
+    /// \~English
+    /// @brief What happens to a write which does not fit, default to @ref
+    /// WriteBudgetPolicy::Block .
+    /// @details Writes initiated on the threads of the client, e.g. from a
+    /// completion handler, are never blocked, since those threads are needed
+    /// to complete earlier writes, they fail as with @ref
+    /// WriteBudgetPolicy::Fail instead. So does a write for which @ref
+    /// WriteBudgetPolicy::DropOldest finds nothing left to drop.
+    ///
+    /// \~Chinese
+    /// @brief 超出预算的写入的处理策略，默认值为 @ref WriteBudgetPolicy::Block
+    /// 。
+    /// @details 在客户端线程上（如完成回调中）发起的写入永远不会阻塞，
+    /// 因为之前的写入需要这些线程才能完成，此时按 @ref WriteBudgetPolicy::Fail
+    /// 处理。 @ref WriteBudgetPolicy::DropOldest 找不到可丢弃的写入时同样如此。
+    ///
+    WriteBudgetPolicy policy{ WriteBudgetPolicy::Block };
+};
+
+///
+/// \~English
+/// @brief Counters of the write budget.
+///
+/// \~Chinese
+/// @brief 写入内存预算的统计计数。
+///
+struct WriteBudgetStatistics {
+    ///
+    /// \~English
+    /// @brief The number of bytes currently held by pending writes.
+    ///
+    /// \~Chinese
+    /// @brief 未完成的写入当前占用的字节数。
+    ///
+    std::size_t bytes{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes which waited for room.
+    ///
+    /// \~Chinese
+    /// @brief 等待过预算空间的写入数量。
+    ///
+    std::size_t blocked{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes which failed for lack of room.
+    ///
+    /// \~Chinese
+    /// @brief 因预算不足而失败的写入数量。
+    ///
+    std::size_t rejected{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes dropped to make room for newer ones.
+    ///
+    /// \~Chinese
+    /// @brief 为新写入腾出空间而被丢弃的写入数量。
+    ///
+    std::size_t dropped{ 0 };
+};
+
+///
+/// \~English
+/// @brief Hold the configs of the on-disk spill of writes.
+/// @details When no server is available, the encoded content of a write is
+/// appended to memory-mapped segment files under the directory instead of
+/// failing, and the write completes successfully. Spilled content is replayed
+/// to the servers in order once one of them is available again, including
+/// content left by a previous client using the same directory.
+///
+/// \~Chinese
+/// @brief 写入数据落盘配置。
+/// @details 当没有可用的服务端时，写入的编码内容将被追加到目录下的内存映射分段文件中，
+/// 而不是失败，写入也将成功完成。落盘的内容会在有服务端重新可用后按顺序重放，
+/// 包括之前使用同一目录的客户端遗留的内容。
+///
+struct SpillConfig {
+    ///
+    /// \~English
+    /// @brief The directory of the segment files, which is created if missing.
+    /// @details Must not be shared by clients running at the same time.
+    ///
+    /// \~Chinese
+    /// @brief 分段文件所在目录，不存在时将被创建。
+    /// @details 不允许被同时运行的多个客户端共用。
+    ///
+    std::string directory;
+
+    ///
+    /// \~English
+    /// @brief The maximum number of bytes taken by the segment files, default
+    /// to 1 GiB.
+    /// @details Writes which do not fit fail with @ref
+    /// errc::ServerErrors::NoAvailableServer as if there were no spill.
+    ///
+    /// \~Chinese
+    /// @brief 分段文件占用的最大字节数，默认值为1 GiB。
+    /// @details 放不下的写入将以 @ref errc::ServerErrors::NoAvailableServer
+    /// 失败，与未开启落盘时相同。
+    ///
+    std::size_t maxBytes{ 1024 * 1024 * 1024 };
+
+    ///
+    /// \~English
+    /// @brief The size in bytes of each segment file, default to 64 MiB.
+    /// @details Bounds the size of a single spilled write.
+    ///
+    /// \~Chinese
+    /// @brief 每个分段文件的字节数，默认值为64 MiB。
+    /// @details 同时也是单次写入可落盘的最大字节数。
+    ///
+    std::size_t segmentSize{ 64 * 1024 * 1024 };
+
+    ///
+    /// \~English
+    /// @brief The maximum number of bytes replayed per second, default to 4
+    /// MiB, 0 means unlimited.
+    /// @details Keeps the replay from flooding servers which just recovered.
+    ///
+    /// \~Chinese
+    /// @brief 每秒最多重放的字节数，默认值为4 MiB，为0时不限制。
+    /// @details 避免重放压垮刚刚恢复的服务端。
+    ///
+    std::size_t replayRate{ 4 * 1024 * 1024 };
+};
+
+///
+/// \~English
+/// @brief Configuration of write retries.
+/// @details A write which fails for a reason which may go away, i.e. a network
+/// error or one of the status codes 408, 429 and 5xx except 501, is sent again
+/// to the next available server, reusing the content already encoded. The
+/// backoff before each retry doubles from the initial one up to the maximum,
+/// and the actual wait is picked at random between half of it and the whole,
+/// so that writes which failed together are not retried together.
+///
+/// \~Chinese
+/// @brief 写入重试配置。
+/// @details 因可能自行消失的原因（网络错误，或状态码408、429及除501以外的5xx）
+/// 失败的写入，将复用已编码的内容重新发送到下一个可用的服务端。每次重试前的退避时间
+/// 从初始值开始翻倍，直至最大值，实际等待时间在其一半与全部之间随机选取，
+/// 以避免同时失败的写入同时重试。
+///
+struct RetryConfig {
+    ///
+    /// \~English
+    /// @brief The maximum number of attempts of a write, including the first
+    /// one, default to 3.
+    ///
+    /// \~Chinese
+    /// @brief 单次写入的最大尝试次数（包括首次），默认值为3。
+    ///
+    std::size_t maxAttempts{ 3 };
+
+    ///
+    /// \~English
+    /// @brief The backoff before the first retry, default to 100 milliseconds.
+    ///
+    /// \~Chinese
+    /// @brief 首次重试前的退避时间，默认值为100毫秒。
+    ///
+    std::chrono::milliseconds initialBackoff{ 100 };
+
+    ///
+    /// \~English
+    /// @brief The maximum backoff before a retry, default to 5 seconds.
+    ///
+    /// \~Chinese
+    /// @brief 重试前的最大退避时间，默认值为5秒。
+    ///
+    std::chrono::milliseconds maxBackoff{ 5000 };
+};
+
+///
+/// \~English
+/// @brief Hold the configs of a replica cluster, to which every write is sent
+/// as well.
+/// @details The content of a write is encoded once and the same buffer is
+/// posted to every cluster. Each replica has its own connections, health
+/// checks and retries, and its writes are sent in the background: the writes
+/// of the client complete with the outcome of the primary cluster only, so
+/// that a slow or failing replica never stalls them. Writes which cannot reach
+/// the replica are held and resent once it has an available server again,
+/// while those it refuses fail. The other settings, e.g. timeouts, gzip and
+/// TLS, are those of the client.
+///
+/// \~Chinese
+/// @brief 副本集群配置，每次写入也会被发送到该集群。
+/// @details 写入内容只编码一次，同一份缓冲区被发送到每个集群。
+/// 每个副本拥有独立的连接、健康检查和重试，其写入在后台发送：
+/// 客户端的写入仅以主集群的结果完成，缓慢或故障的副本不会拖慢写入。
+/// 无法到达副本的写入会被保留，待其重新有可用服务端时再次发送，
+/// 被副本拒绝的写入则失败。其他配置（如超时、gzip和TLS）与客户端相同。
+///
+struct ReplicaConfig {
+    ///
+    /// \~English
+    /// @brief Addresses of the servers of the replica cluster.
+    /// @details Not allowed to be empty or to contain duplicate endpoints.
+    ///
+    /// \~Chinese
+    /// @brief 副本集群服务端地址列表。
+    /// @details 不允许为空，也不允许包含重复端点。
+    ///
+    std::vector<Endpoint> addresses;
+
+    ///
+    /// \~English
+    /// @brief Authentication on the replica cluster, default to @code
+    /// std::nullopt @endcode (no authorization required).
+    ///
+    /// \~Chinese
+    /// @brief 副本集群鉴权配置，默认值为 @code std::nullopt
+    /// @endcode（无需鉴权）。
+    ///
+    std::optional<AuthConfig> authConfig{ std::nullopt };
+
+    ///
+    /// \~English
+    /// @brief The maximum number of bytes of writes pending on the replica,
+    /// default to 64 MiB.
+    /// @details Held writes count towards it until they are resent. Writes
+    /// which do not fit are dropped for the replica only, and counted in @ref
+    /// ReplicaStatistics::dropped.
+    ///
+    /// \~Chinese
+    /// @brief 副本上未完成写入的最大字节数，默认值为64 MiB。
+    /// @details 被保留的写入在再次发送前也计入其中。放不下的写入仅对该副本丢弃，
+    /// 并计入 @ref ReplicaStatistics::dropped 。
+    ///
+    std::size_t maxPendingBytes{ 64 * 1024 * 1024 };
+};
+
+///
+/// \~English
+/// @brief Counters of the writes sent to a replica cluster.
+///
+/// \~Chinese
+/// @brief 发送到副本集群的写入的统计计数。
+///
+struct ReplicaStatistics {
+    ///
+    /// \~English
+    /// @brief The number of bytes of writes currently pending on the replica.
+    ///
+    /// \~Chinese
+    /// @brief 副本上未完成的写入当前占用的字节数。
+    ///
+    std::size_t pendingBytes{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes the replica took.
+    ///
+    /// \~Chinese
+    /// @brief 副本成功接收的写入数量。
+    ///
+    std::size_t written{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes which failed on the replica, retries
+    /// included.
+    ///
+    /// \~Chinese
+    /// @brief 在副本上失败（含重试）的写入数量。
+    ///
+    std::size_t failed{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of writes dropped for lack of room.
+    ///
+    /// \~Chinese
+    /// @brief 因空间不足而被丢弃的写入数量。
+    ///
+    std::size_t dropped{ 0 };
+};
+
+///
+/// \~English
+/// @brief An aggregate computed over the values of a numeric field within a
+/// rollup window.
+///
+/// \~Chinese
+/// @brief 在汇聚窗口内对数值字段的值计算的聚合。
+///
+enum class RollupAggregate {
+    Sum,
+    Count,
+    Min,
+    Max,
+    Last,
+};
+
+///
+/// \~English
+/// @brief Hold the configs of the client-side rollup of points.
+/// @details Points given to @ref Client::Aggregate are rolled up per database,
+/// retention policy and series over windows aligned on the epoch. Once a
+/// window has ended, one point per series is written through the usual write
+/// path, at the start of the window, with a field named after each field and
+/// aggregate, e.g. "value_sum". Fields which are not numeric only keep their
+/// last value, e.g. "state_last", whatever the aggregates configured.
+///
+/// \~Chinese
+/// @brief 客户端点位汇聚配置。
+/// @details 传给 @ref Client::Aggregate
+/// 的点位，按数据库、保留策略与时间线，在以纪元对齐的窗口内汇聚。
+/// 窗口结束后，每条时间线通过常规写入路径写入一个点位，时间为窗口起始时间，
+/// 每个字段与聚合各对应一个字段，如"value_sum"。非数值字段无论配置了哪些聚合，
+/// 都仅保留其最后的值，如"state_last"。
+///
+struct RollupConfig {
+    ///
+    /// \~English
+    /// @brief The length of the windows, default to 1 second.
+    ///
+    /// \~Chinese
+    /// @brief 窗口长度，默认值为1秒。
+    ///
+    std::chrono::milliseconds window{ 1000 };
+
+    ///
+    /// \~English
+    /// @brief The aggregates written for each numeric field, default to all of
+    /// them. Not allowed to be empty.
+    ///
+    /// \~Chinese
+    /// @brief 每个数值字段写入的聚合，默认值为全部聚合。不允许为空。
+    ///
+    std::vector<RollupAggregate> aggregates{ RollupAggregate::Sum,
+                                             RollupAggregate::Count,
+                                             RollupAggregate::Min,
+                                             RollupAggregate::Max,
+                                             RollupAggregate::Last };
+};
+
+///
+/// \~English
+/// @brief Counters of the client-side rollup.
+///
+/// \~Chinese
+/// @brief 客户端汇聚的统计计数。
+///
+struct RollupStatistics {
+    ///
+    /// \~English
+    /// @brief The number of points rolled up.
+    ///
+    /// \~Chinese
+    /// @brief 已汇聚的点位数量。
+    ///
+    std::size_t points{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of points dropped since their window had already
+    /// been written.
+    ///
+    /// \~Chinese
+    /// @brief 因所属窗口已被写入而被丢弃的点位数量。
+    ///
+    std::size_t late{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of rolled up points written.
+    ///
+    /// \~Chinese
+    /// @brief 已写入的汇聚点位数量。
+    ///
+    std::size_t written{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The number of rolled up points whose write failed.
+    ///
+    /// \~Chinese
+    /// @brief 写入失败的汇聚点位数量。
+    ///
+    std::size_t failed{ 0 };
+};
+
 #ifdef OPENGEMINI_ENABLE_SSL_SUPPORT
 
 ///
@@ -209,13 +823,36 @@ struct ClientConfig {
     /// @brief Batching configuration, default to @code std::nullopt
     /// @endcode (All of @ref WritePoint requests will be sent immediately
     /// instead of being aggregated).
+    /// @details If set, writes are gathered into one batch per database and
+    /// retention policy, and each write completes once its batch has been
+    /// sent, with the outcome of the whole batch. Pending batches are sent
+    /// when the client is destroyed.
     ///
     /// \~Chinese
     /// @brief 批量配置，默认值为 @code std::nullopt @endcode
     /// （所有的@ref WritePoint 请求立即被发送，不会被聚合）。
+    /// @details 若设置，写入将按数据库与保留策略聚合为批次，
+    /// 每次写入在其所在批次发送后完成，结果与整个批次一致。
+    /// 客户端析构时会发送尚未发送的批次。
     ///
     std::optional<BatchConfig> batchConfig{ std::nullopt };
 
+    ///
+    /// \~English
+    /// @brief Adaptive batching configuration, default to @code std::nullopt
+    /// @endcode (the batch size is fixed and batches are sent as soon as they
+    /// are full).
+    /// @details Ignored unless @ref batchConfig is set.
+    /// @see AdaptiveBatchConfig
+    ///
+    /// \~Chinese
+    /// @brief 自适应批量配置，默认值为 @code std::nullopt @endcode
+    /// （批量大小固定，批次满后立即发送）。
+    /// @details 仅在设置了 @ref batchConfig 时生效。
+    /// @see AdaptiveBatchConfig
+    ///
+    std::optional<AdaptiveBatchConfig> adaptiveBatchConfig{ std::nullopt };
+
     ///
     /// \~English
     /// @brief Client read/write timeout, default to 30 seconds.
@@ -243,6 +880,32 @@ struct ClientConfig {
     ///
     bool gzipEnabled{ false };
 
+    ///
+    /// \~English
+    /// @brief The gzip compression level, from 0 (stored, fastest) to 9 (best
+    /// compression, slowest), default to 6.
+    ///
+    /// \~Chinese
+    /// @brief gzip压缩级别，取值范围为0（不压缩，最快）至9（压缩率最高，最慢），
+    /// 默认值为6。
+    ///
+    int gzipLevel{ 6 };
+
+    ///
+    /// \~English
+    /// @brief The minimum size in bytes of a request body to be compressed with
+    /// gzip.
+    /// @details Smaller bodies are sent as they are, since compressing them
+    /// costs more than it saves. Streamed writes are always compressed when
+    /// gzip is enabled. Default to 1024.
+    ///
+    /// \~Chinese
+    /// @brief 使用gzip压缩的请求体的最小字节数。
+    /// @details 更小的请求体将不经压缩直接发送，因为压缩的开销大于收益。
+    /// 开启gzip时，流式写入总是被压缩。默认值为1024。
+    ///
+    std::size_t gzipThreshold{ 1024 };
+
     ///
     /// \~English
     /// @brief A hint about the level of concurrency.
@@ -255,6 +918,173 @@ struct ClientConfig {
     /// 客户端可能参考该值选择合适的线程数。默认值为0（由客户端自行决定）。
     ///
     std::size_t concurrencyHint{ 0 };
+
+    ///
+    /// \~English
+    /// @brief The minimum number of points in each chunk when a vector of
+    /// points is encoded in parallel.
+    /// @details A vector of points to be written is split into chunks of at
+    /// least this many points, at most one per thread of the client, which are
+    /// encoded in parallel and then sent in order. Vectors of fewer than twice
+    /// this many points are encoded by a single thread. Default to 10000, 0
+    /// disables parallel encoding.
+    ///
+    /// \~Chinese
+    /// @brief 并行编码点位数组时，每个分块包含的最少点位数。
+    /// @details 待写入的点位数组将被拆分为至少包含该数量点位的分块，
+    /// 分块数不超过客户端的线程数，各分块并行编码后按原顺序发送。
+    /// 点位数少于该值两倍的数组由单个线程编码。默认值为10000，为0时禁用并行编码。
+    ///
+    std::size_t parallelEncodingThreshold{ 10000 };
+
+    ///
+    /// \~English
+    /// @brief The size in bytes of the chunks in which a vector of points is
+    /// streamed to the server.
+    /// @details If not 0, a vector of points to be written is sent with the
+    /// chunked transfer coding, each chunk being encoded while the previous
+    /// one is being sent. The memory held for the body is then bounded by
+    /// about this size, whatever the number of points, instead of the whole
+    /// body, and such vectors are not encoded in parallel. Default to 0
+    /// (disabled).
+    ///
+    /// \~Chinese
+    /// @brief 以流式方式向服务端发送点位数组时，每个分块的字节数。
+    /// @details 若不为0，待写入的点位数组将以分块传输编码发送，
+    /// 每个分块在前一个分块发送的同时完成编码。
+    /// 此时请求体占用的内存约为该值，而与点位数无关，不再需要容纳整个请求体，
+    /// 且此类数组不再并行编码。默认值为0（禁用）。
+    ///
+    std::size_t writeChunkSize{ 0 };
+
+    ///
+    /// \~English
+    /// @brief Whether to sort a vector of points by series before it is
+    /// written.
+    /// @details If enabled, the points of a vector of @ref Point, @ref
+    /// FlatPoint or @ref PointView are written grouped by series (measurement
+    /// and tag set) and ordered by time within each series, which the server
+    /// ingests and compresses more efficiently. The vector itself is left
+    /// untouched, only an index of the points is sorted. Default to false.
+    ///
+    /// \~Chinese
+    /// @brief 写入点位数组前是否按时间线排序。
+    /// @details 若开启，@ref Point 、@ref FlatPoint 或 @ref PointView
+    /// 数组中的点位将按时间线（measurement与标签集合）分组写入，
+    /// 同一时间线内按时间排序，服务端能更高效地写入和压缩这些数据。
+    /// 数组本身不会被修改，仅对点位的索引排序。默认值为false。
+    ///
+    bool sortPointsBySeries{ false };
+
+    ///
+    /// \~English
+    /// @brief Bound on the memory held by pending writes, default to @code
+    /// std::nullopt @endcode (unbounded).
+    /// @see WriteBudgetConfig
+    ///
+    /// \~Chinese
+    /// @brief 未完成的写入所占用内存的上限，默认值为 @code std::nullopt
+    /// @endcode（不限制）。
+    /// @see WriteBudgetConfig
+    ///
+    std::optional<WriteBudgetConfig> writeBudget{ std::nullopt };
+
+    ///
+    /// \~English
+    /// @brief On-disk spill of writes while no server is available, default to
+    /// @code std::nullopt @endcode (such writes fail).
+    /// @see SpillConfig
+    ///
+    /// \~Chinese
+    /// @brief 没有可用服务端时写入数据的落盘配置，默认值为 @code std::nullopt
+    /// @endcode（此类写入将失败）。
+    /// @see SpillConfig
+    ///
+    std::optional<SpillConfig> spillConfig{ std::nullopt };
+
+    ///
+    /// \~English
+    /// @brief Retries of failed writes, default to @code std::nullopt @endcode
+    /// (writes are not retried).
+    /// @see RetryConfig
+    ///
+    /// \~Chinese
+    /// @brief 失败写入的重试配置，默认值为 @code std::nullopt @endcode
+    /// （写入不重试）。
+    /// @see RetryConfig
+    ///
+    std::optional<RetryConfig> retryConfig{ std::nullopt };
+
+    ///
+    /// \~English
+    /// @brief Whether to find the points of a write rejected as a whole (with
+    /// 400 Bad Request), default to false.
+    /// @details If enabled, a rejected write is split in halves which are sent
+    /// again in parallel, recursively, down to the single points rejected.
+    /// Every other point gets written, and the write fails with @ref
+    /// PartialWriteException listing the rejected ones. Content already
+    /// encoded is split by lines, never encoded again, thus vectors of points
+    /// are encoded as a whole regardless of @ref writeChunkSize. Points sent
+    /// again overwrite themselves if the server already took them.
+    ///
+    /// \~Chinese
+    /// @brief 是否查找被整体拒绝（400 Bad Request）的写入中的问题点位，
+    /// 默认值为false。
+    /// @details 若开启，被拒绝的写入将被对半拆分后并行重新发送，递归进行，
+    /// 直至定位到被拒绝的单个点位。其余点位均会被写入，写入以 @ref
+    /// PartialWriteException 失败并列出被拒绝的点位。已编码的内容按行拆分，
+    /// 不会重新编码，因此点位数组将整体编码，不受 @ref writeChunkSize 影响。
+    /// 若服务端已接收部分点位，重新发送的点位将覆盖其自身。
+    ///
+    bool bisectRejectedWrites{ false };
+
+    ///
+    /// \~English
+    /// @brief The minimum number of points in each part when a write is fanned
+    /// out across servers.
+    /// @details Content of a write holding at least twice this many points is
+    /// split by lines into parts of at least this many points, at most one per
+    /// available server, which are sent in parallel to the servers picked in
+    /// turn. The write completes once every part has, and fails with @ref
+    /// FanOutException listing the failed parts if any did, while the others
+    /// are written. Vectors of points are then encoded as a whole regardless
+    /// of @ref writeChunkSize. Default to 0, which disables fanning out.
+    ///
+    /// \~Chinese
+    /// @brief 写入分散发送到多个服务端时，每个分片包含的最少点位数。
+    /// @details 包含的点位数不少于该值两倍的写入内容，
+    /// 将按行拆分为至少包含该数量点位的分片，分片数不超过可用服务端的数量，
+    /// 各分片并行发送到轮流选取的服务端。所有分片完成后写入才完成；
+    /// 若有分片失败，写入以 @ref FanOutException
+    /// 失败并列出失败的分片，其余分片均会被写入。此时点位数组将整体编码，
+    /// 不受 @ref writeChunkSize 影响。默认值为0，即不分散发送。
+    ///
+    std::size_t fanOutThreshold{ 0 };
+
+    ///
+    /// \~English
+    /// @brief Replica clusters to which every write is sent as well, default
+    /// to none.
+    /// @see ReplicaConfig
+    ///
+    /// \~Chinese
+    /// @brief 每次写入也会被发送到的副本集群，默认值为空。
+    /// @see ReplicaConfig
+    ///
+    std::vector<ReplicaConfig> replicas;
+
+    ///
+    /// \~English
+    /// @brief Client-side rollup of the points given to @ref
+    /// Client::Aggregate, default to @code std::nullopt @endcode (disabled).
+    /// @see RollupConfig
+    ///
+    /// \~Chinese
+    /// @brief 传给 @ref Client::Aggregate 的点位的客户端汇聚配置，默认值为
+    /// @code std::nullopt @endcode （禁用）。
+    /// @see RollupConfig
+    ///
+    std::optional<RollupConfig> rollupConfig{ std::nullopt };
 #ifdef OPENGEMINI_ENABLE_SSL_SUPPORT
 
     ///
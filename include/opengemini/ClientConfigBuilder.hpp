@@ -125,6 +125,27 @@ public:
     ///
     Self& BatchConfig(std::chrono::milliseconds interval, std::size_t size);
 
+    ///
+    /// \~English
+    /// @brief Set the bounds within which batching adapts to write latency.
+    /// @see AdaptiveBatchConfig
+    /// @param minBatchSize The minimum number of points of a batch.
+    /// @param maxBatchSize The maximum number of points of a batch.
+    /// @param targetLatency The latency beyond which batching backs off.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置批量策略根据写入延迟自适应调整的范围。
+    /// @see AdaptiveBatchConfig
+    /// @param minBatchSize 批次的最小点位数量。
+    /// @param maxBatchSize 批次的最大点位数量。
+    /// @param targetLatency 目标延迟，超出后批量策略将回退。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& AdaptiveBatchConfig(std::size_t               minBatchSize,
+                              std::size_t               maxBatchSize,
+                              std::chrono::milliseconds targetLatency);
+
     ///
     /// \~English
     /// @brief Set the read/write timeout.
@@ -164,6 +185,33 @@ public:
     ///
     Self& EnableGzip(bool enabled);
 
+    ///
+    /// \~English
+    /// @brief Set the gzip compression level.
+    /// @param level From 0 (stored, fastest) to 9 (best compression, slowest).
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置gzip压缩级别。
+    /// @param level 取值范围为0（不压缩，最快）至9（压缩率最高，最慢）。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& GzipLevel(int level);
+
+    ///
+    /// \~English
+    /// @brief Set the minimum size in bytes of a request body to be compressed
+    /// with gzip.
+    /// @param size Minimum size of the compressed bodies.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置使用gzip压缩的请求体的最小字节数。
+    /// @param size 被压缩的请求体的最小字节数。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& GzipThreshold(std::size_t size);
+
     ///
     /// \~English
     /// @brief Set the hint about the level of concurrency.
@@ -178,6 +226,160 @@ public:
     ///
     Self& ConcurrencyHint(std::size_t hint);
 
+    ///
+    /// \~English
+    /// @brief Set the minimum number of points in each chunk when a vector of
+    /// points is encoded in parallel.
+    /// @param threshold Minimum number of points per chunk, 0 disables
+    /// parallel encoding.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置并行编码点位数组时，每个分块包含的最少点位数。
+    /// @param threshold 每个分块的最少点位数，为0时禁用并行编码。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& ParallelEncodingThreshold(std::size_t threshold);
+
+    ///
+    /// \~English
+    /// @brief Set the size in bytes of the chunks in which a vector of points
+    /// is streamed to the server.
+    /// @param size Size of each chunk, 0 disables streaming.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置以流式方式向服务端发送点位数组时，每个分块的字节数。
+    /// @param size 每个分块的字节数，为0时禁用流式发送。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& WriteChunkSize(std::size_t size);
+
+    ///
+    /// \~English
+    /// @brief Set whether to sort a vector of points by series before it is
+    /// written.
+    /// @param enabled
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置写入点位数组前是否按时间线排序。
+    /// @param enabled
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& SortPointsBySeries(bool enabled);
+
+    ///
+    /// \~English
+    /// @brief Set the bound on the memory held by pending writes.
+    /// @see WriteBudgetConfig
+    /// @param maxBytes The maximum number of bytes held by pending writes.
+    /// @param policy What happens to a write which does not fit.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置未完成的写入所占用内存的上限。
+    /// @see WriteBudgetConfig
+    /// @param maxBytes 未完成的写入所占用的最大字节数。
+    /// @param policy 超出预算的写入的处理策略。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& WriteBudget(std::size_t       maxBytes,
+                      WriteBudgetPolicy policy = WriteBudgetPolicy::Block);
+
+    ///
+    /// \~English
+    /// @brief Set the on-disk spill of writes while no server is available.
+    /// @see SpillConfig
+    /// @param directory The directory of the segment files.
+    /// @param maxBytes The maximum number of bytes taken by the segment files.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置没有可用服务端时写入数据的落盘配置。
+    /// @see SpillConfig
+    /// @param directory 分段文件所在目录。
+    /// @param maxBytes 分段文件占用的最大字节数。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& SpillConfig(std::string directory, std::size_t maxBytes);
+
+    ///
+    /// \~English
+    /// @brief Set the retries of failed writes.
+    /// @see RetryConfig
+    /// @param maxAttempts The maximum number of attempts of a write.
+    /// @param initialBackoff The backoff before the first retry.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置失败写入的重试策略。
+    /// @see RetryConfig
+    /// @param maxAttempts 单次写入的最大尝试次数。
+    /// @param initialBackoff 首次重试前的退避时间。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& RetryConfig(std::size_t               maxAttempts,
+                      std::chrono::milliseconds initialBackoff);
+
+    ///
+    /// \~English
+    /// @brief Set whether to find the points of a write rejected as a whole.
+    /// @param enabled
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置是否查找被整体拒绝的写入中的问题点位。
+    /// @param enabled
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& BisectRejectedWrites(bool enabled);
+
+    ///
+    /// \~English
+    /// @brief Set the minimum number of points in each part when a write is
+    /// fanned out across servers.
+    /// @param threshold
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置写入分散发送到多个服务端时，每个分片包含的最少点位数。
+    /// @param threshold
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& FanOutThreshold(std::size_t threshold);
+
+    ///
+    /// \~English
+    /// @brief Append a replica cluster to which every write is sent as well.
+    /// @see ReplicaConfig
+    /// @param addresses Addresses of the servers of the replica cluster.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 增加一个副本集群，每次写入也会被发送到该集群。
+    /// @see ReplicaConfig
+    /// @param addresses 副本集群服务端地址列表。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& AppendReplica(const std::vector<Endpoint>& addresses);
+
+    ///
+    /// \~English
+    /// @brief Set the client-side rollup of the points given to @ref
+    /// Client::Aggregate.
+    /// @see RollupConfig
+    /// @param window The length of the windows.
+    /// @return Reference to the builder itself.
+    ///
+    /// \~Chinese
+    /// @brief 设置传给 @ref Client::Aggregate 的点位的客户端汇聚配置。
+    /// @see RollupConfig
+    /// @param window 窗口长度。
+    /// @return 指向配置构造器自身的引用。
+    ///
+    Self& RollupConfig(std::chrono::milliseconds window);
+
 #ifdef OPENGEMINI_ENABLE_SSL_SUPPORT
     ///
     /// \~English
@@ -134,10 +134,13 @@ enum class ServerErrors {
     NoAvailableServer = 1,
     UnexpectedStatusCode,
     ErrorResult,
+    PartialWrite,
 };
 
 enum class RuntimeErrors {
     Unexpected = 1,
+    WriteBudgetExceeded,
+    WriteDropped,
 };
 
 } // namespace opengemini::errc
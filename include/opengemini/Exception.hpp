@@ -16,6 +16,10 @@
 #define OPENGEMINI_EXCEPTION_HPP
 
 #include <exception>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "opengemini/Error.hpp"
 
@@ -98,6 +102,140 @@ private:
     std::string what_;
 };
 
+///
+/// \~English
+/// @brief A point rejected by the server.
+///
+/// \~Chinese
+/// @brief 被服务端拒绝的点位。
+///
+struct RejectedPoint {
+    ///
+    /// \~English
+    /// @brief The point encoded in line protocol, without the line break.
+    ///
+    /// \~Chinese
+    /// @brief 点位的行协议编码，不包含换行符。
+    ///
+    std::string line;
+
+    ///
+    /// \~English
+    /// @brief The body of the response rejecting the point.
+    ///
+    /// \~Chinese
+    /// @brief 拒绝该点位的响应体。
+    ///
+    std::string reason;
+};
+
+///
+/// \~English
+/// @brief Exception of a write of which some points are rejected by the
+/// server, while the others are written.
+/// @details Only thrown if @ref ClientConfig::bisectRejectedWrites is set.
+///
+/// \~Chinese
+/// @brief 部分点位被服务端拒绝、其余点位已写入时抛出的异常。
+/// @details 仅当设置了 @ref ClientConfig::bisectRejectedWrites 时抛出。
+///
+class PartialWriteException : public Exception {
+public:
+    explicit PartialWriteException(std::vector<RejectedPoint> rejected) :
+        Exception(errc::ServerErrors::PartialWrite,
+                  fmt::format("{} point(s) rejected", rejected.size())),
+        rejected_(std::move(rejected))
+    { }
+
+    ///
+    /// \~English
+    /// @brief Returns the points rejected by the server.
+    ///
+    /// \~Chinese
+    /// @brief 返回被服务端拒绝的点位。
+    ///
+    const std::vector<RejectedPoint>& Rejected() const noexcept
+    {
+        return rejected_;
+    }
+
+private:
+    std::vector<RejectedPoint> rejected_;
+};
+
+///
+/// \~English
+/// @brief A failed part of a write fanned out across servers.
+///
+/// \~Chinese
+/// @brief 分散发送到多个服务端的写入中失败的分片。
+///
+struct FailedPart {
+    ///
+    /// \~English
+    /// @brief The index of the first line of the part, within the content of
+    /// its precision.
+    ///
+    /// \~Chinese
+    /// @brief 分片首行在其精度的写入内容中的序号。
+    ///
+    std::size_t firstLine;
+
+    ///
+    /// \~English
+    /// @brief The number of lines of the part.
+    ///
+    /// \~Chinese
+    /// @brief 分片包含的行数。
+    ///
+    std::size_t lines;
+
+    ///
+    /// \~English
+    /// @brief Why the part failed.
+    ///
+    /// \~Chinese
+    /// @brief 分片失败的原因。
+    ///
+    Error error;
+};
+
+///
+/// \~English
+/// @brief Exception of a write fanned out across servers of which some parts
+/// failed, while the others are written.
+/// @details Only thrown if @ref ClientConfig::fanOutThreshold is set. The
+/// error of the exception itself is that of the first failed part.
+///
+/// \~Chinese
+/// @brief 分散发送到多个服务端的写入中部分分片失败、其余分片已写入时抛出的异常。
+/// @details 仅当设置了 @ref ClientConfig::fanOutThreshold
+/// 时抛出。异常自身承载的错误为首个失败分片的错误。
+///
+class FanOutException : public Exception {
+public:
+    FanOutException(std::size_t parts, std::vector<FailedPart> failed) :
+        Exception(failed.front().error.Code(),
+                  fmt::format("{} of {} part(s) failed, the first one with: {}",
+                              failed.size(),
+                              parts,
+                              failed.front().error.What())),
+        failed_(std::move(failed))
+    { }
+
+    ///
+    /// \~English
+    /// @brief Returns the failed parts, in order.
+    ///
+    /// \~Chinese
+    /// @brief 按顺序返回失败的分片。
+    ///
+    const std::vector<FailedPart>& Failed() const noexcept { return failed_; }
+
+private:
+    std::vector<FailedPart> failed_;
+};
+
 } // namespace opengemini
 
 #endif // !OPENGEMINI_EXCEPTION_HPP
@@ -0,0 +1,69 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_FLATPOINT_HPP
+#define OPENGEMINI_FLATPOINT_HPP
+
+#include <string>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include "opengemini/Point.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/SeriesKey.hpp"
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief Holds the point data in flat containers.
+/// @details Same as @ref Point , except that the fields and the tags are kept
+/// in sorted vectors with inline storage instead of node-based maps. A point
+/// with up to @c INLINE_CAPACITY fields and as many tags, whose keys and
+/// values are short enough for the small-string optimization, does not need
+/// any heap allocation besides its own storage. It may be written with @ref
+/// Client::Write just like @ref Point .
+///
+/// \~Chinese
+/// @brief 以扁平容器存储的点位数据。
+/// @details 与 @ref Point
+/// 相同，但字段与标签存储在带内联存储的有序数组中，而非基于节点的映射表。
+/// 字段与标签数量均不超过 @c INLINE_CAPACITY
+/// ，且键与值足够短以适用短字符串优化时，点位除自身存储外无需任何堆内存分配。
+/// 可以像 @ref Point 一样通过 @ref Client::Write 写入。
+///
+struct FlatPoint {
+    static constexpr std::size_t INLINE_CAPACITY{ 8 };
+
+    template<typename T>
+    using SmallMap =
+        boost::container::small_flat_map<std::string, T, INLINE_CAPACITY>;
+
+    using Field  = Point::Field;
+    using Time   = Point::Time;
+    using Fields = SmallMap<Field>;
+    using Tags   = SmallMap<std::string>;
+
+    std::string measurement;
+    Fields      fields;
+    Time        time;
+    Tags        tags;
+    Precision   precision{ Precision::Nanosecond };
+    SeriesKey   series;
+};
+
+} // namespace opengemini
+
+#endif // !OPENGEMINI_FLATPOINT_HPP
@@ -0,0 +1,155 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_MEASUREMENT_HPP
+#define OPENGEMINI_MEASUREMENT_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "opengemini/Point.hpp"
+#include "opengemini/Precision.hpp"
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief Describes how a user-defined type is written as a measurement.
+/// @details Specialize this template for a type to write its objects with
+/// @ref Client::Write directly, without building a @ref Point . The keys are
+/// escaped at compile time and the members are encoded according to their
+/// static types. The specialization must provide the following members:
+/// - @c measurement Name of the measurement, made by @ref schema::Measurement.
+/// - @c fields A tuple made of @ref schema::Field, must not be empty.
+///
+/// And optionally:
+/// - @c tags A tuple made of @ref schema::Tag.
+/// - @c time Pointer to a @ref Point::Time member, no timestamp is written
+/// if omitted.
+/// - @c precision The @ref Precision of the timestamp, default to
+/// nanosecond.
+///
+/// Fields may be of arithmetic types or types convertible to
+/// @c std::string_view , tags must be convertible to @c std::string_view .
+/// Both may also be wrapped in @c std::optional , in which case they are
+/// omitted when holding no value.
+/// @code
+/// struct CpuUsage {
+///     std::string             host;
+///     double                  usage;
+///     int64_t                 procs;
+///     opengemini::Point::Time time;
+/// };
+///
+/// template<>
+/// struct opengemini::MeasurementTraits<CpuUsage> {
+///     static constexpr auto measurement = schema::Measurement("cpu");
+///     static constexpr auto tags =
+///         std::make_tuple(schema::Tag("host", &CpuUsage::host));
+///     static constexpr auto fields =
+///         std::make_tuple(schema::Field("usage", &CpuUsage::usage),
+///                         schema::Field("procs", &CpuUsage::procs));
+///     static constexpr auto time = &CpuUsage::time;
+/// };
+/// @endcode
+///
+/// \~Chinese
+/// @brief 描述如何将用户自定义类型写入为度量。
+/// @details 为某类型特化该模板后，即可直接通过 @ref Client::Write
+/// 写入该类型的对象，而无需构造 @ref Point
+/// 。各个键名在编译期完成转义，成员按其静态类型编码。特化必须提供以下成员：
+/// - @c measurement 度量名称，由 @ref schema::Measurement 构造。
+/// - @c fields 由 @ref schema::Field 组成的元组，不能为空。
+///
+/// 以及可选成员：
+/// - @c tags 由 @ref schema::Tag 组成的元组。
+/// - @c time 指向 @ref Point::Time 类型成员的指针，省略时不写入时间戳。
+/// - @c precision 时间戳的精度 @ref Precision ，默认为纳秒。
+///
+/// 字段可以是算术类型或可转换为 @c std::string_view 的类型，标签必须可转换为
+/// @c std::string_view 。两者均可包装在 @c std::optional
+/// 中，此时若不持有值则被省略。
+///
+template<typename T>
+struct MeasurementTraits;
+
+///
+/// \~English
+/// @brief Whether @ref MeasurementTraits is specialized for the type.
+///
+/// \~Chinese
+/// @brief 类型是否特化了 @ref MeasurementTraits 。
+///
+template<typename T, typename = void>
+struct IsMeasurement : std::false_type { };
+
+template<typename T>
+struct IsMeasurement<T,
+                     std::void_t<decltype(MeasurementTraits<T>::measurement),
+                                 decltype(MeasurementTraits<T>::fields)>> :
+    std::true_type { };
+
+template<typename T>
+inline constexpr bool IsMeasurement_v = IsMeasurement<T>::value;
+
+namespace schema {
+
+///
+/// \~English
+/// @brief Declares the name of a measurement.
+/// @param name Name of the measurement, must not be empty.
+///
+/// \~Chinese
+/// @brief 声明度量名称。
+/// @param name 度量名称，不能为空。
+///
+template<std::size_t N>
+constexpr auto Measurement(const char (&name)[N]);
+
+///
+/// \~English
+/// @brief Declares a tag of a measurement.
+/// @param key Key of the tag, must not be empty.
+/// @param member Pointer to the member which holds the tag value.
+///
+/// \~Chinese
+/// @brief 声明度量的一个标签。
+/// @param key 标签键名，不能为空。
+/// @param member 指向持有标签值的成员的指针。
+///
+template<std::size_t N, typename OWNER, typename VALUE>
+constexpr auto Tag(const char (&key)[N], VALUE OWNER::*member);
+
+///
+/// \~English
+/// @brief Declares a field of a measurement.
+/// @param key Key of the field, must not be empty.
+/// @param member Pointer to the member which holds the field value.
+///
+/// \~Chinese
+/// @brief 声明度量的一个字段。
+/// @param key 字段键名，不能为空。
+/// @param member 指向持有字段值的成员的指针。
+///
+template<std::size_t N, typename OWNER, typename VALUE>
+constexpr auto Field(const char (&key)[N], VALUE OWNER::*member);
+
+} // namespace schema
+
+} // namespace opengemini
+
+#include "opengemini/impl/Measurement.ipp"
+
+#endif // !OPENGEMINI_MEASUREMENT_HPP
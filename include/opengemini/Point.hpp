@@ -21,15 +21,19 @@
 #include <variant>
 
 #include "opengemini/Precision.hpp"
+#include "opengemini/SeriesKey.hpp"
 
 namespace opengemini {
 
 ///
 /// \~English
 /// @brief Holds the point data.
+/// @details If @c series is not empty, it is written instead of @c measurement
+/// and @c tags .
 ///
 /// \~Chinese
 /// @brief 点位数据。
+/// @details 若 @c series 不为空，则写入它而不是 @c measurement 与 @c tags 。
 ///
 struct Point {
     using Field = std::variant<double, int64_t, uint64_t, std::string, bool>;
@@ -41,6 +45,7 @@ struct Point {
     Time                               time;
     std::map<std::string, std::string> tags;
     Precision                          precision{ Precision::Nanosecond };
+    SeriesKey                          series;
 };
 
 } // namespace opengemini
@@ -0,0 +1,67 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_POINTBATCH_HPP
+#define OPENGEMINI_POINTBATCH_HPP
+
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "opengemini/Point.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/SeriesKey.hpp"
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief Holds multiple rows of one measurement in columns.
+/// @details Every field is a typed column and the timestamps are a contiguous
+/// array, all of them must have the same number of rows. The tags in @c tags
+/// are shared by all rows, the tags in @c rowTags are columns which hold one
+/// value for each row, an empty value means the tag is absent from that row.
+/// If @c times is empty, no timestamp is written. If @c series is not empty,
+/// it is written instead of @c measurement and @c tags .
+///
+/// \~Chinese
+/// @brief 以列的形式存储同一度量的多行数据。
+/// @details
+/// 每个字段是一个有类型的列，时间戳是一个连续数组，它们的行数必须相同。
+/// @c tags 中的标签由所有行共享，@c rowTags
+/// 中的标签为列，每行持有一个值，值为空代表该行不含此标签。若 @c times
+/// 为空，则不写入时间戳。若 @c series 不为空，则写入它而不是 @c measurement
+/// 与 @c tags 。
+///
+struct PointBatch {
+    using Column    = std::variant<std::vector<double>,
+                                  std::vector<int64_t>,
+                                  std::vector<uint64_t>,
+                                  std::vector<std::string>,
+                                  std::vector<bool>>;
+    using TagColumn = std::vector<std::string>;
+
+    std::string                        measurement;
+    std::map<std::string, Column>      fields;
+    std::vector<Point::Time>           times;
+    std::map<std::string, std::string> tags;
+    std::map<std::string, TagColumn>   rowTags;
+    Precision                          precision{ Precision::Nanosecond };
+    SeriesKey                          series;
+};
+
+} // namespace opengemini
+
+#endif // !OPENGEMINI_POINTBATCH_HPP
@@ -0,0 +1,67 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_POINTVIEW_HPP
+#define OPENGEMINI_POINTVIEW_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include <boost/core/span.hpp>
+
+#include "opengemini/Point.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/SeriesKey.hpp"
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief Refers to point data owned by the caller.
+/// @details Same as @ref Point , except that the measurement, the tags and the
+/// string fields are views into storage which the caller keeps alive, so that
+/// nothing is copied before encoding. The tags are written in the given order.
+/// When written with @ref Client::Write , the point is encoded before the
+/// function returns, hence the viewed data only has to outlive that call, even
+/// with asynchronous or deferred completion tokens.
+///
+/// \~Chinese
+/// @brief 引用调用方所持有数据的点位。
+/// @details 与 @ref Point
+/// 相同，但度量名称、标签及字符串字段均为指向调用方存储的视图，编码前无需任何拷贝。
+/// 标签按给定顺序写入。通过 @ref Client::Write
+/// 写入时，点位在函数返回前即完成编码，因此即使使用异步或延迟的完成令牌，
+/// 被引用的数据也只需在该调用期间保持有效。
+///
+struct PointView {
+    using Field =
+        std::variant<double, int64_t, uint64_t, std::string_view, bool>;
+
+    using Time      = Point::Time;
+    using FieldView = std::pair<std::string_view, Field>;
+    using TagView   = std::pair<std::string_view, std::string_view>;
+
+    std::string_view             measurement;
+    boost::span<const FieldView> fields;
+    Time                         time;
+    boost::span<const TagView>   tags;
+    Precision                    precision{ Precision::Nanosecond };
+    SeriesKey                    series;
+};
+
+} // namespace opengemini
+
+#endif // !OPENGEMINI_POINTVIEW_HPP
@@ -0,0 +1,75 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_RAWLINES_HPP
+#define OPENGEMINI_RAWLINES_HPP
+
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "opengemini/Precision.hpp"
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief Holds content already encoded in line protocol.
+/// @details Written with @ref Client::Write as it is, without any encoding
+/// step. The content may be owned by the object, in which case its storage is
+/// reused by later writes, or shared with the caller, e.g. when the same
+/// content is relayed to several servers, in which case it is copied once
+/// into a reused buffer. Lines are separated by @c '\\n' .
+///
+/// \~Chinese
+/// @brief 存储已按行协议编码的内容。
+/// @details 通过 @ref Client::Write
+/// 原样写入，不经过任何编码步骤。内容可由对象自身持有，此时其存储将被后续写入复用；
+/// 也可与调用方共享，例如将同一内容转发给多个服务端，此时内容将被拷贝一次至复用的缓冲区。
+/// 各行以 @c '\\n' 分隔。
+///
+struct RawLines {
+    using Content =
+        std::variant<std::string, std::shared_ptr<const std::string>>;
+
+    Content content;
+
+    ///
+    /// \~English
+    /// @brief Whether to check the framing of each line before writing, i.e.
+    /// that it has a measurement, a non-empty field set and an optional
+    /// integral timestamp. The values themselves are not checked. Empty lines
+    /// and comments starting with @c '#' are skipped. Default to false.
+    ///
+    /// \~Chinese
+    /// @brief
+    /// 写入前是否检查每行的格式，即是否包含度量名称、非空的字段集合以及可选的整数时间戳，
+    /// 但不检查具体的值。空行及以 @c '#' 开头的注释将被跳过。默认为false。
+    ///
+    bool validate{ false };
+
+    ///
+    /// \~English
+    /// @brief Precision of the timestamps in the content, which is sent along
+    /// with it. Default to nanosecond.
+    ///
+    /// \~Chinese
+    /// @brief 内容中时间戳的精度，将随内容一同发送。默认为纳秒。
+    ///
+    Precision precision{ Precision::Nanosecond };
+};
+
+} // namespace opengemini
+
+#endif // !OPENGEMINI_RAWLINES_HPP
@@ -0,0 +1,95 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_SERIESKEY_HPP
+#define OPENGEMINI_SERIESKEY_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace opengemini {
+
+///
+/// \~English
+/// @brief A pre-serialized series key, that is the measurement together with
+/// its tags.
+/// @details The measurement and the tags are escaped and serialized only once
+/// on construction. Attach the key to @ref Point or @ref PointBatch which
+/// belong to the same series, the encoder then copies the serialized key as
+/// is, and ignores their own measurement and tags. Copies share the same
+/// underlying storage and are cheap.
+///
+/// \~Chinese
+/// @brief 预先序列化的序列键，即度量及其标签。
+/// @details 度量与标签仅在构造时完成一次转义与序列化。将其附加到属于同一序列的
+/// @ref Point 或 @ref PointBatch
+/// 后，编码器会直接拷贝序列化好的键，并忽略它们自身的度量与标签。
+/// 拷贝共享同一份底层存储，开销很小。
+///
+class SeriesKey {
+public:
+    ///
+    /// \~English
+    /// @brief Constructs an empty key which is not used for encoding.
+    ///
+    /// \~Chinese
+    /// @brief 构造一个空键，编码时不会被使用。
+    ///
+    SeriesKey() = default;
+
+    ///
+    /// \~English
+    /// @brief Serializes the series key.
+    /// @param measurement Name of the measurement, must not be empty.
+    /// @param tags Tags of the series.
+    ///
+    /// \~Chinese
+    /// @brief 序列化序列键。
+    /// @param measurement 度量名称，不能为空。
+    /// @param tags 序列的标签。
+    ///
+    explicit SeriesKey(std::string_view                          measurement,
+                       const std::map<std::string, std::string>& tags = {});
+
+    ///
+    /// \~English
+    /// @brief Returns the serialized key, empty if the key is empty.
+    ///
+    /// \~Chinese
+    /// @brief 返回序列化后的键，若为空键则返回空字符串。
+    ///
+    std::string_view View() const noexcept;
+
+    ///
+    /// \~English
+    /// @brief Whether the key is empty.
+    ///
+    /// \~Chinese
+    /// @brief 是否为空键。
+    ///
+    bool Empty() const noexcept;
+
+private:
+    std::shared_ptr<const std::string> key_;
+};
+
+} // namespace opengemini
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/SeriesKey.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_SERIESKEY_HPP
@@ -124,4 +124,80 @@ auto Client::Write(std::string_view   database,
         std::forward<COMPLETION_TOKEN>(token));
 }
 
+template<typename COMPLETION_TOKEN>
+auto Client::Write(std::string_view   database,
+                   PointBatch         batch,
+                   std::string_view   retentionPolicy,
+                   COMPLETION_TOKEN&& token)
+{
+    return impl_->Write<PointBatch>(database,
+                                    std::move(batch),
+                                    retentionPolicy,
+                                    std::forward<COMPLETION_TOKEN>(token));
+}
+
+template<typename COMPLETION_TOKEN>
+auto Client::Write(std::string_view   database,
+                   RawLines           lines,
+                   std::string_view   retentionPolicy,
+                   COMPLETION_TOKEN&& token)
+{
+    return impl_->Write<RawLines>(database,
+                                  std::move(lines),
+                                  retentionPolicy,
+                                  std::forward<COMPLETION_TOKEN>(token));
+}
+
+template<typename POINT_TYPE, typename COMPLETION_TOKEN, typename>
+auto Client::Write(std::string_view   database,
+                   POINT_TYPE         point,
+                   std::string_view   retentionPolicy,
+                   COMPLETION_TOKEN&& token)
+{
+    return impl_->Write<POINT_TYPE>(database,
+                                    std::move(point),
+                                    retentionPolicy,
+                                    std::forward<COMPLETION_TOKEN>(token));
+}
+
+template<typename POINT_TYPE, typename COMPLETION_TOKEN, typename>
+auto Client::Write(std::string_view        database,
+                   std::vector<POINT_TYPE> points,
+                   std::string_view        retentionPolicy,
+                   COMPLETION_TOKEN&&      token)
+{
+    return impl_->Write<std::vector<POINT_TYPE>>(
+        database,
+        std::move(points),
+        retentionPolicy,
+        std::forward<COMPLETION_TOKEN>(token));
+}
+
+inline WriteBudgetStatistics Client::GetWriteBudgetStatistics() const
+{
+    return impl_->GetWriteBudgetStatistics();
+}
+
+inline BatchStatistics Client::GetBatchStatistics() const
+{
+    return impl_->GetBatchStatistics();
+}
+
+inline std::vector<ReplicaStatistics> Client::GetReplicaStatistics() const
+{
+    return impl_->GetReplicaStatistics();
+}
+
+inline void Client::Aggregate(std::string_view database,
+                              Point            point,
+                              std::string_view retentionPolicy)
+{
+    impl_->Aggregate(database, std::move(point), retentionPolicy);
+}
+
+inline RollupStatistics Client::GetRollupStatistics() const
+{
+    return impl_->GetRollupStatistics();
+}
+
 } // namespace opengemini
@@ -71,6 +71,20 @@ ClientConfigBuilder::BatchConfig(std::chrono::milliseconds interval,
     return *this;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::AdaptiveBatchConfig(
+    std::size_t               minBatchSize,
+    std::size_t               maxBatchSize,
+    std::chrono::milliseconds targetLatency)
+{
+    struct AdaptiveBatchConfig adaptive;
+    adaptive.minBatchSize  = minBatchSize;
+    adaptive.maxBatchSize  = maxBatchSize;
+    adaptive.targetLatency = targetLatency;
+    conf_.adaptiveBatchConfig.emplace(std::move(adaptive));
+    return *this;
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 ClientConfigBuilder&
 ClientConfigBuilder::ReadWriteTimeout(std::chrono::milliseconds timeout)
@@ -94,6 +108,20 @@ ClientConfigBuilder& ClientConfigBuilder::EnableGzip(bool enabled)
     return *this;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::GzipLevel(int level)
+{
+    conf_.gzipLevel = level;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::GzipThreshold(std::size_t size)
+{
+    conf_.gzipThreshold = size;
+    return *this;
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 ClientConfigBuilder& ClientConfigBuilder::ConcurrencyHint(std::size_t hint)
 {
@@ -101,6 +129,91 @@ ClientConfigBuilder& ClientConfigBuilder::ConcurrencyHint(std::size_t hint)
     return *this;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder&
+ClientConfigBuilder::ParallelEncodingThreshold(std::size_t threshold)
+{
+    conf_.parallelEncodingThreshold = threshold;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::WriteChunkSize(std::size_t size)
+{
+    conf_.writeChunkSize = size;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::SortPointsBySeries(bool enabled)
+{
+    conf_.sortPointsBySeries = enabled;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder&
+ClientConfigBuilder::WriteBudget(std::size_t maxBytes, WriteBudgetPolicy policy)
+{
+    conf_.writeBudget.emplace(WriteBudgetConfig{ maxBytes, policy });
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::SpillConfig(std::string directory,
+                                                      std::size_t maxBytes)
+{
+    struct SpillConfig spill;
+    spill.directory = std::move(directory);
+    spill.maxBytes  = maxBytes;
+    conf_.spillConfig.emplace(std::move(spill));
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder&
+ClientConfigBuilder::RetryConfig(std::size_t               maxAttempts,
+                                 std::chrono::milliseconds initialBackoff)
+{
+    struct RetryConfig retry;
+    retry.maxAttempts    = maxAttempts;
+    retry.initialBackoff = initialBackoff;
+    conf_.retryConfig.emplace(std::move(retry));
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::BisectRejectedWrites(bool enabled)
+{
+    conf_.bisectRejectedWrites = enabled;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder& ClientConfigBuilder::FanOutThreshold(std::size_t threshold)
+{
+    conf_.fanOutThreshold = threshold;
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder&
+ClientConfigBuilder::AppendReplica(const std::vector<Endpoint>& addresses)
+{
+    conf_.replicas.push_back({ addresses });
+    return *this;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ClientConfigBuilder&
+ClientConfigBuilder::RollupConfig(std::chrono::milliseconds window)
+{
+    struct RollupConfig rollup;
+    rollup.window = window;
+    conf_.rollupConfig.emplace(std::move(rollup));
+    return *this;
+}
+
 #ifdef OPENGEMINI_ENABLE_SSL_SUPPORT
 OPENGEMINI_INLINE_SPECIFIER
 ClientConfigBuilder& ClientConfigBuilder::SkipVerifyPeer(bool skipped)
@@ -30,18 +30,119 @@ OPENGEMINI_INLINE_SPECIFIER
 ClientImpl::ClientImpl(const ClientConfig& config) :
     ctx_(config.concurrencyHint),
     http_(ConstructHttpClient(config)),
-    lb_(lb::LoadBalancer::Construct(ctx_(), config.addresses, http_))
+    lb_(lb::LoadBalancer::Construct(ctx_(), config.addresses, http_)),
+    writeOptions_{ config.parallelEncodingThreshold,
+                   ctx_.Concurrency(),
+                   config.writeChunkSize,
+                   config.sortPointsBySeries,
+                   config.retryConfig,
+                   config.bisectRejectedWrites,
+                   config.fanOutThreshold }
 {
+    if (auto& budget = config.writeBudget; budget.has_value()) {
+        budget_ = std::make_unique<cli::WriteBudget>(ctx_(), budget.value());
+    }
+    if (auto& spill = config.spillConfig; spill.has_value()) {
+        spill_ = cli::Spill::Construct(ctx_(), spill.value(), lb_, http_);
+        writeOptions_.spill = spill_.get();
+    }
+    for (auto& replica : config.replicas) {
+        auto replicaConfig       = config;
+        replicaConfig.addresses  = replica.addresses;
+        replicaConfig.authConfig = replica.authConfig;
+        replicas_.push_back(
+            cli::Replica::Construct(ctx_(),
+                                    replica,
+                                    ConstructHttpClient(replicaConfig),
+                                    buffers_,
+                                    config.retryConfig,
+                                    config.bisectRejectedWrites));
+        writeOptions_.replicas.push_back(replicas_.back().get());
+    }
+    if (auto& batch = config.batchConfig; batch.has_value()) {
+        batcher_ = cli::Batcher::Construct(ctx_(),
+                                           cli::Functor{ *http_, *lb_ },
+                                           buffers_,
+                                           writeOptions_,
+                                           batch.value(),
+                                           budget_.get(),
+                                           config.adaptiveBatchConfig);
+    }
+    if (auto& rollup = config.rollupConfig; rollup.has_value()) {
+        rollup_ = cli::Rollup::Construct(
+            ctx_(),
+            rollup.value(),
+            ctx_.Concurrency(),
+            [this](std::string          database,
+                   std::string          retentionPolicy,
+                   std::vector<Point>   points,
+                   cli::Rollup::Handler handler) {
+                Write(database,
+                      std::move(points),
+                      retentionPolicy,
+                      std::move(handler));
+            });
+    }
     lb_->StartHealthCheck();
+    for (auto& replica : replicas_) { replica->StartHealthCheck(); }
+    if (spill_) { spill_->StartReplay(); }
+    if (rollup_) { rollup_->Start(); }
 }
 
 OPENGEMINI_INLINE_SPECIFIER
 ClientImpl::~ClientImpl()
 {
+    // Windows left are rolled up into writes, then pending batches and their
+    // replicated content are sent before the context stops.
+    if (rollup_) { rollup_->Stop(); }
+    if (batcher_) { batcher_->Close(); }
+    for (auto& replica : replicas_) { replica->Close(); }
+    if (spill_) { spill_->StopReplay(); }
     lb_->StopHealthCheck();
     ctx_.Shutdown();
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+WriteBudgetStatistics ClientImpl::GetWriteBudgetStatistics() const
+{
+    return budget_ ? budget_->Statistics() : WriteBudgetStatistics{};
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+BatchStatistics ClientImpl::GetBatchStatistics() const
+{
+    return batcher_ ? batcher_->Statistics() : BatchStatistics{};
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::vector<ReplicaStatistics> ClientImpl::GetReplicaStatistics() const
+{
+    std::vector<ReplicaStatistics> statistics;
+    statistics.reserve(replicas_.size());
+    for (auto& replica : replicas_) {
+        statistics.push_back(replica->Statistics());
+    }
+    return statistics;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void ClientImpl::Aggregate(std::string_view database,
+                           Point            point,
+                           std::string_view retentionPolicy)
+{
+    if (!rollup_) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Rollup is not configured");
+    }
+    rollup_->Add(database, retentionPolicy, std::move(point));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+RollupStatistics ClientImpl::GetRollupStatistics() const
+{
+    return rollup_ ? rollup_->Statistics() : RollupStatistics{};
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 std::shared_ptr<http::IHttpClient>
 ClientImpl::ConstructHttpClient(const ClientConfig& config)
@@ -75,6 +176,10 @@ ClientImpl::ConstructHttpClient(const ClientConfig& config)
             fmt::format("Basic {}", util::Base64Encode(cred));
     }
 
+    if (config.gzipEnabled) {
+        http->EnableGzip(config.gzipLevel, config.gzipThreshold);
+    }
+
     return http;
 };
 
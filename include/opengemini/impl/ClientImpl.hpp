@@ -16,11 +16,19 @@
 #define OPENGEMINI_IMPL_CLIENTIMPL_HPP
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "opengemini/ClientConfig.hpp"
 #include "opengemini/Query.hpp"
 #include "opengemini/RetentionPolicy.hpp"
+#include "opengemini/impl/cli/write/Batcher.hpp"
+#include "opengemini/impl/cli/write/Replica.hpp"
+#include "opengemini/impl/cli/write/Rollup.hpp"
+#include "opengemini/impl/cli/write/Spill.hpp"
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "opengemini/impl/cli/write/WriteBudget.hpp"
+#include "opengemini/impl/comm/BufferPool.hpp"
 #include "opengemini/impl/comm/Context.hpp"
 #include "opengemini/impl/http/IHttpClient.hpp"
 #include "opengemini/impl/lb/LoadBalancer.hpp"
@@ -71,10 +79,43 @@ public:
                std::string_view   retentionPolicy,
                COMPLETION_TOKEN&& token);
 
+    WriteBudgetStatistics GetWriteBudgetStatistics() const;
+
+    BatchStatistics GetBatchStatistics() const;
+
+    std::vector<ReplicaStatistics> GetReplicaStatistics() const;
+
+    void Aggregate(std::string_view database,
+                   Point            point,
+                   std::string_view retentionPolicy);
+
+    RollupStatistics GetRollupStatistics() const;
+
 private:
     std::shared_ptr<http::IHttpClient>
     ConstructHttpClient(const ClientConfig& config);
 
+    template<typename POINT_TYPE, typename COMPLETION_TOKEN>
+    auto WriteOwned(std::string_view   database,
+                    POINT_TYPE         point,
+                    std::size_t        points,
+                    std::string_view   retentionPolicy,
+                    COMPLETION_TOKEN&& token);
+
+    // Charges a write which is not batched to the budget, throws if it is
+    // refused. Dropping the ticket frees the payload, which the write takes
+    // once it starts.
+    template<typename POINT_TYPE>
+    std::shared_ptr<cli::WriteBudget::Ticket>
+    Charge(const std::shared_ptr<std::optional<POINT_TYPE>>& payload);
+
+    template<typename POINT_TYPE, typename HANDLER>
+    void Enqueue(std::string database,
+                 std::string retentionPolicy,
+                 POINT_TYPE  point,
+                 std::size_t points,
+                 HANDLER&&   handler);
+
     template<typename COMPLETION_SIGNATURE,
              typename COMPLETION_TOKEN,
              typename FUNCTION,
@@ -94,9 +135,19 @@ private:
     void Spawn(FUNCTION&& func, COMPLETION_TOKEN&& token);
 
 private:
-    Context                            ctx_;
-    std::shared_ptr<http::IHttpClient> http_;
-    std::shared_ptr<lb::LoadBalancer>  lb_;
+    // Declared ahead of the context, since pending write tasks still hold
+    // leased buffers and budget tickets until the context is destroyed.
+    BufferPool                        buffers_;
+    std::unique_ptr<cli::WriteBudget> budget_;
+
+    Context                                    ctx_;
+    std::shared_ptr<http::IHttpClient>         http_;
+    std::shared_ptr<lb::LoadBalancer>          lb_;
+    std::shared_ptr<cli::Spill>                spill_;
+    std::vector<std::shared_ptr<cli::Replica>> replicas_;
+    cli::WriteOptions                          writeOptions_;
+    std::shared_ptr<cli::Batcher>              batcher_;
+    std::shared_ptr<cli::Rollup>               rollup_;
 };
 
 } // namespace opengemini::impl
@@ -16,6 +16,7 @@
 
 #include <boost/exception/diagnostic_information.hpp>
 
+#include "opengemini/Exception.hpp"
 #include "opengemini/impl/cli/database/Database.hpp"
 #include "opengemini/impl/cli/database/Ping.hpp"
 #include "opengemini/impl/cli/policy/RetentionPolicy.hpp"
@@ -202,28 +203,159 @@ auto ClientImpl::Write(std::string_view   database,
                        POINT_TYPE         point,
                        std::string_view   retentionPolicy,
                        COMPLETION_TOKEN&& token)
+{
+    // Counted ahead, since the points may be encoded before the write is
+    // initiated.
+    auto points = batcher_ ? cli::CountPoints(point) : 0;
+
+    if constexpr (cli::IsPointView_v<POINT_TYPE>) {
+        // The viewed data is only guaranteed to be alive during this call,
+        // which is over before asynchronous or deferred operations start.
+        return WriteOwned(database,
+                          cli::EncodeEagerly(buffers_, point),
+                          points,
+                          retentionPolicy,
+                          std::forward<COMPLETION_TOKEN>(token));
+    }
+    else if constexpr (std::is_same_v<POINT_TYPE, RawLines>) {
+        return WriteOwned(database,
+                          cli::PrepareRawLines(buffers_, std::move(point)),
+                          points,
+                          retentionPolicy,
+                          std::forward<COMPLETION_TOKEN>(token));
+    }
+    else {
+        return WriteOwned(database,
+                          std::move(point),
+                          points,
+                          retentionPolicy,
+                          std::forward<COMPLETION_TOKEN>(token));
+    }
+}
+
+template<typename POINT_TYPE, typename COMPLETION_TOKEN>
+auto ClientImpl::WriteOwned(std::string_view   database,
+                            POINT_TYPE         point,
+                            std::size_t        points,
+                            std::string_view   retentionPolicy,
+                            COMPLETION_TOKEN&& token)
 {
     using Signature = sig::Write;
     return boost::asio::async_initiate<COMPLETION_TOKEN, Signature>(
         [this](auto&&      token,
                std::string database,
                std::string retentionPolicy,
-               POINT_TYPE  point) {
+               POINT_TYPE  point,
+               std::size_t points) {
             static_assert(util::IsInvocable_v<decltype(token), Signature>,
                           "Completion signature of Write must be: "
                           "void(std::exception_ptr)");
 
+            if (batcher_) {
+                Enqueue(std::move(database),
+                        std::move(retentionPolicy),
+                        std::move(point),
+                        points,
+                        OPENGEMINI_PF(token));
+                return;
+            }
+
+            if (!budget_) {
+                Spawn<Signature>(
+                    cli::RunWrite<POINT_TYPE>{ { *http_, *lb_ },
+                                               buffers_,
+                                               writeOptions_,
+                                               std::move(database),
+                                               std::move(retentionPolicy),
+                                               std::move(point) },
+                    OPENGEMINI_PF(token));
+                return;
+            }
+
+            auto payload =
+                std::make_shared<std::optional<POINT_TYPE>>(std::move(point));
+            std::shared_ptr<cli::WriteBudget::Ticket> ticket;
+            try {
+                ticket = Charge(payload);
+            }
+            catch (...) {
+                boost::asio::post(ctx_(),
+                                  [_token = OPENGEMINI_PF(token),
+                                   ex = std::current_exception()]() mutable {
+                                      _token(util::ConvertException(ex));
+                                  });
+                return;
+            }
+
             Spawn<Signature>(
-                cli::RunWrite<POINT_TYPE>{ { *http_, *lb_ },
-                                           std::move(database),
-                                           std::move(retentionPolicy),
-                                           std::move(point) },
+                [this,
+                 database        = std::move(database),
+                 retentionPolicy = std::move(retentionPolicy),
+                 payload         = std::move(payload),
+                 ticket          = std::move(ticket)](
+                    boost::asio::yield_context yield) mutable {
+                    // Held on the stack of the coroutine, so that the budget
+                    // is released before the write completes.
+                    auto held = std::move(ticket);
+                    if (!held->Start()) {
+                        throw Exception(errc::RuntimeErrors::WriteDropped);
+                    }
+                    cli::RunWrite<POINT_TYPE>{ { *http_, *lb_ },
+                                               buffers_,
+                                               writeOptions_,
+                                               std::move(database),
+                                               std::move(retentionPolicy),
+                                               std::move(payload->value()) }(
+                        yield);
+                },
                 OPENGEMINI_PF(token));
         },
         token,
         std::string(database),
         std::string(retentionPolicy),
-        std::move(point));
+        std::move(point),
+        points);
+}
+
+template<typename POINT_TYPE>
+std::shared_ptr<cli::WriteBudget::Ticket>
+ClientImpl::Charge(const std::shared_ptr<std::optional<POINT_TYPE>>& payload)
+{
+    // A dropped write fails once its coroutine starts, without being sent, but
+    // its payload is freed right away, before its bytes are released.
+    return budget_->Charge(cli::EstimateSize(payload->value()), [payload] {
+        payload->reset();
+        return std::size_t{ 1 };
+    });
+}
+
+template<typename POINT_TYPE, typename HANDLER>
+void ClientImpl::Enqueue(std::string database,
+                         std::string retentionPolicy,
+                         POINT_TYPE  point,
+                         std::size_t points,
+                         HANDLER&&   handler)
+{
+    auto content = [this, &point] {
+        if constexpr (std::is_same_v<POINT_TYPE, cli::EncodedContent>) {
+            return std::move(point);
+        }
+        else {
+            return cli::EncodeEagerly(buffers_, point);
+        }
+    }();
+
+    // Shared since the handler may be move-only, while the handlers of a batch
+    // are kept as copyable functions.
+    auto shared =
+        std::make_shared<std::decay_t<HANDLER>>(std::forward<HANDLER>(handler));
+    batcher_->Enqueue(std::move(database),
+                      std::move(retentionPolicy),
+                      std::move(content),
+                      points,
+                      [shared](std::exception_ptr ex) {
+                          (*shared)(std::move(ex));
+                      });
 }
 
 template<typename COMPLETION_SIGNATURE,
@@ -91,6 +91,8 @@ std::string ServerCategory::message(int value) const
     case ServerErrors::UnexpectedStatusCode:
         return "Receive unexpected status code from server";
     case ServerErrors::ErrorResult: return "Receive error result from server";
+    case ServerErrors::PartialWrite:
+        return "Some of the points are rejected by server";
     }
     return "Unknown";
 }
@@ -117,6 +119,9 @@ std::string RuntimeCategory::message(int value) const
 {
     switch (static_cast<RuntimeErrors>(value)) {
     case RuntimeErrors::Unexpected: return "Unexpected error happened";
+    case RuntimeErrors::WriteBudgetExceeded: return "Write budget exceeded";
+    case RuntimeErrors::WriteDropped:
+        return "Write dropped to make room for newer writes";
     }
     return "Unknown";
 }
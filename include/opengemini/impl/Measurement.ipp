@@ -0,0 +1,54 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/Measurement.hpp"
+
+#include "opengemini/impl/enc/Schema.hpp"
+
+namespace opengemini::schema {
+
+template<std::size_t N>
+constexpr auto Measurement(const char (&name)[N])
+{
+    static_assert(N > 1, "Measurement name must not be empty");
+    return impl::enc::EscapedString<N>(name,
+                                       impl::enc::EscapeClass::Measurement);
+}
+
+template<std::size_t N, typename OWNER, typename VALUE>
+constexpr auto Tag(const char (&key)[N], VALUE OWNER::*member)
+{
+    static_assert(N > 1, "Tag key must not be empty");
+    static_assert(impl::enc::IsTagValue_v<VALUE>,
+                  "Tag value must be convertible to std::string_view");
+    return impl::enc::TagSchema<N, OWNER, VALUE>{
+        { key, impl::enc::EscapeClass::Tag, ',', '=' },
+        member
+    };
+}
+
+template<std::size_t N, typename OWNER, typename VALUE>
+constexpr auto Field(const char (&key)[N], VALUE OWNER::*member)
+{
+    static_assert(N > 1, "Field key must not be empty");
+    static_assert(impl::enc::IsFieldValue_v<VALUE>,
+                  "Field value must be arithmetic or convertible to "
+                  "std::string_view");
+    return impl::enc::FieldSchema<N, OWNER, VALUE>{
+        { key, impl::enc::EscapeClass::FieldKey, '\0', '=' },
+        member
+    };
+}
+
+} // namespace opengemini::schema
@@ -0,0 +1,59 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/SeriesKey.hpp"
+
+#include <utility>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/enc/Escape.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini {
+
+OPENGEMINI_INLINE_SPECIFIER
+SeriesKey::SeriesKey(std::string_view                          measurement,
+                     const std::map<std::string, std::string>& tags)
+{
+    using impl::enc::EscapeClass;
+
+    if (measurement.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "The measurement of SeriesKey must not be empty");
+    }
+
+    std::string key;
+    impl::enc::AppendEscaped(key, measurement, EscapeClass::Measurement);
+    for (auto& [tagKey, tagValue] : tags) {
+        key.push_back(',');
+        impl::enc::AppendEscaped(key, tagKey, EscapeClass::Tag);
+        key.push_back('=');
+        impl::enc::AppendEscaped(key, tagValue, EscapeClass::Tag);
+    }
+    key_ = std::make_shared<const std::string>(std::move(key));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::string_view SeriesKey::View() const noexcept
+{
+    return key_ ? std::string_view{ *key_ } : std::string_view{};
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool SeriesKey::Empty() const noexcept
+{
+    return !key_;
+}
+
+} // namespace opengemini
@@ -0,0 +1,112 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/BatchController.hpp"
+
+#include <algorithm>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+OPENGEMINI_INLINE_SPECIFIER
+BatchController::BatchController(const AdaptiveBatchConfig& config,
+                                 std::size_t                initialSize) :
+    minSize_(config.minBatchSize),
+    maxSize_(config.maxBatchSize),
+    maxInFlight_(config.maxInFlight),
+    target_(config.targetLatency),
+    step_(std::max<std::size_t>((maxSize_ - minSize_) / 16, 1)),
+    size_(initialSize)
+{
+    if (minSize_ == 0 || minSize_ > maxSize_) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Batch size bounds must be positive and ordered");
+    }
+    if (maxInFlight_ == 0 || target_.count() <= 0) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Batches in flight and target latency must be "
+                        "positive");
+    }
+    size_.store(std::clamp(initialSize, minSize_, maxSize_));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t BatchController::BatchSize() const noexcept
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t BatchController::MaxInFlight() const noexcept
+{
+    return inFlight_.load(std::memory_order_relaxed);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void BatchController::Observe(const Endpoint& endpoint,
+                              Clock::duration latency,
+                              bool            failed)
+{
+    using std::chrono::microseconds;
+
+    const auto      now = Clock::now();
+    std::lock_guard lock(mutex_);
+
+    auto& observed   = Find(endpoint);
+    auto  sample     = std::chrono::duration_cast<microseconds>(latency);
+    observed.latency = observed.requests == 0
+                           ? sample
+                           : observed.latency + (sample - observed.latency) / 8;
+    ++observed.requests;
+
+    if (failed || latency > target_) {
+        ++observed.overloaded;
+        if (halved_ && now - latency < *halved_) { return; }
+
+        size_.store(std::max(size_.load() / 2, minSize_));
+        inFlight_.store(std::max<std::size_t>(inFlight_.load() / 2, 1));
+        onTime_ = 0;
+        halved_ = now;
+        return;
+    }
+
+    size_.store(std::min(size_.load() + step_, maxSize_));
+    if (++onTime_ >= inFlight_.load()) {
+        onTime_ = 0;
+        inFlight_.store(std::min(inFlight_.load() + 1, maxInFlight_));
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::vector<EndpointLatency> BatchController::Endpoints() const
+{
+    std::lock_guard lock(mutex_);
+    return endpoints_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+EndpointLatency& BatchController::Find(const Endpoint& endpoint)
+{
+    auto it = std::find_if(endpoints_.begin(),
+                           endpoints_.end(),
+                           [&endpoint](const EndpointLatency& observed) {
+                               return observed.endpoint == endpoint;
+                           });
+    if (it != endpoints_.end()) { return *it; }
+    return endpoints_.emplace_back(EndpointLatency{ endpoint });
+}
+
+} // namespace opengemini::impl::cli
@@ -0,0 +1,84 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_BATCHCONTROLLER_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_BATCHCONTROLLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/Endpoint.hpp"
+
+namespace opengemini::impl::cli {
+
+//
+// Adapts the size of batches and the number of them in flight to the write
+// requests made for them, on every server. While requests complete within the
+// target latency, the batch size grows by a sixteenth of its range per request
+// and the number in flight by one per as many requests as are allowed in
+// flight. A request which is late or fails as if its server were overloaded
+// halves both, unless it was sent before the last time they were halved,
+// since it then tells nothing about the current settings.
+//
+class BatchController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    BatchController(const AdaptiveBatchConfig& config, std::size_t initialSize);
+    ~BatchController() = default;
+
+    std::size_t BatchSize() const noexcept;
+    std::size_t MaxInFlight() const noexcept;
+
+    // Records a request to the server which completed after the latency, and
+    // whether it failed as if the server were overloaded.
+    void Observe(const Endpoint& endpoint,
+                 Clock::duration latency,
+                 bool            failed);
+
+    std::vector<EndpointLatency> Endpoints() const;
+
+private:
+    BatchController(const BatchController&)            = delete;
+    BatchController& operator=(const BatchController&) = delete;
+
+    EndpointLatency& Find(const Endpoint& endpoint);
+
+private:
+    const std::size_t     minSize_;
+    const std::size_t     maxSize_;
+    const std::size_t     maxInFlight_;
+    const Clock::duration target_;
+    const std::size_t     step_;
+
+    std::atomic<std::size_t> size_;
+    std::atomic<std::size_t> inFlight_{ 1 };
+
+    mutable std::mutex               mutex_;
+    std::size_t                      onTime_{ 0 };
+    std::optional<Clock::time_point> halved_;
+    std::vector<EndpointLatency>     endpoints_;
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/BatchController.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_BATCHCONTROLLER_HPP
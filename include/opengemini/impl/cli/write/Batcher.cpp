@@ -0,0 +1,410 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/Batcher.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <boost/asio/spawn.hpp>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/util/ErrorHandling.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+namespace {
+
+std::exception_ptr ClosedError()
+{
+    return std::make_exception_ptr(
+        Exception(errc::RuntimeErrors::WriteDropped, "Batcher is closed"));
+}
+
+} // namespace
+
+OPENGEMINI_INLINE_SPECIFIER
+Batcher::Batcher(PrivateConstructor,
+                 boost::asio::io_context&           ctx,
+                 Functor                            functor,
+                 BufferPool&                        buffers,
+                 const WriteOptions&                options,
+                 const BatchConfig&                 config,
+                 WriteBudget*                       budget,
+                 std::optional<AdaptiveBatchConfig> adaptive) :
+    TaskSlot(ctx),
+    functor_(functor),
+    buffers_(buffers),
+    options_(options),
+    budget_(budget),
+    interval_(config.batchInterval),
+    size_(config.batchSize),
+    ring_(1024)
+{
+    if (interval_.count() <= 0 || size_ == 0) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Batch interval and size must be positive");
+    }
+    if (adaptive) {
+        controller_ =
+            std::make_unique<BatchController>(adaptive.value(), size_);
+        options_.controller = controller_.get();
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Enqueue(std::string    database,
+                      std::string    retentionPolicy,
+                      EncodedContent content,
+                      std::size_t    points,
+                      Handler        handler)
+{
+    if (closed_.load()) {
+        Fail(std::move(handler), ClosedError());
+        return;
+    }
+    if (database.empty()) {
+        Fail(std::move(handler),
+             std::make_exception_ptr(
+                 Exception(errc::LogicErrors::InvalidArgument,
+                           "Database name cannot be empty")));
+        return;
+    }
+    if (content.error) {
+        Fail(std::move(handler), content.error);
+        return;
+    }
+
+    std::size_t bytes{ 0 };
+    if (budget_) {
+        try {
+            bytes = EstimateSize(content);
+            budget_->Acquire(bytes);
+        }
+        catch (...) {
+            Fail(std::move(handler), std::current_exception());
+            return;
+        }
+    }
+
+    Submission submission{ Key{ std::move(database),
+                                std::move(retentionPolicy) },
+                           std::move(content),
+                           points,
+                           bytes,
+                           std::move(handler) };
+    // The drainer may be posted to this very thread, in which case it cannot
+    // run before this returns, hence is never waited for.
+    const bool inContext = ctx_.get_executor().running_in_this_thread();
+    while (!ring_.TryPush(submission)) {
+        // Drains the full ring on this thread unless another one already is.
+        if (!draining_.exchange(true)) { Drain(); }
+        else if (inContext) { Assist(); }
+        else { std::this_thread::yield(); }
+    }
+
+    // Pairs with the fence in Drain(), so that either the drainer sees the
+    // submission or this sees the drainer is done and starts another.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!draining_.load(std::memory_order_relaxed) &&
+        !draining_.exchange(true)) {
+        boost::asio::post(ctx_, [self = shared_from_this()] { self->Drain(); });
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Close()
+{
+    // On a thread of the context, the drainer is not waited for, but collected
+    // alongside under the lock, as it may be posted to this very thread.
+    const bool inContext = ctx_.get_executor().running_in_this_thread();
+    bool       draining  = !draining_.exchange(true);
+    while (!draining && !inContext) {
+        std::this_thread::yield();
+        draining = !draining_.exchange(true);
+    }
+
+    // Submissions which made it into the ring before are sent with the last
+    // batches, those after are failed by whoever drains them.
+    std::unique_lock lock(mutex_);
+    Collect();
+    closed_.store(true);
+    for (auto it = batches_.begin(); it != batches_.end();) {
+        // Dropped batches are left to be discarded.
+        if (!Start(*it->second)) {
+            ++it;
+            continue;
+        }
+        it->second->timer.cancel();
+        queued_.push_back(std::move(it->second));
+        it = batches_.erase(it);
+        ++sending_;
+    }
+    // The queued batches which are not admitted now are sent as those in
+    // flight complete.
+    std::vector<std::shared_ptr<Batch>> batches;
+    Admit(batches);
+    lock.unlock();
+
+    for (auto& batch : batches) { Send(std::move(batch)); }
+
+    if (draining) { draining_.store(false); }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ring_.Empty() && !draining_.exchange(true)) { Drain(); }
+
+    if (inContext) { return; }
+    lock.lock();
+    sent_.wait(lock, [this] { return sending_ == 0; });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Drain()
+{
+    std::vector<std::shared_ptr<Batch>> admitted;
+    do {
+        {
+            std::lock_guard lock(mutex_);
+            Collect();
+            Admit(admitted);
+        }
+        for (auto& batch : admitted) { Send(std::move(batch)); }
+        admitted.clear();
+
+        draining_.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    } while (!ring_.Empty() && !draining_.exchange(true));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Assist()
+{
+    std::vector<std::shared_ptr<Batch>> admitted;
+    {
+        std::lock_guard lock(mutex_);
+        Collect();
+        Admit(admitted);
+    }
+    for (auto& batch : admitted) { Send(std::move(batch)); }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Collect()
+{
+    for (Submission submission; ring_.TryPop(submission);) {
+        if (!closed_.load()) {
+            Add(submission);
+            continue;
+        }
+        if (budget_) { budget_->Release(submission.bytes); }
+        Fail(std::move(submission.handler), ClosedError());
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Add(Submission& submission)
+{
+    auto [it, created] = batches_.try_emplace(std::move(submission.key));
+    auto& batch        = it->second;
+    if (created) {
+        batch = std::make_shared<Batch>(ctx_,
+                                        it->first.first,
+                                        it->first.second);
+        batch->timer.expires_after(interval_);
+        batch->timer.async_wait(
+            [self = shared_from_this(), expired = std::weak_ptr(batch)](
+                const boost::system::error_code& error) {
+                if (!error) { self->Expire(expired); }
+            });
+        if (budget_) {
+            batch->ticket = budget_->Track(
+                [weak = weak_from_this(), dropped = std::weak_ptr(batch)] {
+                    auto self = weak.lock();
+                    return self ? self->Discard(dropped) : 0;
+                });
+        }
+    }
+
+    batch->Append(submission.content.parts);
+    batch->points += submission.points;
+    batch->handlers.push_back(std::move(submission.handler));
+    if (batch->ticket) { batch->ticket->Hold(submission.bytes); }
+    submission.content.parts.clear();
+    if (batch->points >= BatchSize() && Start(*batch)) {
+        batch->timer.cancel();
+        queued_.push_back(std::move(batch));
+        batches_.erase(it);
+        ++sending_;
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Batcher::Batch::Batch(boost::asio::io_context& ctx,
+                      std::string              database,
+                      std::string              retentionPolicy) :
+    database(std::move(database)),
+    retentionPolicy(std::move(retentionPolicy)),
+    timer(ctx)
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Batch::Append(std::vector<EncodedContent::Part>& parts)
+{
+    for (auto& part : parts) {
+        auto it = std::find_if(content.parts.begin(),
+                               content.parts.end(),
+                               [&part](const EncodedContent::Part& present) {
+                                   return present.precision == part.precision;
+                               });
+        if (it == content.parts.end()) {
+            content.parts.push_back(std::move(part));
+        }
+        else {
+            // Raw lines may leave out the last line break.
+            auto& present = *it->content;
+            if (!present.empty() && present.back() != '\n') {
+                present.push_back('\n');
+            }
+            present.append(*part.content);
+        }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Expire(const std::weak_ptr<Batch>& expired)
+{
+    std::vector<std::shared_ptr<Batch>> admitted;
+    {
+        std::lock_guard lock(mutex_);
+        auto            batch = expired.lock();
+        if (!batch) { return; }
+
+        // The batch may have been sent for its size in the meantime, and
+        // another one started for the same key.
+        auto it = batches_.find(Key{ batch->database, batch->retentionPolicy });
+        if (it == batches_.end() || it->second != batch || !Start(*batch)) {
+            return;
+        }
+        batches_.erase(it);
+        queued_.push_back(std::move(batch));
+        ++sending_;
+        Admit(admitted);
+    }
+    for (auto& batch : admitted) { Send(std::move(batch)); }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Admit(std::vector<std::shared_ptr<Batch>>& admitted)
+{
+    while (!queued_.empty() &&
+           (!controller_ || inFlight_ < controller_->MaxInFlight())) {
+        admitted.push_back(std::move(queued_.front()));
+        queued_.pop_front();
+        ++inFlight_;
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Send(std::shared_ptr<Batch> batch)
+{
+    // The content is moved onto the stack of the coroutine, so that its
+    // buffers are back in the pool before the writes complete.
+    boost::asio::spawn(
+        ctx_,
+        [this, batch](boost::asio::yield_context yield) {
+            RunWrite<EncodedContent>{ functor_,
+                                      buffers_,
+                                      options_,
+                                      batch->database,
+                                      batch->retentionPolicy,
+                                      std::move(batch->content) }(yield);
+        },
+        [self = shared_from_this(), batch](std::exception_ptr ex) {
+            // The budget is released, and the next batch started, before the
+            // writes complete.
+            batch->ticket.reset();
+            std::vector<std::shared_ptr<Batch>> admitted;
+            {
+                std::lock_guard lock(self->mutex_);
+                --self->inFlight_;
+                self->Admit(admitted);
+            }
+            for (auto& next : admitted) { self->Send(std::move(next)); }
+
+            auto error = util::ConvertException(ex);
+            for (auto& handler : batch->handlers) { handler(error); }
+
+            std::lock_guard lock(self->mutex_);
+            if (--self->sending_ == 0) { self->sent_.notify_all(); }
+        });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+BatchStatistics Batcher::Statistics() const
+{
+    BatchStatistics statistics;
+    statistics.batchSize = BatchSize();
+    if (controller_) {
+        statistics.maxInFlight = controller_->MaxInFlight();
+        statistics.endpoints   = controller_->Endpoints();
+    }
+
+    std::lock_guard lock(mutex_);
+    statistics.inFlight = inFlight_;
+    statistics.queued   = queued_.size();
+    return statistics;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t Batcher::BatchSize() const noexcept
+{
+    return controller_ ? controller_->BatchSize() : size_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t Batcher::Discard(const std::weak_ptr<Batch>& dropped)
+{
+    auto batch = dropped.lock();
+    if (!batch) { return 0; }
+
+    std::vector<Handler> handlers;
+    {
+        std::lock_guard lock(mutex_);
+        auto it = batches_.find(Key{ batch->database, batch->retentionPolicy });
+        if (it != batches_.end() && it->second == batch) { batches_.erase(it); }
+        batch->timer.cancel();
+        handlers.swap(batch->handlers);
+    }
+
+    auto error = std::make_exception_ptr(
+        Exception(errc::RuntimeErrors::WriteDropped));
+    for (auto& handler : handlers) { Fail(std::move(handler), error); }
+    return handlers.size();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Batcher::Start(Batch& batch)
+{
+    return !batch.ticket || batch.ticket->Start();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Batcher::Fail(Handler handler, std::exception_ptr error)
+{
+    boost::asio::post(ctx_, [handler = std::move(handler), error] {
+        handler(util::ConvertException(error));
+    });
+}
+
+} // namespace opengemini::impl::cli
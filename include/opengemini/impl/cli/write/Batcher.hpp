@@ -0,0 +1,198 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_BATCHER_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_BATCHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/impl/cli/Functor.hpp"
+#include "opengemini/impl/cli/write/BatchController.hpp"
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "opengemini/impl/cli/write/WriteBudget.hpp"
+#include "opengemini/impl/comm/BufferPool.hpp"
+#include "opengemini/impl/comm/MpscRing.hpp"
+#include "opengemini/impl/comm/TaskSlot.hpp"
+
+namespace opengemini::impl::cli {
+
+//
+// Gathers encoded writes into one batch per database and retention policy. A
+// batch is sent on the threads of the context once it holds enough points or
+// its interval has elapsed since its first write, as one request per precision
+// of its content. Every write of the batch completes with the outcome of the
+// batch.
+//
+// Writers only push into a lock-free ring, which a single drainer at a time
+// empties into the batches, so that concurrent writers do not contend on the
+// lock of the batches.
+//
+// With a write budget, every write is charged its encoded size, which the
+// ticket of its batch holds until the batch completes. Dropping the ticket of
+// a pending batch fails all of its writes.
+//
+// With adaptive batching, the size of batches and the number of them in
+// flight follow the controller, full batches being queued in order until
+// there is room in flight for them.
+//
+class Batcher :
+    public TaskSlot,
+    public std::enable_shared_from_this<Batcher> {
+private:
+    struct PrivateConstructor {
+        constexpr PrivateConstructor() = default;
+    };
+
+public:
+    using Handler = std::function<void(std::exception_ptr)>;
+
+    template<typename... ARGS>
+    static std::shared_ptr<Batcher> Construct(ARGS&&... args)
+    {
+        return std::make_shared<Batcher>(PrivateConstructor{},
+                                         std::forward<ARGS>(args)...);
+    }
+
+    Batcher(PrivateConstructor,
+            boost::asio::io_context&           ctx,
+            Functor                            functor,
+            BufferPool&                        buffers,
+            const WriteOptions&                options,
+            const BatchConfig&                 config,
+            WriteBudget*                       budget   = nullptr,
+            std::optional<AdaptiveBatchConfig> adaptive = std::nullopt);
+
+    ~Batcher() = default;
+
+    // Submits the content to the batch of the database and retention policy,
+    // the handler being invoked once the batch is sent. Invalid writes are
+    // failed right away, without affecting the batch, as are writes refused by
+    // the budget, or submitted once closed. Submitting blocks while the ring is
+    // full, but on a thread of the context it empties the ring itself instead
+    // of waiting for the drainer.
+    void Enqueue(std::string    database,
+                 std::string    retentionPolicy,
+                 EncodedContent content,
+                 std::size_t    points,
+                 Handler        handler);
+
+    // Sends every pending batch and waits until all of them have completed.
+    // Called on a thread of the context, which the batches need to complete,
+    // it returns once they are sent, leaving them to complete on the context.
+    void Close();
+
+    BatchStatistics Statistics() const;
+
+private:
+    struct Batch {
+        Batch(boost::asio::io_context& ctx,
+              std::string              database,
+              std::string              retentionPolicy);
+
+        // Moves the parts into the content, appending those of a precision
+        // already present to its part.
+        void Append(std::vector<EncodedContent::Part>& parts);
+
+        std::string               database;
+        std::string               retentionPolicy;
+        EncodedContent            content;
+        std::size_t               points{ 0 };
+        std::vector<Handler>      handlers;
+        boost::asio::steady_timer timer;
+
+        std::shared_ptr<WriteBudget::Ticket> ticket;
+    };
+
+    using Key = std::pair<std::string, std::string>;
+
+    struct Submission {
+        Key            key;
+        EncodedContent content;
+        std::size_t    points{ 0 };
+        std::size_t    bytes{ 0 };
+        Handler        handler;
+    };
+
+private:
+    // Empties the ring into the batches, for as long as submissions keep
+    // coming. Only called by the thread which set the draining flag.
+    void Drain();
+    // Empties the ring into the batches once, while another thread holds the
+    // draining flag. Popping is serialized by the lock, which every drainer
+    // holds while collecting.
+    void Assist();
+    // Moves the submissions in the ring into their batches, queueing those
+    // which became full, or fails them once closed. Called with the lock held.
+    void Collect();
+    void Add(Submission& submission);
+    void Expire(const std::weak_ptr<Batch>& expired);
+    // Fails the writes of a batch dropped by the budget, returning how many
+    // there were.
+    std::size_t Discard(const std::weak_ptr<Batch>& dropped);
+    // Whether the batch may be sent, i.e. was not dropped by the budget.
+    // Called with the lock held, before the batch leaves the map.
+    static bool Start(Batch& batch);
+    // Moves as many of the queued batches as there is room for in flight into
+    // the vector, to be sent. Called with the lock held.
+    void Admit(std::vector<std::shared_ptr<Batch>>& admitted);
+    void Send(std::shared_ptr<Batch> batch);
+    std::size_t BatchSize() const noexcept;
+    void Fail(Handler handler, std::exception_ptr error);
+
+private:
+    Functor      functor_;
+    BufferPool&  buffers_;
+    WriteOptions options_;
+    WriteBudget* budget_;
+
+    std::unique_ptr<BatchController> controller_;
+
+    const std::chrono::milliseconds interval_;
+    const std::size_t               size_;
+
+    MpscRing<Submission> ring_;
+    std::atomic<bool>    draining_{ false };
+    std::atomic<bool>    closed_{ false };
+
+    mutable std::mutex                    mutex_;
+    std::map<Key, std::shared_ptr<Batch>> batches_;
+    std::deque<std::shared_ptr<Batch>>    queued_;
+    std::size_t                           inFlight_{ 0 };
+
+    std::condition_variable sent_;
+    // Batches which left the map, queued or in flight.
+    std::size_t sending_{ 0 };
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/Batcher.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_BATCHER_HPP
@@ -0,0 +1,190 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/Replica.hpp"
+
+#include <utility>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+namespace {
+
+// Whether the write failed for the cluster being out of reach, rather than
+// refusing it.
+bool IsUnreachable(const std::exception_ptr& ex)
+{
+    try {
+        std::rethrow_exception(ex);
+    }
+    catch (const Exception& error) {
+        const auto& underlying = error.UnderlyingError();
+        return IsRetryable(underlying) ||
+               underlying.Code() == errc::ServerErrors::NoAvailableServer;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+} // namespace
+
+OPENGEMINI_INLINE_SPECIFIER
+Replica::Replica(PrivateConstructor,
+                 boost::asio::io_context&           ctx,
+                 const ReplicaConfig&               config,
+                 std::shared_ptr<http::IHttpClient> http,
+                 BufferPool&                        buffers,
+                 std::optional<RetryConfig>         retry,
+                 bool                               bisect,
+                 std::chrono::milliseconds          retryInterval) :
+    TaskSlot(ctx),
+    maxBytes_(config.maxPendingBytes),
+    retry_(std::move(retry)),
+    bisect_(bisect),
+    retryInterval_(retryInterval),
+    buffers_(buffers),
+    http_(std::move(http)),
+    lb_(lb::LoadBalancer::Construct(ctx, config.addresses, http_)),
+    timer_(ctx_)
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Replica::Reserve(std::size_t bytes)
+{
+    std::lock_guard lock(mutex_);
+    if (statistics_.pendingBytes + bytes > maxBytes_) {
+        ++statistics_.dropped;
+        return false;
+    }
+    statistics_.pendingBytes += bytes;
+    ++pending_;
+    return true;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::Replicate(std::string          database,
+                        std::string          retentionPolicy,
+                        const SharedContent& content)
+{
+    Send({ std::move(database),
+           std::move(retentionPolicy),
+           content.precision,
+           content.parts });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::StartHealthCheck()
+{
+    lb_->StartHealthCheck();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::Close()
+{
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        for (auto& write : held_) { Complete(write, false); }
+        held_.clear();
+    }
+    timer_.cancel();
+
+    if (!ctx_.get_executor().running_in_this_thread()) {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return pending_ == 0; });
+    }
+    lb_->StopHealthCheck();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+ReplicaStatistics Replica::Statistics() const
+{
+    std::lock_guard lock(mutex_);
+    return statistics_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::Send(Pending write)
+{
+    boost::asio::spawn(
+        ctx_,
+        [self = shared_from_this(), write](boost::asio::yield_context yield) {
+            // Neither spilled, fanned out nor replicated any further.
+            WriteOptions options{ 0, 1, 0, false, self->retry_, self->bisect_ };
+            RunWrite<SharedContent>{ { *self->http_, *self->lb_ },
+                                     self->buffers_,
+                                     options,
+                                     write.database,
+                                     write.retentionPolicy,
+                                     { write.precision, write.parts } }(yield);
+        },
+        [self = shared_from_this(), write](std::exception_ptr ex) mutable {
+            if (ex && IsUnreachable(ex) && self->Hold(write)) { return; }
+            std::lock_guard lock(self->mutex_);
+            self->Complete(write, !ex);
+        });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Replica::Hold(Pending& write)
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (closed_) { return false; }
+        held_.push_back(std::move(write));
+        if (std::exchange(resending_, true)) { return true; }
+    }
+
+    boost::asio::spawn(
+        ctx_,
+        [self = shared_from_this()](auto yield) { self->Resend(yield); },
+        boost::asio::detached);
+    return true;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::Resend(boost::asio::yield_context yield)
+{
+    for (;;) {
+        boost::system::error_code error;
+        timer_.expires_after(retryInterval_);
+        timer_.async_wait(yield[error]);
+
+        std::deque<Pending> writes;
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_ || held_.empty()) {
+                resending_ = false;
+                return;
+            }
+            if (lb_->CountAvailableServers() == 0) { continue; }
+            writes.swap(held_);
+        }
+        for (auto& write : writes) { Send(std::move(write)); }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Replica::Complete(const Pending& write, bool written)
+{
+    statistics_.pendingBytes -= http::SharedBody::size(write.parts);
+    ++(written ? statistics_.written : statistics_.failed);
+    if (--pending_ == 0) { idle_.notify_all(); }
+}
+
+} // namespace opengemini::impl::cli
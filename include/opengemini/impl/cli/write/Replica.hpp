@@ -0,0 +1,136 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_REPLICA_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_REPLICA_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/impl/comm/BufferPool.hpp"
+#include "opengemini/impl/comm/TaskSlot.hpp"
+#include "opengemini/impl/http/IHttpClient.hpp"
+#include "opengemini/impl/lb/LoadBalancer.hpp"
+
+namespace opengemini::impl::cli {
+
+struct SharedContent;
+
+//
+// Sends every write to a replica cluster as well, through connections and
+// health checks of its own, retried and bisected like the writes to the
+// primary cluster. Writes are sent in the background and held until the
+// cluster takes them, up to a number of bytes past which they are dropped, so
+// that a slow or failing cluster never stalls the others. Writes which could
+// not reach the cluster are resent once it has an available server again,
+// while those it refused fail.
+//
+class Replica : public TaskSlot, public std::enable_shared_from_this<Replica> {
+private:
+    struct PrivateConstructor {
+        constexpr PrivateConstructor() = default;
+    };
+
+public:
+    template<typename... ARGS>
+    static std::shared_ptr<Replica> Construct(ARGS&&... args)
+    {
+        return std::make_shared<Replica>(PrivateConstructor{},
+                                         std::forward<ARGS>(args)...);
+    }
+
+    Replica(PrivateConstructor,
+            boost::asio::io_context&           ctx,
+            const ReplicaConfig&               config,
+            std::shared_ptr<http::IHttpClient> http,
+            BufferPool&                        buffers,
+            std::optional<RetryConfig>         retry,
+            bool                               bisect,
+            std::chrono::milliseconds retryInterval = std::chrono::seconds(1));
+
+    ~Replica() = default;
+
+    // Reserves room for content of the size among the pending bytes, which
+    // has to be replicated then, or counts it as dropped if there is none, so
+    // that dropped content is never copied.
+    bool Reserve(std::size_t bytes);
+    // Writes the content room was reserved for in the background. The content
+    // is shared with the other clusters, and never modified.
+    void Replicate(std::string          database,
+                   std::string          retentionPolicy,
+                   const SharedContent& content);
+
+    void StartHealthCheck();
+    // Fails the held writes, waits for those in flight to complete, then stops
+    // the health check. Called on a thread of the context, which the writes
+    // need to complete, it leaves them to complete on the context.
+    void Close();
+
+    ReplicaStatistics Statistics() const;
+
+private:
+    struct Pending {
+        std::string                                     database;
+        std::string                                     retentionPolicy;
+        Precision                                       precision;
+        std::shared_ptr<const std::vector<std::string>> parts;
+    };
+
+private:
+    void Send(Pending write);
+    // Holds the write until the cluster can be reached again, unless closed.
+    bool Hold(Pending& write);
+    // Resends the held writes whenever the cluster has an available server,
+    // until none is left.
+    void Resend(boost::asio::yield_context yield);
+    // Called with the lock held.
+    void Complete(const Pending& write, bool written);
+
+private:
+    const std::size_t                maxBytes_;
+    const std::optional<RetryConfig> retry_;
+    const bool                       bisect_;
+    const std::chrono::milliseconds  retryInterval_;
+
+    BufferPool& buffers_;
+
+    std::shared_ptr<http::IHttpClient> http_;
+    std::shared_ptr<lb::LoadBalancer>  lb_;
+
+    boost::asio::steady_timer timer_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable idle_;
+    std::size_t             pending_{ 0 };
+    std::deque<Pending>     held_;
+    bool                    resending_{ false };
+    bool                    closed_{ false };
+    ReplicaStatistics       statistics_;
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/Replica.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_REPLICA_HPP
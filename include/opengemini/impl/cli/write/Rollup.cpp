@@ -0,0 +1,365 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/Rollup.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/SeriesKey.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+namespace {
+
+inline Point::Time Now()
+{
+    return std::chrono::time_point_cast<Point::Time::duration>(
+        std::chrono::system_clock::now());
+}
+
+inline bool IsNumeric(const Point::Field& value) noexcept
+{
+    return std::holds_alternative<double>(value) ||
+           std::holds_alternative<int64_t>(value) ||
+           std::holds_alternative<uint64_t>(value);
+}
+
+inline double ToDouble(const Point::Field& value) noexcept
+{
+    return std::visit(
+        [](auto& number) -> double {
+            using T = std::decay_t<decltype(number)>;
+            if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+                return static_cast<double>(number);
+            }
+            else {
+                return 0;
+            }
+        },
+        value);
+}
+
+// Applies the operation to numeric values of the same type in that type, and
+// to values of different types as doubles.
+template<typename OPERATION>
+Point::Field
+Combine(const Point::Field& lhs, const Point::Field& rhs, OPERATION operation)
+{
+    if (lhs.index() != rhs.index()) {
+        return operation(ToDouble(lhs), ToDouble(rhs));
+    }
+    return std::visit(
+        [&rhs, &operation](auto& number) -> Point::Field {
+            using T = std::decay_t<decltype(number)>;
+            if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+                return T(operation(number, std::get<T>(rhs)));
+            }
+            else {
+                return number;
+            }
+        },
+        lhs);
+}
+
+} // namespace
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Aggregate::Merge(const Aggregate& other)
+{
+    count += other.count;
+    if (other.time >= time) {
+        last = other.last;
+        time = other.time;
+    }
+
+    numeric = numeric && other.numeric;
+    if (!numeric) { return; }
+    sum = Combine(sum, other.sum, std::plus<>{});
+    min = Combine(min, other.min, [](auto lhs, auto rhs) {
+        return std::min(lhs, rhs);
+    });
+    max = Combine(max, other.max, [](auto lhs, auto rhs) {
+        return std::max(lhs, rhs);
+    });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Window::Merge(const Window& other)
+{
+    for (auto& [name, aggregate] : other.fields) {
+        auto [field, inserted] = fields.try_emplace(name, aggregate);
+        if (!inserted) { field->second.Merge(aggregate); }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Rollup::Rollup(PrivateConstructor,
+               boost::asio::io_context& ctx,
+               const RollupConfig&      config,
+               std::size_t              shards,
+               Emit                     emit) :
+    TaskSlot(ctx),
+    window_(config.window),
+    aggregates_(config.aggregates),
+    shards_(std::max<std::size_t>(shards, 1)),
+    emit_(std::move(emit)),
+    flushed_(std::numeric_limits<Point::Time::rep>::min())
+{
+    if (window_ <= Point::Time::duration::zero()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Rollup window should be positive");
+    }
+    if (aggregates_.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Rollup aggregates should not be empty");
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Rollup::~Rollup()
+{
+    if (!thread_.joinable()) { return; }
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Add(std::string_view database,
+                 std::string_view retentionPolicy,
+                 Point            point)
+{
+    if ((point.measurement.empty() && point.series.Empty()) ||
+        point.fields.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Point to roll up should have a measurement and "
+                        "fields");
+    }
+
+    if (point.time == Point::Time{}) { point.time = Now(); }
+    const auto start = point.time - point.time.time_since_epoch() % window_;
+    const auto end   = start + window_;
+
+    auto series = point.series.Empty()
+                      ? SeriesKey(point.measurement, point.tags)
+                      : point.series;
+    std::string key;
+    key.reserve(database.size() + retentionPolicy.size() +
+                series.View().size() + 24);
+    key.append(database).push_back('\n');
+    key.append(retentionPolicy).push_back('\n');
+    key.append(series.View()).push_back('\n');
+    key.append(std::to_string(start.time_since_epoch().count()));
+
+    auto&           shard = ShardOfThread();
+    std::lock_guard lock(shard.mutex);
+    if (end.time_since_epoch().count() <= flushed_.load()) {
+        ++late_;
+        return;
+    }
+
+    auto [found, inserted] = shard.windows.try_emplace(std::move(key));
+    auto& window           = found->second;
+    if (inserted) {
+        window.database          = database;
+        window.retentionPolicy   = retentionPolicy;
+        window.point.measurement = std::move(point.measurement);
+        window.point.tags        = std::move(point.tags);
+        window.point.series      = std::move(point.series);
+        window.point.precision   = point.precision;
+        window.point.time        = start;
+        window.end               = end;
+    }
+    for (auto& [name, value] : point.fields) {
+        Aggregate aggregate{
+            value, value, value, value, point.time, 1, IsNumeric(value)
+        };
+        auto [field, added] = window.fields.try_emplace(name, aggregate);
+        if (!added) { field->second.Merge(aggregate); }
+    }
+    ++points_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Flush(Point::Time until)
+{
+    std::lock_guard flushing(flushing_);
+
+    // Points of the windows swept from now on are late, the shards are swept
+    // afterwards so that none of them is missed.
+    const auto cutoff = until.time_since_epoch().count();
+    if (cutoff > flushed_.load()) { flushed_.store(cutoff); }
+
+    std::unordered_map<std::string, Window> ended;
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        for (auto it = shard.windows.begin(); it != shard.windows.end();) {
+            if (it->second.end > until) {
+                ++it;
+                continue;
+            }
+            auto node = shard.windows.extract(it++);
+            if (auto found = ended.find(node.key()); found != ended.end()) {
+                found->second.Merge(node.mapped());
+            }
+            else {
+                ended.insert(std::move(node));
+            }
+        }
+    }
+
+    std::map<std::pair<std::string, std::string>, std::vector<Point>> points;
+    for (auto& [key, window] : ended) {
+        auto target = std::make_pair(window.database, window.retentionPolicy);
+        auto point  = ToPoint(std::move(window));
+        if (!point.fields.empty()) {
+            points[std::move(target)].push_back(std::move(point));
+        }
+    }
+    for (auto& [target, batch] : points) {
+        Write(target.first, target.second, std::move(batch));
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Start()
+{
+    thread_ = std::thread([this] { Run(); });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Stop()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) { thread_.join(); }
+    Flush(Point::Time::max());
+
+    if (ctx_.get_executor().running_in_this_thread()) { return; }
+    std::unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+RollupStatistics Rollup::Statistics() const
+{
+    RollupStatistics statistics;
+    statistics.points = points_.load();
+    statistics.late   = late_.load();
+
+    std::lock_guard lock(mutex_);
+    statistics.written = written_;
+    statistics.failed  = failed_;
+    return statistics;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Run()
+{
+    std::unique_lock lock(mutex_);
+    for (;;) {
+        // Wakes up as the current window ends.
+        const auto left = window_ - Now().time_since_epoch() % window_;
+        if (wake_.wait_for(lock, left, [this] { return stopped_; })) { break; }
+
+        lock.unlock();
+        Flush(Now());
+        lock.lock();
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Rollup::Write(std::string        database,
+                   std::string        retentionPolicy,
+                   std::vector<Point> points)
+{
+    {
+        std::lock_guard lock(mutex_);
+        ++pending_;
+    }
+
+    Handler handler = [self = shared_from_this(),
+                       count = points.size()](std::exception_ptr ex) {
+        std::lock_guard lock(self->mutex_);
+        (ex ? self->failed_ : self->written_) += count;
+        if (--self->pending_ == 0) { self->idle_.notify_all(); }
+    };
+    try {
+        emit_(std::move(database),
+              std::move(retentionPolicy),
+              std::move(points),
+              handler);
+    }
+    catch (...) {
+        handler(std::current_exception());
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Point Rollup::ToPoint(Window&& window) const
+{
+    auto point = std::move(window.point);
+    for (auto& [name, aggregate] : window.fields) {
+        // Fields which are not numeric only have a last value, which is kept
+        // whatever the aggregates configured.
+        if (!aggregate.numeric) {
+            point.fields.emplace(name + "_last", aggregate.last);
+            continue;
+        }
+        for (auto kind : aggregates_) {
+            switch (kind) {
+            case RollupAggregate::Last:
+                point.fields.emplace(name + "_last", aggregate.last);
+                break;
+            case RollupAggregate::Count:
+                point.fields.emplace(name + "_count", aggregate.count);
+                break;
+            case RollupAggregate::Sum:
+                point.fields.emplace(name + "_sum", aggregate.sum);
+                break;
+            case RollupAggregate::Min:
+                point.fields.emplace(name + "_min", aggregate.min);
+                break;
+            case RollupAggregate::Max:
+                point.fields.emplace(name + "_max", aggregate.max);
+                break;
+            }
+        }
+    }
+    return point;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Rollup::Shard& Rollup::ShardOfThread()
+{
+    // Threads are numbered as they first add points, so that each of them
+    // gets a shard of its own as long as there are enough.
+    static std::atomic<std::size_t> threads{ 0 };
+    thread_local const std::size_t  index = threads.fetch_add(1);
+    return shards_[index % shards_.size()];
+}
+
+} // namespace opengemini::impl::cli
@@ -0,0 +1,168 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_ROLLUP_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_ROLLUP_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/Point.hpp"
+#include "opengemini/impl/comm/TaskSlot.hpp"
+
+namespace opengemini::impl::cli {
+
+//
+// Rolls points up per database, retention policy and series over windows
+// aligned on the epoch, and emits one point per series once a window has
+// ended.
+//
+// Points are added to the table of the calling thread, so that threads adding
+// points do not contend with each other, and the tables are merged when the
+// windows are emitted. Points of a window already emitted are dropped.
+//
+// Windows are emitted as they end on a thread of the rollup rather than on the
+// context, so that their writes wait for room in a blocking write budget, as
+// those of the application do.
+//
+class Rollup : public TaskSlot, public std::enable_shared_from_this<Rollup> {
+private:
+    struct PrivateConstructor {
+        constexpr PrivateConstructor() = default;
+    };
+
+public:
+    using Handler = std::function<void(std::exception_ptr)>;
+    // Writes the points, invoking the handler once they are.
+    using Emit = std::function<void(std::string        database,
+                                    std::string        retentionPolicy,
+                                    std::vector<Point> points,
+                                    Handler            handler)>;
+
+    template<typename... ARGS>
+    static std::shared_ptr<Rollup> Construct(ARGS&&... args)
+    {
+        return std::make_shared<Rollup>(PrivateConstructor{},
+                                        std::forward<ARGS>(args)...);
+    }
+
+    Rollup(PrivateConstructor,
+           boost::asio::io_context& ctx,
+           const RollupConfig&      config,
+           std::size_t              shards,
+           Emit                     emit);
+
+    ~Rollup();
+
+    // Points without time are rolled up into the window they are added in.
+    void Add(std::string_view database,
+             std::string_view retentionPolicy,
+             Point            point);
+
+    // Emits the windows which ended at or before the time.
+    void Flush(Point::Time until);
+
+    // Emits the windows as they end, on the thread of the rollup.
+    void Start();
+    // Emits every window left, ended or not, and waits for them to be written.
+    // Called on a thread of the context, which the writes need to complete,
+    // it returns once they are emitted.
+    void Stop();
+
+    RollupStatistics Statistics() const;
+
+private:
+    struct Aggregate {
+        Point::Field sum;
+        Point::Field min;
+        Point::Field max;
+        Point::Field last;
+        Point::Time  time;
+        std::int64_t count{ 0 };
+        bool         numeric{ true };
+
+        void Merge(const Aggregate& other);
+    };
+
+    struct Window {
+        std::string                      database;
+        std::string                      retentionPolicy;
+        // Holds the series of the window and its start, without fields.
+        Point                            point;
+        Point::Time                      end;
+        std::map<std::string, Aggregate> fields;
+
+        void Merge(const Window& other);
+    };
+
+    struct alignas(64) Shard {
+        std::mutex                              mutex;
+        std::unordered_map<std::string, Window> windows;
+    };
+
+private:
+    void Run();
+    void Write(std::string        database,
+               std::string        retentionPolicy,
+               std::vector<Point> points);
+    // The point holds no field if none of them is kept.
+    Point ToPoint(Window&& window) const;
+
+    Shard& ShardOfThread();
+
+private:
+    const Point::Time::duration        window_;
+    const std::vector<RollupAggregate> aggregates_;
+    std::vector<Shard>                 shards_;
+    const Emit                         emit_;
+
+    // The end of the windows emitted so far, in nanoseconds since the epoch.
+    std::atomic<Point::Time::rep> flushed_;
+    std::atomic<std::size_t>      points_{ 0 };
+    std::atomic<std::size_t>      late_{ 0 };
+
+    // Serializes the flushes, so that windows merged from the shards are
+    // emitted as a whole.
+    std::mutex flushing_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable idle_;
+    std::size_t             pending_{ 0 };
+    std::size_t             written_{ 0 };
+    std::size_t             failed_{ 0 };
+
+    std::thread             thread_;
+    std::condition_variable wake_;
+    bool                    stopped_{ false };
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/Rollup.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_ROLLUP_HPP
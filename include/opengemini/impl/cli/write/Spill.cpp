@@ -0,0 +1,463 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/Spill.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <boost/crc.hpp>
+#include <fmt/format.h>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+OPENGEMINI_INLINE_SPECIFIER
+Spill::Spill(PrivateConstructor,
+             boost::asio::io_context&           ctx,
+             const SpillConfig&                 config,
+             std::shared_ptr<lb::LoadBalancer>  lb,
+             std::shared_ptr<http::IHttpClient> http,
+             std::chrono::milliseconds          retryInterval) :
+    TaskSlot(ctx),
+    directory_(config.directory),
+    maxBytes_(config.maxBytes),
+    segmentSize_(config.segmentSize),
+    replayRate_(config.replayRate),
+    retryInterval_(retryInterval),
+    lb_(std::move(lb)),
+    http_(std::move(http)),
+    timer_(ctx_)
+{
+    if (directory_.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Spill directory should not be empty");
+    }
+    if (segmentSize_ <= DATA_OFFSET || maxBytes_ < segmentSize_) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Spill quota should hold at least one segment");
+    }
+
+    try {
+        std::filesystem::create_directories(directory_);
+        Recover();
+    }
+    catch (const std::filesystem::filesystem_error& ex) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        fmt::format("Unusable spill directory: {}", ex.what()));
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Spill::Append(std::string_view                    database,
+                   std::string_view                    retentionPolicy,
+                   Precision                           precision,
+                   boost::span<const std::string_view> content)
+{
+    constexpr auto maxLength = std::numeric_limits<std::uint16_t>::max();
+    if (database.size() > maxLength || retentionPolicy.size() > maxLength) {
+        return false;
+    }
+
+    std::size_t size = RECORD_FIELDS + database.size() + retentionPolicy.size();
+    for (auto& part : content) { size += part.size(); }
+
+    std::lock_guard lock(mutex_);
+    auto            segment = Writable(RECORD_PREFIX + size);
+    if (!segment) { return false; }
+
+    auto  offset = segment->header.committed;
+    auto* record = Address(*segment) + offset;
+    auto* out    = record + RECORD_PREFIX;
+    auto  put    = [&out](const void* data, std::size_t length) {
+        std::memcpy(out, data, length);
+        out += length;
+    };
+
+    auto          precisionValue = static_cast<std::uint8_t>(precision);
+    std::uint16_t databaseLength = database.size();
+    std::uint16_t rpLength       = retentionPolicy.size();
+    put(&precisionValue, sizeof(precisionValue));
+    put(&databaseLength, sizeof(databaseLength));
+    put(&rpLength, sizeof(rpLength));
+    put(database.data(), database.size());
+    put(retentionPolicy.data(), retentionPolicy.size());
+    for (auto& part : content) { put(part.data(), part.size()); }
+
+    boost::crc_32_type checksum;
+    checksum.process_bytes(record + RECORD_PREFIX, size);
+    std::uint32_t recordSize  = size;
+    std::uint32_t recordCheck = checksum.checksum();
+    std::memcpy(record, &recordSize, sizeof(recordSize));
+    std::memcpy(record + sizeof(recordSize), &recordCheck, sizeof(recordCheck));
+
+    // The record is made durable before the header which covers it, and the
+    // write is only spilled once both are.
+    if (!Flush(*segment, offset, RECORD_PREFIX + size)) { return false; }
+    segment->header.committed += RECORD_PREFIX + size;
+    if (!Commit(*segment)) {
+        // The header may still reach the disk later on, the previous one is
+        // committed again so that the failed write is not replayed.
+        segment->header.committed = offset;
+        Commit(*segment);
+        return false;
+    }
+    return true;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::StartReplay()
+{
+    boost::asio::spawn(
+        ctx_,
+        [self = shared_from_this(), this](auto yield) { Replay(yield); },
+        boost::asio::detached);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::StopReplay()
+{
+    stopped_.store(true);
+    timer_.cancel();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t Spill::Pending() const
+{
+    std::lock_guard lock(mutex_);
+    std::size_t     pending{ 0 };
+    for (auto& segment : segments_) {
+        pending += segment->header.committed - segment->header.replayed;
+    }
+    return pending;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::Replay(boost::asio::yield_context yield)
+{
+    while (!stopped_.load()) {
+        timer_.expires_after(retryInterval_);
+        timer_.async_wait(yield);
+
+        for (auto record = Front(); record && !stopped_.load();
+             record      = Front()) {
+            if (!Send(*record, yield)) { break; }
+            Pop(record->size);
+
+            if (replayRate_ == 0) { continue; }
+            timer_.expires_after(std::chrono::microseconds(
+                record->size * 1'000'000 / replayRate_));
+            timer_.async_wait(yield);
+        }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Spill::Send(Record& record, boost::asio::yield_context yield)
+{
+    const Endpoint* endpoint{ nullptr };
+    try {
+        endpoint = &lb_->PickAvailableServer();
+    }
+    catch (const Exception&) {
+        return false;
+    }
+
+    Error error;
+    auto  response = http_->Post(*endpoint,
+                                WriteTarget(record.database,
+                                            record.retentionPolicy,
+                                            record.precision),
+                                std::move(record.body),
+                                yield,
+                                error);
+    if (error) { return false; }
+
+    // Records refused by the server would be refused again, so they are
+    // dropped rather than blocking the ones behind.
+    auto status = response.result();
+    return status == http::Status::no_content ||
+           boost::beast::http::to_status_class(status) ==
+               boost::beast::http::status_class::client_error;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::optional<Spill::Record> Spill::Front()
+{
+    std::lock_guard lock(mutex_);
+    while (!segments_.empty()) {
+        auto& segment = *segments_.front();
+        auto& header  = segment.header;
+        if (header.replayed == header.committed) {
+            if (!segment.recovered && segments_.size() == 1) { break; }
+            Remove(segment);
+            segments_.pop_front();
+            continue;
+        }
+
+        if (!segment.region.get_address()) {
+            try {
+                Map(segment);
+            }
+            catch (const std::exception&) {
+                Remove(segment);
+                segments_.pop_front();
+                continue;
+            }
+        }
+
+        if (auto record = ReadRecord(segment)) { return record; }
+        header.replayed = header.committed;
+        Commit(segment);
+    }
+    return std::nullopt;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::Pop(std::size_t size)
+{
+    std::lock_guard lock(mutex_);
+    auto&           segment = *segments_.front();
+    segment.header.replayed += size;
+    Commit(segment);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Spill::Segment* Spill::Writable(std::size_t size)
+{
+    if (size > segmentSize_ - DATA_OFFSET) { return nullptr; }
+
+    if (!segments_.empty()) {
+        auto& back = *segments_.back();
+        if (!back.recovered && back.header.committed + size <= segmentSize_) {
+            return &back;
+        }
+    }
+    if ((segments_.size() + 1) * segmentSize_ > maxBytes_) { return nullptr; }
+
+    auto segment              = std::make_unique<Segment>();
+    segment->path             = PathOf(nextSequence_);
+    segment->header.sequence  = nextSequence_;
+    segment->header.committed = DATA_OFFSET;
+    segment->header.replayed  = DATA_OFFSET;
+    try {
+        std::ofstream(segment->path, std::ios::binary | std::ios::trunc);
+        std::filesystem::resize_file(segment->path, segmentSize_);
+        Map(*segment);
+    }
+    catch (const std::exception&) {
+        Remove(*segment);
+        return nullptr;
+    }
+    if (!Commit(*segment)) {
+        Remove(*segment);
+        return nullptr;
+    }
+
+    ++nextSequence_;
+    return segments_.emplace_back(std::move(segment)).get();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::Recover()
+{
+    for (auto& entry : std::filesystem::directory_iterator(directory_)) {
+        if (!entry.is_regular_file() || entry.path().extension() != EXTENSION) {
+            continue;
+        }
+
+        auto header = ReadHeader(entry.path());
+        if (!header || header->replayed == header->committed) {
+            std::filesystem::remove(entry.path());
+            continue;
+        }
+
+        auto segment       = std::make_unique<Segment>();
+        segment->path      = entry.path();
+        segment->header    = *header;
+        segment->recovered = true;
+        segments_.push_back(std::move(segment));
+        nextSequence_ = std::max(nextSequence_, header->sequence + 1);
+    }
+
+    std::sort(segments_.begin(),
+              segments_.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs->header.sequence < rhs->header.sequence;
+              });
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::filesystem::path Spill::PathOf(std::uint64_t sequence) const
+{
+    return directory_ /
+           fmt::format("{:016x}{}", sequence, std::string_view(EXTENSION));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::Map(Segment& segment)
+{
+    namespace ipc = boost::interprocess;
+
+    segment.file   = ipc::file_mapping(segment.path.string().c_str(),
+                                     ipc::read_write);
+    segment.region = ipc::mapped_region(segment.file, ipc::read_write);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::Remove(Segment& segment) noexcept
+{
+    segment.region = boost::interprocess::mapped_region();
+    segment.file   = boost::interprocess::file_mapping();
+
+    std::error_code error;
+    std::filesystem::remove(segment.path, error);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+char* Spill::Address(Segment& segment) noexcept
+{
+    return static_cast<char*>(segment.region.get_address());
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Spill::Commit(Segment& segment)
+{
+    auto& header = segment.header;
+    ++header.generation;
+
+    auto offset = header.generation % 2 * SLOT_SIZE;
+    EncodeHeader(Address(segment) + offset, header);
+    return Flush(segment, offset, SLOT_SIZE);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool Spill::Flush(Segment& segment, std::size_t offset, std::size_t size)
+{
+    // Synchronizing takes an address aligned on a page, which the region
+    // leaves to the caller.
+    const auto misaligned =
+        offset % boost::interprocess::mapped_region::get_page_size();
+    return segment.region.flush(offset - misaligned, size + misaligned, false);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::optional<Spill::Record> Spill::ReadRecord(Segment& segment)
+{
+    const auto& header = segment.header;
+    if (header.committed - header.replayed < RECORD_PREFIX + RECORD_FIELDS) {
+        return std::nullopt;
+    }
+
+    const auto*   record = Address(segment) + header.replayed;
+    std::uint32_t size{ 0 };
+    std::uint32_t check{ 0 };
+    std::memcpy(&size, record, sizeof(size));
+    std::memcpy(&check, record + sizeof(size), sizeof(check));
+    if (size < RECORD_FIELDS ||
+        size > header.committed - header.replayed - RECORD_PREFIX) {
+        return std::nullopt;
+    }
+
+    const auto*        in = record + RECORD_PREFIX;
+    boost::crc_32_type checksum;
+    checksum.process_bytes(in, size);
+    if (checksum.checksum() != check) { return std::nullopt; }
+
+    std::uint8_t  precision{ 0 };
+    std::uint16_t databaseLength{ 0 };
+    std::uint16_t rpLength{ 0 };
+    std::memcpy(&precision, in, sizeof(precision));
+    std::memcpy(&databaseLength, in + 1, sizeof(databaseLength));
+    std::memcpy(&rpLength, in + 3, sizeof(rpLength));
+    if (precision > static_cast<std::uint8_t>(Precision::Hour) ||
+        RECORD_FIELDS + databaseLength + rpLength > size) {
+        return std::nullopt;
+    }
+
+    in += RECORD_FIELDS;
+    Record result;
+    result.database.assign(in, databaseLength);
+    result.retentionPolicy.assign(in + databaseLength, rpLength);
+    result.precision = static_cast<Precision>(precision);
+    result.body.assign(in + databaseLength + rpLength,
+                       size - RECORD_FIELDS - databaseLength - rpLength);
+    result.size = RECORD_PREFIX + size;
+    return result;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void Spill::EncodeHeader(char* slot, const Header& header) noexcept
+{
+    const std::uint64_t fields[] = { header.generation,
+                                     header.sequence,
+                                     header.committed,
+                                     header.replayed };
+    std::memcpy(slot, MAGIC.data(), MAGIC.size());
+    std::memcpy(slot + MAGIC.size(), fields, sizeof(fields));
+
+    boost::crc_32_type checksum;
+    checksum.process_bytes(slot, MAGIC.size() + sizeof(fields));
+    std::uint32_t check = checksum.checksum();
+    std::memcpy(slot + MAGIC.size() + sizeof(fields), &check, sizeof(check));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::optional<Spill::Header> Spill::DecodeHeader(const char* slot) noexcept
+{
+    std::uint64_t fields[4];
+    std::uint32_t check{ 0 };
+    std::memcpy(fields, slot + MAGIC.size(), sizeof(fields));
+    std::memcpy(&check, slot + MAGIC.size() + sizeof(fields), sizeof(check));
+
+    boost::crc_32_type checksum;
+    checksum.process_bytes(slot, MAGIC.size() + sizeof(fields));
+    if (std::string_view(slot, MAGIC.size()) != MAGIC ||
+        checksum.checksum() != check) {
+        return std::nullopt;
+    }
+    return Header{ fields[0], fields[1], fields[2], fields[3] };
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::optional<Spill::Header>
+Spill::ReadHeader(const std::filesystem::path& path)
+{
+    char          slots[2 * SLOT_SIZE];
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(slots, sizeof(slots))) { return std::nullopt; }
+
+    std::optional<Header> latest;
+    for (const auto* slot : { slots, slots + SLOT_SIZE }) {
+        auto header = DecodeHeader(slot);
+        if (header && (!latest || header->generation > latest->generation)) {
+            latest = header;
+        }
+    }
+
+    std::error_code error;
+    auto            size = std::filesystem::file_size(path, error);
+    if (!latest || error || latest->replayed < DATA_OFFSET ||
+        latest->replayed > latest->committed || latest->committed > size) {
+        return std::nullopt;
+    }
+    return latest;
+}
+
+} // namespace opengemini::impl::cli
@@ -0,0 +1,184 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_SPILL_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_SPILL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/core/span.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/impl/comm/TaskSlot.hpp"
+#include "opengemini/impl/http/IHttpClient.hpp"
+#include "opengemini/impl/lb/LoadBalancer.hpp"
+
+namespace opengemini::impl::cli {
+
+//
+// Keeps the writes made while no server is available in memory-mapped segment
+// files, and replays them in order once servers are back.
+//
+// Each segment file starts with two header slots which are written in turn,
+// so that a torn header write leaves the previous one intact. A header tells
+// up to where records have been appended and replayed, recovering the spill
+// at startup only takes reading the headers. Records carry their own
+// checksums, which are verified when they are replayed.
+//
+class Spill : public TaskSlot, public std::enable_shared_from_this<Spill> {
+private:
+    struct PrivateConstructor {
+        constexpr PrivateConstructor() = default;
+    };
+
+public:
+    template<typename... ARGS>
+    static std::shared_ptr<Spill> Construct(ARGS&&... args)
+    {
+        return std::make_shared<Spill>(PrivateConstructor{},
+                                       std::forward<ARGS>(args)...);
+    }
+
+    Spill(PrivateConstructor,
+          boost::asio::io_context&           ctx,
+          const SpillConfig&                 config,
+          std::shared_ptr<lb::LoadBalancer>  lb,
+          std::shared_ptr<http::IHttpClient> http,
+          std::chrono::milliseconds retryInterval = std::chrono::seconds(1));
+
+    ~Spill() = default;
+
+    // Appends a write whose body is the concatenation of the parts. Returns
+    // false if there is no room left for it, or if it could not be made
+    // durable. The record and its header are synchronously flushed to the
+    // disk under the lock, on the calling thread of the context, stalling the
+    // other writes on that thread and those spilled meanwhile. Writes are only
+    // spilled while no server is available, when they would not go anywhere
+    // faster.
+    bool Append(std::string_view                    database,
+                std::string_view                    retentionPolicy,
+                Precision                           precision,
+                boost::span<const std::string_view> content);
+
+    void StartReplay();
+    void StopReplay();
+
+    // The number of bytes appended but not replayed yet.
+    std::size_t Pending() const;
+
+private:
+    struct Header {
+        std::uint64_t generation{ 0 };
+        std::uint64_t sequence{ 0 };
+        std::uint64_t committed{ 0 };
+        std::uint64_t replayed{ 0 };
+    };
+
+    struct Segment {
+        std::filesystem::path              path;
+        Header                             header;
+        // Segments recovered at startup are only replayed, never appended to.
+        bool                               recovered{ false };
+        boost::interprocess::file_mapping  file;
+        boost::interprocess::mapped_region region;
+    };
+
+    struct Record {
+        std::string database;
+        std::string retentionPolicy;
+        Precision   precision;
+        std::string body;
+        std::size_t size;
+    };
+
+private:
+    void Replay(boost::asio::yield_context yield);
+    // Sends the record, returns false if it should be tried again later.
+    bool Send(Record& record, boost::asio::yield_context yield);
+
+    // Returns the first record not replayed yet, if any. Records which fail
+    // the checksum are skipped along with the rest of their segment.
+    std::optional<Record> Front();
+    void                  Pop(std::size_t size);
+
+    // Returns the segment to append a record of the size to, if there is room.
+    Segment*              Writable(std::size_t size);
+    void                  Recover();
+    std::filesystem::path PathOf(std::uint64_t sequence) const;
+
+    static void  Map(Segment& segment);
+    static void  Remove(Segment& segment) noexcept;
+    static char* Address(Segment& segment) noexcept;
+    // Writes the header to the slot not holding the latest one. Returns false
+    // if it could not be made durable, which replay progress may ignore: the
+    // records are only replayed again after a restart.
+    static bool  Commit(Segment& segment);
+    // Synchronously flushes the range of the segment to the disk.
+    static bool  Flush(Segment& segment, std::size_t offset, std::size_t size);
+
+    static std::optional<Record> ReadRecord(Segment& segment);
+
+    static void EncodeHeader(char* slot, const Header& header) noexcept;
+    static std::optional<Header> DecodeHeader(const char* slot) noexcept;
+    static std::optional<Header> ReadHeader(const std::filesystem::path& path);
+
+private:
+    static constexpr std::string_view MAGIC{ "OGSPILL1" };
+    static constexpr std::string_view EXTENSION{ ".spill" };
+    // Two header slots, followed by records from the data offset.
+    static constexpr std::size_t SLOT_SIZE{ 64 };
+    static constexpr std::size_t DATA_OFFSET{ 128 };
+    // A record is its size and checksum, followed by the checksummed part: the
+    // precision, the lengths of the database and retention policy, those two,
+    // and the body.
+    static constexpr std::size_t RECORD_PREFIX{ 8 };
+    static constexpr std::size_t RECORD_FIELDS{ 5 };
+
+private:
+    const std::filesystem::path     directory_;
+    const std::size_t               maxBytes_;
+    const std::size_t               segmentSize_;
+    const std::size_t               replayRate_;
+    const std::chrono::milliseconds retryInterval_;
+
+    std::shared_ptr<lb::LoadBalancer>  lb_;
+    std::shared_ptr<http::IHttpClient> http_;
+
+    mutable std::mutex                   mutex_;
+    std::deque<std::unique_ptr<Segment>> segments_;
+    std::uint64_t                        nextSequence_{ 0 };
+
+    boost::asio::steady_timer timer_;
+    std::atomic<bool>         stopped_{ false };
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/Spill.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_SPILL_HPP
@@ -0,0 +1,109 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/Write.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include <boost/url.hpp>
+#include <fmt/format.h>
+
+#include "opengemini/impl/comm/UrlTargets.hpp"
+#include "opengemini/impl/enc/LineValidator.hpp"
+
+namespace opengemini::impl::cli {
+
+OPENGEMINI_INLINE_SPECIFIER
+EncodedContent PrepareRawLines(BufferPool& buffers, RawLines lines)
+{
+    auto content = [&buffers, &lines] {
+        if (auto owned = std::get_if<std::string>(&lines.content)) {
+            return BufferPool::Lease{ buffers, std::move(*owned) };
+        }
+        auto lease = buffers.Acquire();
+        if (auto& shared = std::get<1>(lines.content)) {
+            lease->assign(*shared);
+        }
+        return lease;
+    }();
+
+    EncodedContent prepared;
+    auto&          part = prepared.parts.emplace_back(
+        EncodedContent::Part{ lines.precision, std::move(content) });
+    if (lines.validate) {
+        try {
+            enc::ValidateLines(*part.content);
+        }
+        catch (...) {
+            prepared.error = std::current_exception();
+        }
+    }
+    return prepared;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::string WriteTarget(std::string_view database,
+                        std::string_view retentionPolicy,
+                        Precision        precision)
+{
+    boost::url target(url::WRITE);
+    target.set_query(fmt::format("db={}&rp={}&precision={}",
+                                 database,
+                                 retentionPolicy,
+                                 ToString(precision)));
+    return std::string(target.buffer());
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool IsRetryable(const Error& error)
+{
+    // Errors of the client itself are not going away, unlike those of the
+    // network, and no available server is left to the spill and health check.
+    const auto& category = error.Code().category();
+    return category != errc::impl::LogicCategory::Instance() &&
+           category != errc::impl::ServerCategory::Instance() &&
+           category != errc::impl::RuntimeCategory::Instance();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool IsRetryable(http::Status status)
+{
+    using boost::beast::http::status_class;
+    return status == http::Status::request_timeout ||
+           status == http::Status::too_many_requests ||
+           (boost::beast::http::to_status_class(status) ==
+                status_class::server_error &&
+            status != http::Status::not_implemented);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::chrono::milliseconds RetryBackoff(const RetryConfig& retry,
+                                       std::size_t        attempt)
+{
+    auto backoff = retry.initialBackoff;
+    for (std::size_t idx = 1; idx < attempt && backoff < retry.maxBackoff;
+         ++idx) {
+        backoff *= 2;
+    }
+    backoff = std::min(backoff, retry.maxBackoff);
+
+    thread_local std::mt19937 engine{ std::random_device{}() };
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+        0,
+        backoff.count() / 2);
+    return backoff - std::chrono::milliseconds(jitter(engine));
+}
+
+} // namespace opengemini::impl::cli
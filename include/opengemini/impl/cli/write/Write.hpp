@@ -15,22 +15,269 @@
 #ifndef OPENGEMINI_IMPL_CLI_WRITE_WRITE_HPP
 #define OPENGEMINI_IMPL_CLI_WRITE_WRITE_HPP
 
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <boost/core/span.hpp>
+
+#include "opengemini/ClientConfig.hpp"
+#include "opengemini/Error.hpp"
+#include "opengemini/Exception.hpp"
+#include "opengemini/PointView.hpp"
+#include "opengemini/Precision.hpp"
+#include "opengemini/RawLines.hpp"
 #include "opengemini/impl/cli/Functor.hpp"
+#include "opengemini/impl/cli/write/BatchController.hpp"
+#include "opengemini/impl/comm/BufferPool.hpp"
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
 #include "opengemini/impl/util/Preprocessor.hpp"
 
 namespace opengemini::impl::cli {
 
+class Replica;
+class Spill;
+
+template<typename POINT_TYPE>
+struct IsPointVector : std::false_type { };
+
+template<typename T>
+struct IsPointVector<std::vector<T>> : std::true_type { };
+
+template<typename POINT_TYPE>
+inline constexpr bool IsPointVector_v = IsPointVector<POINT_TYPE>::value;
+
+// Points which do not own their data, and thus have to be encoded before the
+// write is initiated.
+template<typename POINT_TYPE>
+inline constexpr bool IsPointView_v =
+    std::is_same_v<POINT_TYPE, PointView> ||
+    std::is_same_v<POINT_TYPE, std::vector<PointView>>;
+
+// Content ready to be sent, either encoded eagerly or provided raw by the
+// caller, in one part per precision of its timestamps. Any error is kept to be
+// reported through the completion token like every other failure of the write.
+struct EncodedContent {
+    struct Part {
+        Precision precision;
+        // Mutable since the buffer is lent to the HTTP client by the const
+        // functor.
+        mutable BufferPool::Lease content;
+    };
+
+    std::vector<Part>  parts;
+    std::exception_ptr error;
+};
+
+// Content encoded once, in a buffer shared between the clusters it is written
+// to, which never modify it.
+struct SharedContent {
+    Precision                                       precision;
+    std::shared_ptr<const std::vector<std::string>> parts;
+};
+
+template<typename POINT_TYPE>
+EncodedContent EncodeEagerly(BufferPool& buffers, const POINT_TYPE& point);
+
+// Number of points written, which counts towards the size of a batch. Raw
+// lines are counted by their line breaks.
+template<typename POINT_TYPE>
+std::size_t CountPoints(const POINT_TYPE& point);
+
+// Approximate number of bytes held by the points until they are written, which
+// are charged to the write budget. Encoded content is counted exactly.
+template<typename POINT_TYPE>
+std::size_t EstimateSize(const POINT_TYPE& point);
+
+// Invokes the function with each precision present among the points, in the
+// order of the enumeration, since every request carries a single one.
+template<typename POINT_TYPE, typename FUNCTION>
+void ForEachPrecision(const POINT_TYPE& point, const FUNCTION& func);
+
+// Encodes the points of the given precision, i.e. all of them unless they are
+// a vector mixing precisions. Within a vector, the conversion of timestamps is
+// thus dispatched once rather than for every point.
+template<typename POINT_TYPE>
+void EncodeWithPrecision(std::string&      content,
+                         const POINT_TYPE& point,
+                         Precision         precision);
+
+// Splits the points into chunks which are encoded in parallel on the threads
+// running the coroutine, each into its own part appended in order. The points
+// are either a span or enc::OrderedPoints.
+template<typename POINTS>
+void EncodeInParallel(std::vector<BufferPool::Lease>& parts,
+                      const POINTS&                   points,
+                      Precision                       precision,
+                      std::size_t                     chunks,
+                      BufferPool&                     buffers,
+                      boost::asio::yield_context      yield);
+
+// Hands owned content over to the pool, so that its storage is reused by later
+// writes, or copies shared content into a pooled buffer.
+EncodedContent PrepareRawLines(BufferPool& buffers, RawLines lines);
+
+std::string WriteTarget(std::string_view database,
+                        std::string_view retentionPolicy,
+                        Precision        precision);
+
+// Whether a write which failed this way may succeed if sent again.
+bool IsRetryable(const Error& error);
+bool IsRetryable(http::Status status);
+
+// The backoff before the retry following the attempt, with equal jitter.
+std::chrono::milliseconds RetryBackoff(const RetryConfig& retry,
+                                       std::size_t        attempt);
+
+// Settings of the client which apply to every write.
+struct WriteOptions {
+    std::size_t parallelEncodingThreshold;
+    std::size_t concurrency;
+    std::size_t chunkSize;
+    bool        sortBySeries;
+    // Writes are tried once unless set.
+    std::optional<RetryConfig> retry;
+    // Whether writes rejected as a whole are split to find the rejected lines.
+    bool bisect{ false };
+    // Content of at least twice this many lines is split across the available
+    // servers, unless zero.
+    std::size_t fanOutThreshold{ 0 };
+    // Where writes go while no server is available, if anywhere.
+    Spill* spill{ nullptr };
+    // Told how every request went, so that batching adapts to it, if set.
+    BatchController* controller{ nullptr };
+    // Clusters every write is sent to as well, in the background.
+    std::vector<Replica*> replicas{};
+};
+
+// Encodes the points of one precision chunk by chunk while they are sent.
+template<typename POINTS>
+class PointSource : public http::BodySource {
+public:
+    PointSource(const POINTS& points,
+                Precision     precision,
+                std::size_t   chunkSize) :
+        points_(points),
+        precision_(precision),
+        chunkSize_(chunkSize)
+    { }
+
+    void Rewind() override { next_ = 0; }
+
+    void Next(std::string& chunk) override
+    {
+        chunk.clear();
+        next_ += enc::LineProtocolEncoder{}.EncodeSome(chunk,
+                                                       points_.subspan(next_),
+                                                       precision_,
+                                                       chunkSize_);
+    }
+
+private:
+    POINTS      points_;
+    Precision   precision_;
+    std::size_t chunkSize_;
+    std::size_t next_{ 0 };
+};
+
 template<typename POINT_TYPE>
 struct RunWrite : public Functor {
     void operator()(boost::asio::yield_context yield) const;
 
+    template<typename POINTS>
+    void WritePoints(const POINTS&              points,
+                     boost::asio::yield_context yield) const;
+    template<typename POINTS>
+    void Encode(std::vector<BufferPool::Lease>& content,
+                const POINTS&                   points,
+                Precision                       precision,
+                boost::asio::yield_context      yield) const;
+    void Send(std::vector<BufferPool::Lease>& content,
+              Precision                       precision,
+              boost::asio::yield_context      yield) const;
+    void Send(std::string&               content,
+              Precision                  precision,
+              boost::asio::yield_context yield) const;
+    void Send(const std::shared_ptr<const std::vector<std::string>>& content,
+              Precision                                              precision,
+              boost::asio::yield_context yield) const;
+    template<typename POINTS>
+    void Stream(const POINTS&              points,
+                Precision                  precision,
+                boost::asio::yield_context yield) const;
+
+    // Sends the lines of the content in parts to as many servers in parallel,
+    // failing with the errors of every failed part, or returns false if it is
+    // to be sent as a whole instead.
+    bool FanOut(boost::span<const std::string_view> content,
+                Precision                           precision,
+                boost::asio::yield_context          yield) const;
+    // The number of parts the lines are split into, less than two if none.
+    std::size_t FanOutParts(std::size_t lines) const;
+    // Moves the content into a buffer shared with the replicas which have room
+    // for it, and hands it over to them. Returns the buffer, to be sent from
+    // instead of the content, or null if no replica took it, in which case the
+    // content is left as it is.
+    std::shared_ptr<const std::vector<std::string>>
+    Replicate(boost::span<std::string* const> content,
+              Precision                       precision) const;
+
+    // Posts the content with the post function to an available server, or
+    // spills it with the spill function if there is none, in which case no
+    // response is returned. Failed attempts are retried on the next available
+    // server after a backoff, if allowed.
+    template<typename POST, typename SPILL>
+    std::optional<http::Response>
+    Deliver(const POST&                post,
+            const SPILL&               spill,
+            boost::asio::yield_context yield) const;
+    void Backoff(std::size_t attempt, boost::asio::yield_context yield) const;
+    // Posts the content to the server with the post function, telling the
+    // controller how long it took and whether the server seemed overloaded.
+    template<typename POST>
+    http::Response Request(const POST& post, const Endpoint& endpoint) const;
+
+    // Picks an available server, or returns nullptr if there is none but the
+    // content may be spilled instead.
+    const Endpoint* PickServer() const;
+    void SpillContent(boost::span<const std::string_view> content,
+                      Precision                           precision) const;
+
+    // Checks the response to the content, which is bisected if rejected as a
+    // whole and allowed to.
+    void Settle(const http::Response&               response,
+                boost::span<const std::string_view> content,
+                Precision                           precision,
+                boost::asio::yield_context          yield) const;
+    // Sends each half of the lines rejected together on its own, in parallel,
+    // and keeps bisecting the rejected ones down to single lines.
+    void Bisect(boost::span<const std::string_view> lines,
+                Precision                           precision,
+                std::vector<RejectedPoint>&         rejected,
+                std::mutex&                         mutex,
+                boost::asio::yield_context          yield) const;
+
+    std::string Target(Precision precision) const;
+    void Check(const http::Response& response) const;
+
+    BufferPool&         buffers_;
+    const WriteOptions& options_;
     std::string db_;
     std::string rp_;
     POINT_TYPE  point_;
+    // Lines rejected by the server so far, reported once the write is done.
+    mutable std::vector<RejectedPoint> rejected_{};
 };
 
 } // namespace opengemini::impl::cli
 
 #include "opengemini/impl/cli/write/Write.tpp"
 
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/Write.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
 #endif // !OPENGEMINI_IMPL_CLI_WRITE_WRITE_HPP
@@ -14,14 +14,210 @@
 
 #include "opengemini/impl/cli/write/Write.hpp"
 
-#include <boost/url.hpp>
+#include <algorithm>
+#include <iterator>
+
+#include <boost/core/span.hpp>
 
 #include "opengemini/Exception.hpp"
-#include "opengemini/impl/comm/UrlTargets.hpp"
+#include "opengemini/impl/cli/write/Replica.hpp"
+#include "opengemini/impl/cli/write/Spill.hpp"
+#include "opengemini/impl/comm/Parallel.hpp"
 #include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+#include "opengemini/impl/enc/LineValidator.hpp"
 
 namespace opengemini::impl::cli {
 
+template<typename POINT_TYPE>
+EncodedContent EncodeEagerly(BufferPool& buffers, const POINT_TYPE& point)
+{
+    EncodedContent encoded;
+    try {
+        ForEachPrecision(point, [&](Precision precision) {
+            auto& part = encoded.parts.emplace_back(
+                EncodedContent::Part{ precision, buffers.Acquire() });
+            EncodeWithPrecision(*part.content, point, precision);
+        });
+    }
+    catch (...) {
+        encoded.error = std::current_exception();
+    }
+    return encoded;
+}
+
+template<typename POINT_TYPE>
+std::size_t CountPoints(const POINT_TYPE& point)
+{
+    if constexpr (IsPointVector_v<POINT_TYPE>) { return point.size(); }
+    else if constexpr (std::is_same_v<POINT_TYPE, PointBatch>) {
+        // Rows without times are counted by the first column, as encoded.
+        if (!point.times.empty() || point.fields.empty()) {
+            return point.times.size();
+        }
+        return std::visit([](const auto& column) { return column.size(); },
+                          point.fields.begin()->second);
+    }
+    else if constexpr (std::is_same_v<POINT_TYPE, RawLines>) {
+        std::string_view content;
+        if (auto owned = std::get_if<std::string>(&point.content)) {
+            content = *owned;
+        }
+        else if (auto& shared = std::get<1>(point.content)) {
+            content = *shared;
+        }
+        auto lines = static_cast<std::size_t>(
+            std::count(content.begin(), content.end(), '\n'));
+        return content.empty() || content.back() == '\n' ? lines : lines + 1;
+    }
+    else {
+        return 1;
+    }
+}
+
+template<typename POINT_TYPE>
+std::size_t EstimateSize(const POINT_TYPE& point)
+{
+    if constexpr (std::is_same_v<POINT_TYPE, EncodedContent>) {
+        std::size_t size{ 0 };
+        for (auto& part : point.parts) { size += part.content->size(); }
+        return size;
+    }
+
+    auto size = sizeof(POINT_TYPE);
+    if constexpr (IsPointVector_v<POINT_TYPE>) {
+        for (auto& element : point) { size += EstimateSize(element); }
+    }
+    else if constexpr (std::is_same_v<POINT_TYPE, Point> ||
+                       std::is_same_v<POINT_TYPE, FlatPoint>) {
+        size += point.measurement.size();
+        for (auto& [key, value] : point.tags) {
+            size += key.size() + value.size();
+        }
+        for (auto& [key, value] : point.fields) {
+            size += key.size() + sizeof(value);
+            if (auto str = std::get_if<std::string>(&value)) {
+                size += str->size();
+            }
+        }
+    }
+    else if constexpr (std::is_same_v<POINT_TYPE, PointBatch>) {
+        size += point.measurement.size();
+        size += point.times.size() * sizeof(Point::Time);
+        for (auto& [key, value] : point.tags) {
+            size += key.size() + value.size();
+        }
+        for (auto& [key, column] : point.rowTags) {
+            size += key.size();
+            for (auto& value : column) { size += value.size(); }
+        }
+        for (auto& [key, column] : point.fields) {
+            size += key.size();
+            std::visit(
+                [&size](auto& values) {
+                    using Value =
+                        typename std::decay_t<decltype(values)>::value_type;
+                    size += values.size() * sizeof(Value);
+                    if constexpr (std::is_same_v<Value, std::string>) {
+                        for (auto& value : values) { size += value.size(); }
+                    }
+                },
+                column);
+        }
+    }
+    return size;
+}
+
+template<typename POINT_TYPE, typename FUNCTION>
+void ForEachPrecision(const POINT_TYPE& point, const FUNCTION& func)
+{
+    if constexpr (IsPointVector_v<POINT_TYPE>) {
+        unsigned present{ 0 };
+        for (auto& element : point) {
+            present |= 1U << static_cast<unsigned>(enc::GetPrecision(element));
+        }
+        for (unsigned bit = 0; present != 0; ++bit, present >>= 1) {
+            if ((present & 1U) != 0) { func(static_cast<Precision>(bit)); }
+        }
+    }
+    else {
+        func(enc::GetPrecision(point));
+    }
+}
+
+template<typename POINT_TYPE>
+void EncodeWithPrecision(std::string&      content,
+                         const POINT_TYPE& point,
+                         Precision         precision)
+{
+    if constexpr (IsPointVector_v<POINT_TYPE>) {
+        using Element = typename POINT_TYPE::value_type;
+        enc::LineProtocolEncoder{}.EncodeTo(content,
+                                            boost::span<const Element>(point),
+                                            precision);
+    }
+    else {
+        enc::LineProtocolEncoder{}.EncodeTo(content, point);
+    }
+}
+
+template<typename POINTS>
+void EncodeInParallel(std::vector<BufferPool::Lease>& parts,
+                      const POINTS&                   points,
+                      Precision                       precision,
+                      std::size_t                     chunks,
+                      BufferPool&                     buffers,
+                      boost::asio::yield_context      yield)
+{
+    // Each chunk is encoded into its own part, the parts are then sent as
+    // they are rather than concatenated.
+    auto offset = parts.size();
+    std::generate_n(std::back_inserter(parts), chunks, [&buffers] {
+        return buffers.Acquire();
+    });
+
+    RunInParallel(
+        yield.get_executor(),
+        chunks,
+        [&parts, offset, &points, precision, chunks](std::size_t index) {
+            auto first = points.size() * index / chunks;
+            auto last  = points.size() * (index + 1) / chunks;
+            enc::LineProtocolEncoder{}.EncodeTo(
+                *parts[offset + index],
+                points.subspan(first, last - first),
+                precision);
+        },
+        yield);
+}
+
+// Borrows the storage of the leases for as long as it lives, then hands it back
+// even if sending threw, so that it always returns to the pool.
+class BorrowedParts {
+public:
+    explicit BorrowedParts(std::vector<BufferPool::Lease>& leases) :
+        leases_(leases)
+    {
+        parts_.reserve(leases_.size());
+        for (auto& lease : leases_) { parts_.push_back(std::move(*lease)); }
+    }
+
+    ~BorrowedParts()
+    {
+        for (std::size_t idx = 0; idx < parts_.size(); ++idx) {
+            *leases_[idx] = std::move(parts_[idx]);
+        }
+    }
+
+    std::vector<std::string>& operator*() noexcept { return parts_; }
+
+private:
+    BorrowedParts(const BorrowedParts&)            = delete;
+    BorrowedParts& operator=(const BorrowedParts&) = delete;
+
+private:
+    std::vector<BufferPool::Lease>& leases_;
+    std::vector<std::string>        parts_;
+};
+
 template<typename POINT_TYPE>
 void RunWrite<POINT_TYPE>::operator()(boost::asio::yield_context yield) const
 {
@@ -30,21 +226,474 @@ void RunWrite<POINT_TYPE>::operator()(boost::asio::yield_context yield) const
                         "Database name cannot be empty");
     }
 
-    auto content = enc::LineProtocolEncoder{}.Encode(point_);
+    if constexpr (std::is_same_v<POINT_TYPE, EncodedContent>) {
+        if (point_.error) { std::rethrow_exception(point_.error); }
+        for (auto& part : point_.parts) {
+            Send(*part.content, part.precision, yield);
+        }
+    }
+    else if constexpr (std::is_same_v<POINT_TYPE, SharedContent>) {
+        Send(point_.parts, point_.precision, yield);
+    }
+    else if constexpr (IsPointVector_v<POINT_TYPE>) {
+        using Element = typename POINT_TYPE::value_type;
+        boost::span<const Element> points(point_);
+        if constexpr (enc::IsSeriesOrderable_v<Element>) {
+            if (options_.sortBySeries) {
+                auto order = enc::OrderBySeries(points);
+                WritePoints(enc::OrderedPoints<Element>(points, order), yield);
+            }
+            else {
+                WritePoints(points, yield);
+            }
+        }
+        else {
+            WritePoints(points, yield);
+        }
+    }
+    else {
+        ForEachPrecision(point_, [this, &yield](Precision precision) {
+            auto content = buffers_.Acquire();
+            EncodeWithPrecision(*content, point_, precision);
+            Send(*content, precision, yield);
+        });
+    }
+
+    if (!rejected_.empty()) {
+        throw PartialWriteException(std::move(rejected_));
+    }
+}
+
+template<typename POINT_TYPE>
+template<typename POINTS>
+void RunWrite<POINT_TYPE>::WritePoints(const POINTS&              points,
+                                       boost::asio::yield_context yield) const
+{
+    ForEachPrecision(point_, [this, &points, &yield](Precision precision) {
+        // Rejected lines are only found, parts only split, and replicas only
+        // given content, encoded as a whole.
+        if (options_.chunkSize != 0 && !options_.bisect &&
+            options_.replicas.empty() && FanOutParts(points.size()) < 2) {
+            Stream(points, precision, yield);
+            return;
+        }
+        std::vector<BufferPool::Lease> content;
+        Encode(content, points, precision, yield);
+        Send(content, precision, yield);
+    });
+}
+
+template<typename POINT_TYPE>
+template<typename POINTS>
+void RunWrite<POINT_TYPE>::Encode(std::vector<BufferPool::Lease>& content,
+                                  const POINTS&                   points,
+                                  Precision                       precision,
+                                  boost::asio::yield_context      yield) const
+{
+    const auto threshold = options_.parallelEncodingThreshold;
+
+    auto chunks = threshold ? points.size() / threshold : 0;
+    chunks      = std::min(chunks, options_.concurrency);
+    if (chunks > 1) {
+        EncodeInParallel(content, points, precision, chunks, buffers_, yield);
+        return;
+    }
+
+    auto& part = content.emplace_back(buffers_.Acquire());
+    enc::LineProtocolEncoder{}.EncodeTo(*part, points, precision);
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Send(std::vector<BufferPool::Lease>& content,
+                                Precision                       precision,
+                                boost::asio::yield_context      yield) const
+{
+    if (content.size() == 1) {
+        Send(*content.front(), precision, yield);
+        return;
+    }
+    if (!options_.replicas.empty()) {
+        std::vector<std::string*> parts;
+        parts.reserve(content.size());
+        for (auto& part : content) { parts.push_back(&*part); }
+        if (auto shared = Replicate(parts, precision)) {
+            Send(shared, precision, yield);
+            return;
+        }
+    }
+    if (options_.fanOutThreshold != 0) {
+        std::vector<std::string_view> views;
+        views.reserve(content.size());
+        for (auto& part : content) { views.emplace_back(*part); }
+        if (FanOut(views, precision, yield)) { return; }
+    }
+
+    BorrowedParts borrowed(content);
+    auto&         parts = *borrowed;
+
+    auto response = Deliver(
+        [&](const Endpoint& endpoint) {
+            return http_.PostScattered(endpoint,
+                                       Target(precision),
+                                       parts,
+                                       yield);
+        },
+        [&] {
+            std::vector<std::string_view> views(parts.begin(), parts.end());
+            SpillContent(views, precision);
+        },
+        yield);
+    if (response) {
+        std::vector<std::string_view> views(parts.begin(), parts.end());
+        Settle(*response, views, precision, yield);
+    }
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Send(std::string&               content,
+                                Precision                  precision,
+                                boost::asio::yield_context yield) const
+{
     if (content.empty()) { return; }
+    std::string* parts[] = { &content };
+    if (auto shared = Replicate(parts, precision)) {
+        Send(shared, precision, yield);
+        return;
+    }
+
+    std::string_view view(content);
+    if (FanOut({ &view, 1 }, precision, yield)) { return; }
+
+    auto response = Deliver(
+        [&](const Endpoint& endpoint) {
+            return http_.PostBorrowed(endpoint,
+                                      Target(precision),
+                                      content,
+                                      yield);
+        },
+        [&] { SpillContent({ &view, 1 }, precision); },
+        yield);
+    if (response) { Settle(*response, { &view, 1 }, precision, yield); }
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Send(
+    const std::shared_ptr<const std::vector<std::string>>& content,
+    Precision                                              precision,
+    boost::asio::yield_context                             yield) const
+{
+    std::vector<std::string_view> views(content->begin(), content->end());
+    if (FanOut(views, precision, yield)) { return; }
+
+    auto response = Deliver(
+        [&](const Endpoint& endpoint) {
+            return http_.PostShared(endpoint,
+                                    Target(precision),
+                                    content,
+                                    yield);
+        },
+        [&] { SpillContent(views, precision); },
+        yield);
+    if (response) { Settle(*response, views, precision, yield); }
+}
+
+template<typename POINT_TYPE>
+template<typename POINTS>
+void RunWrite<POINT_TYPE>::Stream(const POINTS&              points,
+                                  Precision                  precision,
+                                  boost::asio::yield_context yield) const
+{
+    // Every attempt encodes the points again, as they are never held encoded
+    // as a whole.
+    PointSource<POINTS> source(points, precision, options_.chunkSize);
+    auto                response = Deliver(
+        [&](const Endpoint& endpoint) {
+            return http_.PostStreamed(endpoint,
+                                      Target(precision),
+                                      source,
+                                      yield);
+        },
+        [&] {
+            // Encoded as a whole to be spilled, which only happens while no
+            // server is available.
+            std::vector<BufferPool::Lease> content;
+            Encode(content, points, precision, yield);
+            std::vector<std::string_view> views;
+            views.reserve(content.size());
+            for (auto& part : content) { views.emplace_back(*part); }
+            SpillContent(views, precision);
+        },
+        yield);
+    if (response) { Check(*response); }
+}
+
+template<typename POINT_TYPE>
+bool RunWrite<POINT_TYPE>::FanOut(boost::span<const std::string_view> content,
+                                  Precision                           precision,
+                                  boost::asio::yield_context yield) const
+{
+    if (options_.fanOutThreshold == 0) { return false; }
+
+    std::vector<std::string_view> lines;
+    for (auto part : content) { enc::SplitLines(part, lines); }
+    const auto parts = FanOutParts(lines.size());
+    if (parts < 2) { return false; }
+
+    boost::span<const std::string_view> all(lines);
+    std::vector<FailedPart>             failed;
+    std::mutex                          mutex;
+    SpawnInParallel(
+        yield.get_executor(),
+        parts,
+        [&](std::size_t index, boost::asio::yield_context yield) {
+            auto first = lines.size() * index / parts;
+            auto last  = lines.size() * (index + 1) / parts;
+            auto part  = all.subspan(first, last - first);
+
+            auto body = buffers_.Acquire();
+            for (auto line : part) { body->append(line); }
+            try {
+                // Parts are sent at the same time, thus to the servers picked
+                // in turn.
+                auto response = Deliver(
+                    [&](const Endpoint& endpoint) {
+                        return http_.PostBorrowed(endpoint,
+                                                  Target(precision),
+                                                  *body,
+                                                  yield);
+                    },
+                    [&] { SpillContent(part, precision); },
+                    yield);
+                if (!response) { return; }
+                if (options_.bisect && part.size() > 1 &&
+                    response->result() == http::Status::bad_request) {
+                    Bisect(part, precision, rejected_, mutex, yield);
+                }
+                else {
+                    Check(*response);
+                }
+            }
+            catch (const Exception& ex) {
+                std::lock_guard lock(mutex);
+                failed.push_back({ first, part.size(), ex.UnderlyingError() });
+            }
+        },
+        yield);
+
+    if (!failed.empty()) {
+        std::sort(failed.begin(),
+                  failed.end(),
+                  [](const FailedPart& lhs, const FailedPart& rhs) {
+                      return lhs.firstLine < rhs.firstLine;
+                  });
+        throw FanOutException(parts, std::move(failed));
+    }
+    return true;
+}
+
+template<typename POINT_TYPE>
+std::size_t RunWrite<POINT_TYPE>::FanOutParts(std::size_t lines) const
+{
+    const auto threshold = options_.fanOutThreshold;
+    if (threshold == 0 || lines < threshold * 2) { return 0; }
+    return std::min(lines / threshold, lb_.CountAvailableServers());
+}
+
+template<typename POINT_TYPE>
+std::shared_ptr<const std::vector<std::string>>
+RunWrite<POINT_TYPE>::Replicate(boost::span<std::string* const> content,
+                                Precision                       precision) const
+{
+    if (options_.replicas.empty()) { return nullptr; }
+
+    std::size_t size{ 0 };
+    for (auto part : content) { size += part->size(); }
+    std::vector<Replica*> replicas;
+    for (auto replica : options_.replicas) {
+        if (replica->Reserve(size)) { replicas.push_back(replica); }
+    }
+    if (replicas.empty()) { return nullptr; }
+
+    // The storage of the parts goes with them rather than back to the pool, as
+    // the replicas may hold it after the write completes.
+    std::vector<std::string> parts;
+    parts.reserve(content.size());
+    for (auto part : content) { parts.push_back(std::move(*part)); }
+    auto shared =
+        std::make_shared<const std::vector<std::string>>(std::move(parts));
+
+    for (auto replica : replicas) {
+        replica->Replicate(db_, rp_, SharedContent{ precision, shared });
+    }
+    return shared;
+}
+
+template<typename POINT_TYPE>
+template<typename POST, typename SPILL>
+std::optional<http::Response>
+RunWrite<POINT_TYPE>::Deliver(const POST&                post,
+                              const SPILL&               spill,
+                              boost::asio::yield_context yield) const
+{
+    const auto attempts = options_.retry ? options_.retry->maxAttempts : 1;
+    for (std::size_t attempt = 1;; ++attempt) {
+        const bool last = attempt >= attempts;
+        try {
+            auto endpoint = PickServer();
+            if (!endpoint) {
+                spill();
+                return std::nullopt;
+            }
 
-    boost::url target(url::WRITE);
-    target.set_query(fmt::format("db={}&rp={}", db_, rp_));
+            auto response = Request(post, *endpoint);
+            if (last || !IsRetryable(response.result())) { return response; }
+        }
+        catch (const Exception& ex) {
+            if (last || !IsRetryable(ex.UnderlyingError())) { throw; }
+        }
+        Backoff(attempt, yield);
+    }
+}
+
+template<typename POINT_TYPE>
+template<typename POST>
+http::Response RunWrite<POINT_TYPE>::Request(const POST&     post,
+                                             const Endpoint& endpoint) const
+{
+    auto controller = options_.controller;
+    if (!controller) { return post(endpoint); }
 
-    auto rsp = http_.Post(lb_.PickAvailableServer(),
-                          target.buffer(),
-                          std::move(content),
-                          yield);
-    if (rsp.result() != http::Status::no_content) {
+    const auto start = BatchController::Clock::now();
+    try {
+        auto response = post(endpoint);
+        controller->Observe(endpoint,
+                            BatchController::Clock::now() - start,
+                            IsRetryable(response.result()));
+        return response;
+    }
+    catch (const Exception& ex) {
+        controller->Observe(endpoint,
+                            BatchController::Clock::now() - start,
+                            IsRetryable(ex.UnderlyingError()));
+        throw;
+    }
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Backoff(std::size_t                attempt,
+                                   boost::asio::yield_context yield) const
+{
+    boost::asio::steady_timer timer(yield.get_executor(),
+                                    RetryBackoff(*options_.retry, attempt));
+    timer.async_wait(yield);
+}
+
+template<typename POINT_TYPE>
+const Endpoint* RunWrite<POINT_TYPE>::PickServer() const
+{
+    try {
+        return &lb_.PickAvailableServer();
+    }
+    catch (const Exception& ex) {
+        if (!options_.spill || ex.UnderlyingError().Code() !=
+                                   errc::ServerErrors::NoAvailableServer) {
+            throw;
+        }
+        return nullptr;
+    }
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::SpillContent(
+    boost::span<const std::string_view> content,
+    Precision                           precision) const
+{
+    if (!options_.spill->Append(db_, rp_, precision, content)) {
+        throw Exception(errc::ServerErrors::NoAvailableServer,
+                        "No room left in the spill");
+    }
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Settle(const http::Response&               response,
+                                  boost::span<const std::string_view> content,
+                                  Precision                           precision,
+                                  boost::asio::yield_context yield) const
+{
+    if (!options_.bisect || response.result() != http::Status::bad_request) {
+        Check(response);
+        return;
+    }
+
+    std::vector<std::string_view> lines;
+    for (auto part : content) { enc::SplitLines(part, lines); }
+    if (lines.size() < 2) {
+        Check(response);
+        return;
+    }
+
+    std::mutex mutex;
+    Bisect(lines, precision, rejected_, mutex, yield);
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Bisect(boost::span<const std::string_view> lines,
+                                  Precision                           precision,
+                                  std::vector<RejectedPoint>& rejected,
+                                  std::mutex&                 mutex,
+                                  boost::asio::yield_context  yield) const
+{
+    auto half = lines.size() / 2;
+    SpawnInParallel(
+        yield.get_executor(),
+        2,
+        [&](std::size_t index, boost::asio::yield_context yield) {
+            auto part =
+                index == 0 ? lines.subspan(0, half) : lines.subspan(half);
+
+            std::string content;
+            for (auto line : part) { content.append(line); }
+            auto response = Deliver(
+                [&](const Endpoint& endpoint) {
+                    return http_.PostBorrowed(endpoint,
+                                              Target(precision),
+                                              content,
+                                              yield);
+                },
+                [&] { SpillContent(part, precision); },
+                yield);
+            if (!response) { return; }
+            if (response->result() != http::Status::bad_request) {
+                Check(*response);
+                return;
+            }
+
+            if (part.size() > 1) {
+                Bisect(part, precision, rejected, mutex, yield);
+                return;
+            }
+            auto line = part[0];
+            line      = line.substr(0, line.find_last_not_of("\r\n") + 1);
+            std::lock_guard lock(mutex);
+            rejected.push_back({ std::string(line), response->body() });
+        },
+        yield);
+}
+
+template<typename POINT_TYPE>
+std::string RunWrite<POINT_TYPE>::Target(Precision precision) const
+{
+    return WriteTarget(db_, rp_, precision);
+}
+
+template<typename POINT_TYPE>
+void RunWrite<POINT_TYPE>::Check(const http::Response& response) const
+{
+    if (response.result() != http::Status::no_content) {
         throw Exception(errc::ServerErrors::UnexpectedStatusCode,
                         fmt::format("Received code: {}, body:{}",
-                                    rsp.result_int(),
-                                    rsp.body()));
+                                    response.result_int(),
+                                    response.body()));
     }
 }
 
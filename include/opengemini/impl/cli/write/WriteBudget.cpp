@@ -0,0 +1,193 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/cli/write/WriteBudget.hpp"
+
+#include <fmt/format.h>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::cli {
+
+OPENGEMINI_INLINE_SPECIFIER
+WriteBudget::Ticket::Ticket(WriteBudget&                 budget,
+                            std::function<std::size_t()> drop) :
+    budget_(budget),
+    drop_(std::move(drop))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+WriteBudget::Ticket::~Ticket()
+{
+    budget_.Release(bytes_.exchange(0));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void WriteBudget::Ticket::Hold(std::size_t bytes) noexcept
+{
+    bytes_.fetch_add(bytes);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool WriteBudget::Ticket::Start() noexcept
+{
+    auto queued = State::Queued;
+    return state_.compare_exchange_strong(queued, State::Started) ||
+           queued == State::Started;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool WriteBudget::Ticket::Drop()
+{
+    auto queued = State::Queued;
+    if (!state_.compare_exchange_strong(queued, State::Dropped)) {
+        return false;
+    }
+
+    // The bytes are released once the dropped writes are discarded, along
+    // with their content. Bytes held afterwards, by a batch not discarded yet,
+    // are released with the ticket.
+    auto writes = drop_();
+    budget_.Release(bytes_.exchange(0));
+
+    std::lock_guard lock(budget_.mutex_);
+    budget_.statistics_.dropped += writes;
+    return true;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+WriteBudget::WriteBudget(boost::asio::io_context& ctx,
+                         const WriteBudgetConfig& config) :
+    ctx_(ctx),
+    maxBytes_(config.maxBytes),
+    policy_(config.policy)
+{
+    if (maxBytes_ == 0) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "Write budget must be positive");
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void WriteBudget::Acquire(std::size_t bytes)
+{
+    std::unique_lock lock(mutex_);
+    Reserve(lock, bytes);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void WriteBudget::Release(std::size_t bytes) noexcept
+{
+    if (bytes == 0) { return; }
+
+    std::lock_guard lock(mutex_);
+    statistics_.bytes -= bytes;
+    room_.notify_all();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::shared_ptr<WriteBudget::Ticket>
+WriteBudget::Track(std::function<std::size_t()> drop)
+{
+    auto ticket = std::make_shared<Ticket>(*this, std::move(drop));
+    if (policy_ == WriteBudgetPolicy::DropOldest) {
+        std::lock_guard lock(mutex_);
+        Queue(ticket);
+    }
+    return ticket;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::shared_ptr<WriteBudget::Ticket>
+WriteBudget::Charge(std::size_t bytes, std::function<std::size_t()> drop)
+{
+    auto             ticket = std::make_shared<Ticket>(*this, std::move(drop));
+    std::unique_lock lock(mutex_);
+    Reserve(lock, bytes);
+    ticket->Hold(bytes);
+    if (policy_ == WriteBudgetPolicy::DropOldest) { Queue(ticket); }
+    return ticket;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+WriteBudgetStatistics WriteBudget::Statistics() const
+{
+    std::lock_guard lock(mutex_);
+    return statistics_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void WriteBudget::Reserve(std::unique_lock<std::mutex>& lock, std::size_t bytes)
+{
+    if (!Fits(bytes)) {
+        if (policy_ == WriteBudgetPolicy::DropOldest) {
+            while (!Fits(bytes) && DropOldest(lock)) { }
+        }
+        else if (policy_ == WriteBudgetPolicy::Block &&
+                 !ctx_.get_executor().running_in_this_thread()) {
+            ++statistics_.blocked;
+            room_.wait(lock, [this, bytes] { return Fits(bytes); });
+        }
+    }
+
+    if (!Fits(bytes)) {
+        ++statistics_.rejected;
+        throw Exception(errc::RuntimeErrors::WriteBudgetExceeded,
+                        fmt::format("{} bytes requested, {} of {} held",
+                                    bytes,
+                                    statistics_.bytes,
+                                    maxBytes_));
+    }
+    statistics_.bytes += bytes;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void WriteBudget::Queue(const std::shared_ptr<Ticket>& ticket)
+{
+    // Writes mostly complete in order, so completed ones are pruned from the
+    // front.
+    while (!queued_.empty() && queued_.front().expired()) {
+        queued_.pop_front();
+    }
+    queued_.push_back(ticket);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool WriteBudget::Fits(std::size_t bytes) const noexcept
+{
+    // A write larger than the whole budget is let through on its own.
+    return statistics_.bytes == 0 || statistics_.bytes + bytes <= maxBytes_;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+bool WriteBudget::DropOldest(std::unique_lock<std::mutex>& lock)
+{
+    while (!queued_.empty()) {
+        auto oldest = std::move(queued_.front());
+        queued_.pop_front();
+
+        // Unlocked while the ticket is referenced, since its destruction takes
+        // the lock, as does dropping it.
+        lock.unlock();
+        auto dropped = false;
+        if (auto ticket = oldest.lock()) { dropped = ticket->Drop(); }
+        lock.lock();
+
+        if (dropped) { return true; }
+    }
+    return false;
+}
+
+} // namespace opengemini::impl::cli
@@ -0,0 +1,123 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_CLI_WRITE_WRITEBUDGET_HPP
+#define OPENGEMINI_IMPL_CLI_WRITE_WRITEBUDGET_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <boost/asio.hpp>
+
+#include "opengemini/ClientConfig.hpp"
+
+namespace opengemini::impl::cli {
+
+//
+// Bounds the number of bytes held by pending writes. Writes are charged before
+// they are queued, and hold the charged bytes through a ticket until they
+// complete. Under the drop-oldest policy, the tickets of writes which have not
+// started sending yet are kept in order of creation, so that the oldest ones
+// are dropped to make room.
+//
+class WriteBudget {
+public:
+    class Ticket {
+    public:
+        Ticket(WriteBudget& budget, std::function<std::size_t()> drop);
+        ~Ticket();
+
+        // Moves charged bytes to the ticket, which releases them once
+        // destroyed or dropped.
+        void Hold(std::size_t bytes) noexcept;
+
+        // Marks the write as being sent, after which it can no longer be
+        // dropped. Returns false if it has been dropped already.
+        bool Start() noexcept;
+
+    private:
+        Ticket(const Ticket&)            = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+    private:
+        friend class WriteBudget;
+
+        enum class State { Queued, Started, Dropped };
+
+        // Returns false if the write is no longer queued.
+        bool Drop();
+
+        WriteBudget&             budget_;
+        std::atomic<std::size_t> bytes_{ 0 };
+        std::atomic<State>       state_{ State::Queued };
+        // Discards the dropped write, returning how many writes it held.
+        std::function<std::size_t()> drop_;
+    };
+
+public:
+    WriteBudget(boost::asio::io_context& ctx, const WriteBudgetConfig& config);
+    ~WriteBudget() = default;
+
+    // Charges the bytes, once there is room for them according to the policy.
+    // Throws if the write is refused.
+    void Acquire(std::size_t bytes);
+    void Release(std::size_t bytes) noexcept;
+
+    // Creates the ticket of a write, which holds no bytes yet.
+    std::shared_ptr<Ticket> Track(std::function<std::size_t()> drop);
+
+    // Charges the bytes and creates the ticket holding them at once, so that
+    // the bytes are never charged without a ticket to drop. Throws if the
+    // write is refused.
+    std::shared_ptr<Ticket> Charge(std::size_t                  bytes,
+                                   std::function<std::size_t()> drop);
+
+    WriteBudgetStatistics Statistics() const;
+
+private:
+    WriteBudget(const WriteBudget&)            = delete;
+    WriteBudget& operator=(const WriteBudget&) = delete;
+
+    // Called with the lock held, which may be released meanwhile.
+    void Reserve(std::unique_lock<std::mutex>& lock, std::size_t bytes);
+    // Called with the lock held.
+    void Queue(const std::shared_ptr<Ticket>& ticket);
+
+    bool Fits(std::size_t bytes) const noexcept;
+    // Drops the oldest write still queued, returns false if there is none.
+    // Called with the lock held, which is released meanwhile.
+    bool DropOldest(std::unique_lock<std::mutex>& lock);
+
+private:
+    boost::asio::io_context& ctx_;
+    const std::size_t        maxBytes_;
+    const WriteBudgetPolicy  policy_;
+
+    mutable std::mutex                mutex_;
+    std::condition_variable           room_;
+    std::deque<std::weak_ptr<Ticket>> queued_;
+    WriteBudgetStatistics             statistics_;
+};
+
+} // namespace opengemini::impl::cli
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/cli/write/WriteBudget.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_CLI_WRITE_WRITEBUDGET_HPP
@@ -0,0 +1,100 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/comm/BufferPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl {
+
+OPENGEMINI_INLINE_SPECIFIER
+BufferPool::Lease::Lease(BufferPool& pool, std::string buffer) noexcept :
+    pool_(&pool),
+    buffer_(std::move(buffer))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+BufferPool::Lease::Lease(Lease&& lease) noexcept :
+    pool_(std::exchange(lease.pool_, nullptr)),
+    buffer_(std::move(lease.buffer_))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+BufferPool::Lease::~Lease() noexcept
+{
+    if (pool_) { pool_->Release(std::move(buffer_)); }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+BufferPool::BufferPool(std::size_t maxIdle, std::size_t maxCapacity) :
+    maxIdle_(maxIdle),
+    maxCapacity_(maxCapacity)
+{
+    // Releasing never allocates then, so that it cannot throw.
+    idle_.reserve(maxIdle_);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+BufferPool::Lease BufferPool::Acquire()
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (!idle_.empty()) {
+            auto buffer = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(*this, std::move(buffer));
+        }
+    }
+
+    // Leave some headroom above the average so that a slightly larger batch
+    // does not immediately trigger a reallocation.
+    std::string buffer;
+    auto        expected = ExpectedSize();
+    buffer.reserve(std::min(expected + expected / 8, maxCapacity_));
+    return Lease(*this, std::move(buffer));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t BufferPool::ExpectedSize() const noexcept
+{
+    return expectedSize_.load(std::memory_order_relaxed);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void BufferPool::Release(std::string buffer) noexcept
+{
+    // Buffers whose storage was moved out, e.g. to be shared with replicas,
+    // say nothing about the sizes to expect, and are not worth keeping. They
+    // are left with the inline capacity of an empty string, if any.
+    if (buffer.capacity() <= std::string().capacity()) { return; }
+
+    // Exponentially weighted moving average of the released sizes, racing
+    // updates only lose a sample, which is harmless.
+    auto size     = buffer.size();
+    auto expected = ExpectedSize();
+    expectedSize_.store(expected == 0 ? size
+                                      : expected - expected / 8 + size / 8,
+                        std::memory_order_relaxed);
+
+    if (buffer.capacity() > maxCapacity_) { return; }
+    buffer.clear();
+
+    std::lock_guard lock(mutex_);
+    if (idle_.size() < maxIdle_) { idle_.push_back(std::move(buffer)); }
+}
+
+} // namespace opengemini::impl
@@ -0,0 +1,84 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_COMM_BUFFERPOOL_HPP
+#define OPENGEMINI_IMPL_COMM_BUFFERPOOL_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opengemini::impl {
+
+//
+// A pool of reusable request body buffers. Released buffers keep their storage,
+// and newly created ones reserve the moving average of recently released
+// sizes, so a steady stream of writes stops allocating for the body.
+//
+class BufferPool {
+public:
+    class Lease {
+    public:
+        Lease(BufferPool& pool, std::string buffer) noexcept;
+        ~Lease() noexcept;
+
+        Lease(Lease&& lease) noexcept;
+
+        std::string& operator*() noexcept { return buffer_; }
+        std::string* operator->() noexcept { return &buffer_; }
+
+    private:
+        Lease(const Lease&)                = delete;
+        Lease& operator=(const Lease&)     = delete;
+        Lease& operator=(Lease&&) noexcept = delete;
+
+    private:
+        BufferPool* pool_;
+        std::string buffer_;
+    };
+
+public:
+    explicit BufferPool(std::size_t maxIdle     = 16,
+                        std::size_t maxCapacity = 64 * 1024 * 1024);
+    ~BufferPool() = default;
+
+    Lease Acquire();
+
+    std::size_t ExpectedSize() const noexcept;
+
+private:
+    BufferPool(const BufferPool&)                = delete;
+    BufferPool(BufferPool&&) noexcept            = delete;
+    BufferPool& operator=(const BufferPool&)     = delete;
+    BufferPool& operator=(BufferPool&&) noexcept = delete;
+
+    void Release(std::string buffer) noexcept;
+
+private:
+    std::mutex               mutex_;
+    std::vector<std::string> idle_;
+    std::atomic<std::size_t> expectedSize_{ 0 };
+
+    const std::size_t maxIdle_;
+    const std::size_t maxCapacity_;
+};
+
+} // namespace opengemini::impl
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/comm/BufferPool.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_COMM_BUFFERPOOL_HPP
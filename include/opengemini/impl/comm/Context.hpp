@@ -31,6 +31,8 @@ public:
 
     boost::asio::io_context& operator()() noexcept;
 
+    std::size_t Concurrency() const noexcept;
+
 private:
     Context(const Context&)                = delete;
     Context(Context&&) noexcept            = delete;
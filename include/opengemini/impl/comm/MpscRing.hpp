@@ -0,0 +1,127 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_COMM_MPSCRING_HPP
+#define OPENGEMINI_IMPL_COMM_MPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace opengemini::impl {
+
+//
+// A bounded lock-free queue which any number of threads push into, while a
+// single consumer at a time pops from it. Every cell carries a sequence number
+// telling whether it is ready to be written or read, so that producers only
+// contend on claiming a position and never wait on each other (D. Vyukov's
+// bounded queue).
+//
+template<typename T>
+class MpscRing {
+public:
+    // The capacity is rounded up to a power of two.
+    explicit MpscRing(std::size_t capacity) : cells_(RoundUp(capacity))
+    {
+        for (std::size_t idx = 0; idx < cells_.size(); ++idx) {
+            cells_[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    // Moves the value into the ring, unless it is full, in which case the
+    // value is left untouched.
+    bool TryPush(T& value)
+    {
+        auto pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[pos & (cells_.size() - 1)];
+            auto  seq  = cell.sequence.load(std::memory_order_acquire);
+            auto  diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos,
+                                                pos + 1,
+                                                std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Moves the oldest value out of the ring, unless none is ready. Must not be
+    // called by more than one thread at a time.
+    bool TryPop(T& value)
+    {
+        auto  pos  = head_.load(std::memory_order_relaxed);
+        auto& cell = cells_[pos & (cells_.size() - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.sequence.store(pos + cells_.size(), std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Whether the next value is not ready yet, which a value still being
+    // pushed counts as.
+    bool Empty() const noexcept
+    {
+        auto  pos  = head_.load(std::memory_order_relaxed);
+        auto& cell = cells_[pos & (cells_.size() - 1)];
+        return cell.sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    std::size_t Capacity() const noexcept { return cells_.size(); }
+
+private:
+    MpscRing(const MpscRing&)                = delete;
+    MpscRing(MpscRing&&) noexcept            = delete;
+    MpscRing& operator=(const MpscRing&)     = delete;
+    MpscRing& operator=(MpscRing&&) noexcept = delete;
+
+    static std::size_t RoundUp(std::size_t capacity) noexcept
+    {
+        std::size_t size{ 2 };
+        while (size < capacity) { size <<= 1; }
+        return size;
+    }
+
+private:
+    // Aligned to cache lines, so that neighbouring cells and the positions are
+    // not falsely shared between threads.
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        T                        value;
+    };
+
+    std::vector<Cell> cells_;
+
+    alignas(64) std::atomic<std::size_t> tail_{ 0 };
+    alignas(64) std::atomic<std::size_t> head_{ 0 };
+};
+
+} // namespace opengemini::impl
+
+#endif // !OPENGEMINI_IMPL_COMM_MPSCRING_HPP
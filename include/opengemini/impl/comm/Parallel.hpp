@@ -0,0 +1,122 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_COMM_PARALLEL_HPP
+#define OPENGEMINI_IMPL_COMM_PARALLEL_HPP
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
+
+namespace opengemini::impl {
+
+//
+// Runs `task(index)` for every index in [0, count) on the threads behind
+// `executor` and suspends the calling coroutine until all of them finish, then
+// rethrows the first exception thrown by any of them. The task is shared by
+// reference, which is safe since the caller's stack outlives every run.
+//
+template<typename TASK>
+void RunInParallel(const boost::asio::any_io_executor& executor,
+                   std::size_t                         count,
+                   const TASK&                         task,
+                   boost::asio::yield_context          yield)
+{
+    struct Join {
+        std::atomic<std::size_t> pending;
+        std::mutex               mutex;
+        std::exception_ptr       error;
+    } join{ { count }, {}, nullptr };
+
+    if (count == 0) { return; }
+
+    boost::asio::async_initiate<boost::asio::yield_context, void()>(
+        [&executor, &task, &join, count](auto handler) {
+            auto done =
+                std::make_shared<decltype(handler)>(std::move(handler));
+            for (std::size_t index = 0; index < count; ++index) {
+                boost::asio::post(executor, [&task, &join, done, index] {
+                    try {
+                        task(index);
+                    }
+                    catch (...) {
+                        std::lock_guard lock(join.mutex);
+                        if (!join.error) {
+                            join.error = std::current_exception();
+                        }
+                    }
+                    // Resumes the caller through its own executor, after
+                    // which nothing on its stack may be touched.
+                    if (join.pending.fetch_sub(1) == 1) {
+                        boost::asio::post(std::move(*done));
+                    }
+                });
+            }
+        },
+        yield);
+
+    if (join.error) { std::rethrow_exception(join.error); }
+}
+
+//
+// Like RunInParallel, except that every run is a coroutine of its own, spawned
+// on `executor` as `task(index, yield)`, so that it may suspend meanwhile.
+//
+template<typename TASK>
+void SpawnInParallel(const boost::asio::any_io_executor& executor,
+                     std::size_t                         count,
+                     const TASK&                         task,
+                     boost::asio::yield_context          yield)
+{
+    struct Join {
+        std::atomic<std::size_t> pending;
+        std::mutex               mutex;
+        std::exception_ptr       error;
+    } join{ { count }, {}, nullptr };
+
+    if (count == 0) { return; }
+
+    boost::asio::async_initiate<boost::asio::yield_context, void()>(
+        [&executor, &task, &join, count](auto handler) {
+            auto done =
+                std::make_shared<decltype(handler)>(std::move(handler));
+            for (std::size_t index = 0; index < count; ++index) {
+                boost::asio::spawn(
+                    executor,
+                    [&task, &join, done, index](auto yield) {
+                        task(index, yield);
+                    },
+                    [&join, done](std::exception_ptr error) {
+                        if (error) {
+                            std::lock_guard lock(join.mutex);
+                            if (!join.error) { join.error = error; }
+                        }
+                        if (join.pending.fetch_sub(1) == 1) {
+                            boost::asio::post(std::move(*done));
+                        }
+                    });
+            }
+        },
+        yield);
+
+    if (join.error) { std::rethrow_exception(join.error); }
+}
+
+} // namespace opengemini::impl
+
+#endif // !OPENGEMINI_IMPL_COMM_PARALLEL_HPP
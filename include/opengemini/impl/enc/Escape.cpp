@@ -0,0 +1,241 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/enc/Escape.hpp"
+
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define OPENGEMINI_IMPL_ENC_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#    define OPENGEMINI_IMPL_ENC_HAS_AVX2
+#    include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#    include <intrin.h>
+#endif // _MSC_VER
+
+namespace opengemini::impl::enc {
+
+namespace {
+
+struct EscapeChars {
+    char c0;
+    char c1;
+    char c2;
+};
+
+// Indexed by EscapeClass, classes with fewer than three characters repeat
+// the last one so that the SIMD paths can always compare against three.
+constexpr EscapeChars ESCAPE_CHARS[]{
+    { ',', ' ', ' ' },   // Measurement
+    { ',', '=', ' ' },   // Tag
+    { ',', '=', ' ' },   // FieldKey
+    { '"', '\\', '\\' }, // FieldValue
+};
+
+constexpr auto ESCAPE_CLASS_NUM{ std::size(ESCAPE_CHARS) };
+
+using EscapeTable = std::array<std::array<bool, 256>, ESCAPE_CLASS_NUM>;
+
+constexpr EscapeTable MakeEscapeTable()
+{
+    EscapeTable table{};
+    for (std::size_t cls = 0; cls < ESCAPE_CLASS_NUM; ++cls) {
+        auto& [c0, c1, c2] = ESCAPE_CHARS[cls];
+        table[cls][static_cast<unsigned char>(c0)] = true;
+        table[cls][static_cast<unsigned char>(c1)] = true;
+        table[cls][static_cast<unsigned char>(c2)] = true;
+    }
+    return table;
+}
+
+inline constexpr auto ESCAPE_TABLE{ MakeEscapeTable() };
+
+constexpr bool IsConsistentWithNeedsEscape()
+{
+    for (std::size_t cls = 0; cls < ESCAPE_CLASS_NUM; ++cls) {
+        for (std::size_t ch = 0; ch < 256; ++ch) {
+            if (ESCAPE_TABLE[cls][ch] !=
+                NeedsEscape(static_cast<char>(ch),
+                            static_cast<EscapeClass>(cls))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(IsConsistentWithNeedsEscape(),
+              "ESCAPE_CHARS must agree with NeedsEscape()");
+
+inline std::size_t CountTrailingZeros(uint32_t mask) noexcept
+{
+#ifdef _MSC_VER
+    unsigned long index{ 0 };
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif // _MSC_VER
+}
+
+#ifdef OPENGEMINI_IMPL_ENC_HAS_SSE2
+inline uint32_t MatchBlock16(const char*       data,
+                             const EscapeChars& chars) noexcept
+{
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    auto hit   = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(chars.c0)),
+                     _mm_cmpeq_epi8(block, _mm_set1_epi8(chars.c1))),
+        _mm_cmpeq_epi8(block, _mm_set1_epi8(chars.c2)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+}
+
+// Scans the bytes in [pos, size) of which at least 16 bytes are available,
+// the last partial block is handled by an overlapping load.
+inline std::size_t FindEscapeTail16(std::string_view   origin,
+                                    std::size_t        pos,
+                                    const EscapeChars& chars) noexcept
+{
+    const auto size = origin.size();
+    for (; pos + 16 <= size; pos += 16) {
+        if (auto mask = MatchBlock16(origin.data() + pos, chars); mask) {
+            return pos + CountTrailingZeros(mask);
+        }
+    }
+
+    if (pos < size) {
+        auto mask = MatchBlock16(origin.data() + size - 16, chars) >>
+                    (16 - (size - pos));
+        if (mask) { return pos + CountTrailingZeros(mask); }
+    }
+    return size;
+}
+
+std::size_t FindEscapeSse2Impl(std::string_view origin,
+                               EscapeClass      cls) noexcept
+{
+    if (origin.size() < 16) {
+        return detail::FindEscapeScalar(origin, cls);
+    }
+    return FindEscapeTail16(origin,
+                            0,
+                            ESCAPE_CHARS[static_cast<std::size_t>(cls)]);
+}
+#endif // OPENGEMINI_IMPL_ENC_HAS_SSE2
+
+#ifdef OPENGEMINI_IMPL_ENC_HAS_AVX2
+__attribute__((target("avx2"))) std::size_t
+FindEscapeAvx2Impl(std::string_view origin, EscapeClass cls) noexcept
+{
+    const auto  size  = origin.size();
+    const auto& chars = ESCAPE_CHARS[static_cast<std::size_t>(cls)];
+    if (size < 32) { return FindEscapeSse2Impl(origin, cls); }
+
+    const auto c0 = _mm256_set1_epi8(chars.c0);
+    const auto c1 = _mm256_set1_epi8(chars.c1);
+    const auto c2 = _mm256_set1_epi8(chars.c2);
+
+    std::size_t pos{ 0 };
+    for (; pos + 32 <= size; pos += 32) {
+        auto block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(origin.data() + pos));
+        auto hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, c0),
+                            _mm256_cmpeq_epi8(block, c1)),
+            _mm256_cmpeq_epi8(block, c2));
+        if (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            mask) {
+            return pos + CountTrailingZeros(mask);
+        }
+    }
+
+    return FindEscapeTail16(origin, pos, chars);
+}
+#endif // OPENGEMINI_IMPL_ENC_HAS_AVX2
+
+} // namespace
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t FindEscape(std::string_view origin, EscapeClass cls) noexcept
+{
+    static const auto impl = []() -> detail::FindEscapeFunc {
+        if (auto func = detail::FindEscapeAvx2(); func) { return func; }
+        if (auto func = detail::FindEscapeSse2(); func) { return func; }
+        return &detail::FindEscapeScalar;
+    }();
+
+    return impl(origin, cls);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void AppendEscaped(std::string&     output,
+                   std::string_view origin,
+                   EscapeClass      cls)
+{
+    for (;;) {
+        auto pos = FindEscape(origin, cls);
+        output.append(origin.substr(0, pos));
+        if (pos == origin.size()) { break; }
+
+        output.push_back('\\');
+        output.push_back(origin[pos]);
+        origin.remove_prefix(pos + 1);
+    }
+}
+
+namespace detail {
+
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t FindEscapeScalar(std::string_view origin, EscapeClass cls) noexcept
+{
+    const auto& table = ESCAPE_TABLE[static_cast<std::size_t>(cls)];
+    for (std::size_t pos = 0; pos < origin.size(); ++pos) {
+        if (table[static_cast<unsigned char>(origin[pos])]) { return pos; }
+    }
+    return origin.size();
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+FindEscapeFunc FindEscapeSse2() noexcept
+{
+#ifdef OPENGEMINI_IMPL_ENC_HAS_SSE2
+    return &FindEscapeSse2Impl;
+#else
+    return nullptr;
+#endif // OPENGEMINI_IMPL_ENC_HAS_SSE2
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+FindEscapeFunc FindEscapeAvx2() noexcept
+{
+#ifdef OPENGEMINI_IMPL_ENC_HAS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return &FindEscapeAvx2Impl; }
+#endif // OPENGEMINI_IMPL_ENC_HAS_AVX2
+    return nullptr;
+}
+
+} // namespace detail
+
+} // namespace opengemini::impl::enc
+
+#undef OPENGEMINI_IMPL_ENC_HAS_SSE2
+#undef OPENGEMINI_IMPL_ENC_HAS_AVX2
@@ -0,0 +1,80 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_ENC_ESCAPE_HPP
+#define OPENGEMINI_IMPL_ENC_ESCAPE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::enc {
+
+enum class EscapeClass : uint8_t {
+    Measurement,
+    Tag,
+    FieldKey,
+    FieldValue,
+};
+
+//
+// Returns whether `ch` must be escaped under the given class. Usable in
+// constant expressions, so that constant keys can be escaped at compile time.
+//
+constexpr bool NeedsEscape(char ch, EscapeClass cls) noexcept
+{
+    switch (cls) {
+    case EscapeClass::Measurement: return ch == ',' || ch == ' ';
+    case EscapeClass::Tag:
+    case EscapeClass::FieldKey: return ch == ',' || ch == '=' || ch == ' ';
+    case EscapeClass::FieldValue: return ch == '"' || ch == '\\';
+    }
+    return false;
+}
+
+//
+// Returns the position of the first character in `origin` which must be
+// escaped under the given class, or `origin.size()` if there is none.
+// The fastest implementation supported by the running CPU is chosen on the
+// first call.
+//
+std::size_t FindEscape(std::string_view origin, EscapeClass cls) noexcept;
+
+// Appends `origin` to `output` with every character which must be escaped
+// under the given class prefixed by a backslash.
+void AppendEscaped(std::string&     output,
+                   std::string_view origin,
+                   EscapeClass      cls);
+
+namespace detail {
+
+using FindEscapeFunc = std::size_t (*)(std::string_view, EscapeClass) noexcept;
+
+std::size_t FindEscapeScalar(std::string_view origin, EscapeClass cls) noexcept;
+
+// Returns nullptr if the implementation is not available on the running CPU.
+FindEscapeFunc FindEscapeSse2() noexcept;
+FindEscapeFunc FindEscapeAvx2() noexcept;
+
+} // namespace detail
+
+} // namespace opengemini::impl::enc
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/enc/Escape.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_ENC_ESCAPE_HPP
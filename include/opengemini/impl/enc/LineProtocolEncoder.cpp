@@ -17,163 +17,209 @@
 #include <algorithm>
 #include <cassert>
 #include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "opengemini/Exception.hpp"
 #include "opengemini/Precision.hpp"
 
 namespace opengemini::impl::enc {
 
-namespace {
+OPENGEMINI_INLINE_SPECIFIER
+std::string LineProtocolEncoder::Encode(const Point& point)
+{
+    std::string content;
+    EncodeTo(content, point);
+    return content;
+}
 
-template<typename DURATION>
-inline auto Round(const Point::Time& time)
+OPENGEMINI_INLINE_SPECIFIER
+std::string LineProtocolEncoder::Encode(const std::vector<Point>& points)
 {
-    return std::chrono::time_point_cast<Point::Time::duration>(
-               std::chrono::round<DURATION>(time))
-        .time_since_epoch()
-        .count();
+    std::string content;
+    EncodeTo(content, points);
+    return content;
 }
 
-} // namespace
+OPENGEMINI_INLINE_SPECIFIER
+std::string LineProtocolEncoder::Encode(const PointBatch& batch)
+{
+    std::string content;
+    EncodeTo(content, batch);
+    return content;
+}
 
 OPENGEMINI_INLINE_SPECIFIER
-std::string LineProtocolEncoder::Encode(const Point& point)
+void LineProtocolEncoder::EncodeTo(std::string& buffer, const Point& point)
 {
+    BufferBorrower borrower(buffer_, buffer);
     AppendPoint(point);
-    return os_.str();
 }
 
 OPENGEMINI_INLINE_SPECIFIER
-std::string LineProtocolEncoder::Encode(const std::vector<Point>& points)
+void LineProtocolEncoder::EncodeTo(std::string&              buffer,
+                                   const std::vector<Point>& points)
 {
-    for (auto& point : points) {
-        AppendPoint(point);
-        Append(ELEMENT_LF);
-    }
+    BufferBorrower borrower(buffer_, buffer);
+    AppendLines(points);
+}
 
-    return os_.str();
+OPENGEMINI_INLINE_SPECIFIER
+void LineProtocolEncoder::EncodeTo(std::string& buffer, const PointBatch& batch)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendBatch(batch);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
 void LineProtocolEncoder::AppendPoint(const Point& point)
 {
-    auto& [measurement, fields, time, tags, precision] = point;
-    AppendMeasurement(measurement);
-    AppendTags(tags);
-    AppendFields(fields);
-    AppendTimestamp(time, precision);
+    AppendGenericPoint(point, point.precision);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
-void LineProtocolEncoder::AppendMeasurement(std::string_view measurement)
+void LineProtocolEncoder::AppendPoint(const FlatPoint& point)
 {
-    if (measurement.empty()) {
-        throw Exception(errc::LogicErrors::InvalidArgument,
-                        "The filed <measurement> in Point must not be empty");
-    }
+    AppendGenericPoint(point, point.precision);
+}
 
-    AppendEscapeString(measurement, ESCAPE_CHARS_MEASUREMENT);
+OPENGEMINI_INLINE_SPECIFIER
+void LineProtocolEncoder::AppendPoint(const PointView& point)
+{
+    AppendGenericPoint(point, point.precision);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
-void LineProtocolEncoder::AppendTags(const decltype(Point::tags)& tags)
+void LineProtocolEncoder::AppendBatch(const PointBatch& batch)
 {
-    for (auto& [key, value] : tags) {
+    auto& [measurement, fields, times, tags, rowTags, precision, series] =
+        batch;
+    if (fields.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "The <fields> in PointBatch must not be empty");
+    }
+
+    const auto rows =
+        times.empty()
+            ? std::visit([](const auto& column) { return column.size(); },
+                         fields.begin()->second)
+            : times.size();
+    auto checkRows = [rows](std::size_t size) {
+        if (size != rows) {
+            throw Exception(errc::LogicErrors::InvalidArgument,
+                            "All columns in PointBatch must have the same "
+                            "number of rows");
+        }
+    };
+
+    // Everything which does not vary between rows is escaped only once: the
+    // measurement with the shared tags, and the keys of the columns together
+    // with their separators.
+    std::string      escaped;
+    std::string_view prefix{ series.View() };
+    if (series.Empty()) {
+        {
+            BufferBorrower borrower(buffer_, escaped);
+            AppendMeasurement(measurement);
+            AppendTags(tags);
+        }
+        prefix = escaped;
+    }
+
+    std::vector<std::pair<std::string, const PointBatch::TagColumn*>> tagCols;
+    tagCols.reserve(rowTags.size());
+    for (auto& [key, column] : rowTags) {
+        checkRows(column.size());
+        auto& [tagKey, _] = tagCols.emplace_back(std::string{}, &column);
+        BufferBorrower borrower(buffer_, tagKey);
         Append(ELEMENT_COMMA);
-        AppendEscapeString(key, ESCAPE_CHARS_TAG);
+        AppendEscapeString(key, EscapeClass::Tag);
         Append(ELEMENT_EQUAL);
-        AppendEscapeString(value, ESCAPE_CHARS_TAG);
     }
+
+    std::vector<std::pair<std::string, const PointBatch::Column*>> fieldCols;
+    fieldCols.reserve(fields.size());
+    for (auto& [key, column] : fields) {
+        checkRows(std::visit([](const auto& col) { return col.size(); },
+                             column));
+        auto& [fieldKey, _] = fieldCols.emplace_back(std::string{}, &column);
+        BufferBorrower borrower(buffer_, fieldKey);
+        Append(fieldCols.size() == 1 ? ELEMENT_SPACE : ELEMENT_COMMA);
+        AppendEscapeString(key, EscapeClass::FieldKey);
+        Append(ELEMENT_EQUAL);
+    }
+
+    VisitPrecision(precision, [&, this](auto constant) {
+        for (std::size_t row = 0; row < rows; ++row) {
+            Append(prefix);
+            for (auto& [key, column] : tagCols) {
+                if (auto& value = (*column)[row]; !value.empty()) {
+                    Append(key);
+                    AppendEscapeString(value, EscapeClass::Tag);
+                }
+            }
+            for (auto& [key, column] : fieldCols) {
+                Append(key);
+                std::visit([this, row](
+                               const auto& col) { AppendFieldValue(col[row]); },
+                           *column);
+            }
+            // Structured bindings cannot be captured before C++20.
+            if (auto& column = batch.times; !column.empty()) {
+                AppendTimestamp(column[row], constant);
+            }
+            Append(ELEMENT_LF);
+        }
+    });
 }
 
 OPENGEMINI_INLINE_SPECIFIER
-void LineProtocolEncoder::AppendFields(const decltype(Point::fields)& fields)
+void LineProtocolEncoder::AppendMeasurement(std::string_view measurement)
 {
-    if (fields.empty()) {
+    if (measurement.empty()) {
         throw Exception(errc::LogicErrors::InvalidArgument,
-                        "The filed <fields> in Point must not be empty");
+                        "The filed <measurement> in Point must not be empty");
     }
 
-    Append(ELEMENT_SPACE);
-    std::for_each_n(fields.begin(),
-                    fields.size() - 1,
-                    [this](const auto& field) {
-                        AppendField(field);
-                        Append(ELEMENT_COMMA);
-                    });
-    AppendField(*fields.rbegin());
+    AppendEscapeString(measurement, EscapeClass::Measurement);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
 void LineProtocolEncoder::AppendTimestamp(const Point::Time& time,
                                           Precision          precision)
 {
-    using namespace std::chrono;
-
-    int64_t count{ 0 };
-    switch (precision) {
-    case Precision::Nanosecond: count = time.time_since_epoch().count(); break;
-    case Precision::Microsecond: count = Round<microseconds>(time); break;
-    case Precision::Millisecond: count = Round<milliseconds>(time); break;
-    case Precision::Second: count = Round<seconds>(time); break;
-    case Precision::Minute: count = Round<minutes>(time); break;
-    case Precision::Hour: count = Round<hours>(time); break;
-    }
-
-    if (count != 0) {
-        Append(ELEMENT_SPACE);
-        Append(count);
-    }
+    VisitPrecision(precision, [this, &time](auto constant) {
+        AppendTimestamp(time, constant);
+    });
 }
 
 OPENGEMINI_INLINE_SPECIFIER
-void LineProtocolEncoder::AppendField(
-    const decltype(Point::fields)::value_type& field)
+void LineProtocolEncoder::AppendField(std::string_view    key,
+                                      const Point::Field& value)
 {
-    auto& [key, value] = field;
-
-    AppendEscapeString(key, ESCAPE_CHARS_FIELD_KEY);
+    AppendEscapeString(key, EscapeClass::FieldKey);
     Append(ELEMENT_EQUAL);
     std::visit(
-        [this](const auto& innerValue) {
-            using T = std::decay_t<decltype(innerValue)>;
+        [this](const auto& innerValue) { AppendFieldValue(innerValue); },
+        value);
+}
 
-            if constexpr (std::is_same_v<T, std::string>) {
-                Append(ELEMENT_DQUOTE);
-                AppendEscapeString(innerValue, ESCAPE_CHARS_FIELD_VALUE);
-                Append(ELEMENT_DQUOTE);
-            }
-            else if constexpr (std::is_same_v<T, uint64_t>) {
-                Append(innerValue);
-                Append(ELEMENT_UINT);
-            }
-            else if constexpr (std::is_same_v<T, int64_t>) {
-                Append(innerValue);
-                Append(ELEMENT_INT);
-            }
-            else if constexpr (std::is_same_v<T, bool>) {
-                Append(innerValue ? ELEMENT_TRUE : ELEMENT_FALSE);
-            }
-            else if constexpr (std::is_same_v<T, double>) {
-                Append(innerValue);
-            }
-            else {
-                throw Exception(errc::LogicErrors::NotImplemented,
-                                "Only support std::string, uint64_t, int64_t, "
-                                "bool, double as filed value type");
-            }
-        },
+OPENGEMINI_INLINE_SPECIFIER
+void LineProtocolEncoder::AppendField(std::string_view        key,
+                                      const PointView::Field& value)
+{
+    AppendEscapeString(key, EscapeClass::FieldKey);
+    Append(ELEMENT_EQUAL);
+    std::visit(
+        [this](const auto& innerValue) { AppendFieldValue(innerValue); },
         value);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
 void LineProtocolEncoder::AppendEscapeString(std::string_view origin,
-                                             std::string_view escapes)
+                                             EscapeClass      cls)
 {
-    for (auto ch : origin) {
-        if (escapes.find(ch) != escapes.npos) { Append(ELEMENT_BSLASH); }
-        Append(ch);
-    }
+    AppendEscaped(buffer_, origin, cls);
 }
 
 } // namespace opengemini::impl::enc
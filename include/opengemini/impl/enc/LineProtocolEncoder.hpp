@@ -15,81 +15,193 @@
 #ifndef OPENGEMINI_IMPL_ENC_LINEPROTOCOLENCODER_HPP
 #define OPENGEMINI_IMPL_ENC_LINEPROTOCOLENCODER_HPP
 
-#include <sstream>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include <boost/core/span.hpp>
+
+#include "opengemini/FlatPoint.hpp"
+#include "opengemini/Measurement.hpp"
 #include "opengemini/Point.hpp"
+#include "opengemini/PointBatch.hpp"
+#include "opengemini/PointView.hpp"
+#include "opengemini/impl/enc/Escape.hpp"
+#include "opengemini/impl/enc/Schema.hpp"
+#include "opengemini/impl/enc/SeriesOrder.hpp"
+#include "opengemini/impl/enc/Timestamp.hpp"
 #include "opengemini/impl/util/Preprocessor.hpp"
 
 namespace opengemini::impl::enc {
 
+template<typename T>
+inline constexpr bool IsDeducedPoint_v = IsMeasurement_v<T> ||
+                                         std::is_same_v<T, FlatPoint> ||
+                                         std::is_same_v<T, PointView>;
+
+// The precision of the timestamp of a point, which has to be sent along with
+// the encoded content.
+template<typename T>
+Precision GetPrecision(const T& point) noexcept
+{
+    if constexpr (IsMeasurement_v<T>) {
+        return PrecisionOf<MeasurementTraits<T>>::value;
+    }
+    else {
+        return point.precision;
+    }
+}
+
 class LineProtocolEncoder {
 public:
     std::string Encode(const Point& point);
     std::string Encode(const std::vector<Point>& points);
+    std::string Encode(const PointBatch& batch);
+
+    // Appends the encoded content to the caller's buffer, so that its storage
+    // can be reused across writes.
+    void EncodeTo(std::string& buffer, const Point& point);
+    void EncodeTo(std::string& buffer, const std::vector<Point>& points);
+    void EncodeTo(std::string& buffer, const PointBatch& batch);
+
+    // Overloads for FlatPoint, PointView and user-defined types described by
+    // MeasurementTraits. They are templates so that braced initializer lists
+    // keep selecting the Point overloads.
+    template<typename T, typename = std::enable_if_t<IsDeducedPoint_v<T>>>
+    std::string Encode(const T& point);
+    template<typename T, typename = std::enable_if_t<IsDeducedPoint_v<T>>>
+    std::string Encode(const std::vector<T>& points);
+
+    template<typename T, typename = std::enable_if_t<IsDeducedPoint_v<T>>>
+    void EncodeTo(std::string& buffer, const T& point);
+    template<typename T, typename = std::enable_if_t<IsDeducedPoint_v<T>>>
+    void EncodeTo(std::string& buffer, const std::vector<T>& points);
+
+    // Encodes a contiguous range of points, e.g. one chunk of a vector which
+    // is encoded in parallel.
+    template<typename T>
+    void EncodeTo(std::string& buffer, boost::span<const T> points);
+    // Encodes only the points of the given precision, so that a range mixing
+    // precisions is written by one request per precision.
+    template<typename T>
+    void EncodeTo(std::string&         buffer,
+                  boost::span<const T> points,
+                  Precision            precision);
+    // Encodes the points of the given precision from the front of the range
+    // until the buffer holds at least `limit` bytes, and returns the number of
+    // points consumed, so that a body can be produced chunk by chunk.
+    template<typename T>
+    std::size_t EncodeSome(std::string&         buffer,
+                           boost::span<const T> points,
+                           Precision            precision,
+                           std::size_t          limit);
+    // Same as above, visiting the points in the order of the range, e.g.
+    // grouped by series.
+    template<typename T>
+    void EncodeTo(std::string&            buffer,
+                  const OrderedPoints<T>& points,
+                  Precision               precision);
+    template<typename T>
+    std::size_t EncodeSome(std::string&            buffer,
+                           const OrderedPoints<T>& points,
+                           Precision               precision,
+                           std::size_t             limit);
 
 private:
+    // Lends the caller's buffer to the encoder for the lifetime of the guard.
+    class BufferBorrower {
+    public:
+        BufferBorrower(std::string& encoder, std::string& caller) :
+            encoder_(encoder),
+            caller_(caller)
+        {
+            encoder_.swap(caller_);
+        }
+
+        ~BufferBorrower() { encoder_.swap(caller_); }
+
+    private:
+        std::string& encoder_;
+        std::string& caller_;
+    };
+
     void AppendPoint(const Point& point);
+    void AppendPoint(const FlatPoint& point);
+    void AppendPoint(const PointView& point);
+    void AppendBatch(const PointBatch& batch);
+
+    // Shared by Point, FlatPoint and PointView, which only differ in their
+    // containers.
+    template<typename POINT, typename PRECISION>
+    void AppendGenericPoint(const POINT& point, PRECISION precision);
+    template<typename RANGE>
+    void AppendLines(const RANGE& points);
+    template<typename RANGE>
+    std::size_t AppendLines(const RANGE& points,
+                            Precision    precision,
+                            std::size_t  limit = SIZE_MAX);
+
+    template<typename T>
+    void AppendPoint(const T& point);
+    template<typename T, typename TAG>
+    void AppendSchemaTag(const T& point, const TAG& tag);
+    template<typename T, typename FIELD>
+    void AppendSchemaField(const T& point, const FIELD& field, bool& first);
 
     void AppendMeasurement(std::string_view measurement);
-    void AppendTags(const decltype(Point::tags)& tags);
-    void AppendFields(const decltype(Point::fields)& fields);
+    template<typename TAGS>
+    void AppendTags(const TAGS& tags);
+    template<typename FIELDS>
+    void AppendFields(const FIELDS& fields);
     void AppendTimestamp(const Point::Time& time, Precision precision);
+    template<Precision PRECISION>
+    void AppendTimestamp(const Point::Time&           time,
+                         PrecisionConstant<PRECISION> precision);
+
+    void AppendField(std::string_view key, const Point::Field& value);
+    void AppendField(std::string_view key, const PointView::Field& value);
+    template<typename VALUE>
+    void AppendFieldValue(const VALUE& value);
+    void AppendEscapeString(std::string_view origin, EscapeClass cls);
 
-    void AppendField(const decltype(Point::fields)::value_type& field);
-    void AppendEscapeString(std::string_view origin, std::string_view escapes);
+    void Append(char ch) { buffer_.push_back(ch); }
+    void Append(std::string_view str) { buffer_.append(str); }
 
     template<typename T>
-    void Append(T&& t)
+    void AppendNumber(T number)
     {
-        os_ << std::forward<T>(t);
+        // Large enough for the shortest round-trip representation of any
+        // double, as well as for every 64-bit integer.
+        std::array<char, 32> chars;
+
+        auto [end, _] =
+            std::to_chars(chars.data(), chars.data() + chars.size(), number);
+        buffer_.append(chars.data(), end);
     }
 
 private:
-    std::ostringstream os_;
+    std::string buffer_;
 
     static constexpr auto ELEMENT_LF{ '\n' };
-    static constexpr auto ELEMENT_EOF{ '\0' };
     static constexpr auto ELEMENT_COMMA{ ',' };
     static constexpr auto ELEMENT_EQUAL{ '=' };
     static constexpr auto ELEMENT_SPACE{ ' ' };
     static constexpr auto ELEMENT_DQUOTE{ '"' };
-    static constexpr auto ELEMENT_BSLASH{ '\\' };
 
     static constexpr auto ELEMENT_UINT{ 'u' };
     static constexpr auto ELEMENT_INT{ 'i' };
     static constexpr auto ELEMENT_TRUE{ 'T' };
     static constexpr auto ELEMENT_FALSE{ 'F' };
-
-    static constexpr char ESCAPE_CHARS_TAG[]{
-        ELEMENT_COMMA,
-        ELEMENT_EQUAL,
-        ELEMENT_SPACE,
-        ELEMENT_EOF,
-    };
-
-    static constexpr char ESCAPE_CHARS_FIELD_KEY[]{
-        ELEMENT_COMMA,
-        ELEMENT_EQUAL,
-        ELEMENT_SPACE,
-        ELEMENT_EOF,
-    };
-    static constexpr char ESCAPE_CHARS_FIELD_VALUE[]{
-        ELEMENT_DQUOTE,
-        ELEMENT_BSLASH,
-        ELEMENT_EOF,
-    };
-
-    static constexpr char ESCAPE_CHARS_MEASUREMENT[]{
-        ELEMENT_COMMA,
-        ELEMENT_SPACE,
-        ELEMENT_EOF,
-    };
 };
 
 } // namespace opengemini::impl::enc
 
+#include "opengemini/impl/enc/LineProtocolEncoder.tpp"
+
 #ifndef OPENGEMINI_SEPARATE_COMPILATION
 #    include "opengemini/impl/enc/LineProtocolEncoder.cpp"
 #endif // !OPENGEMINI_SEPARATE_COMPILATION
@@ -0,0 +1,278 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/enc/Schema.hpp"
+
+namespace opengemini::impl::enc {
+
+template<typename T, typename>
+std::string LineProtocolEncoder::Encode(const T& point)
+{
+    std::string content;
+    EncodeTo(content, point);
+    return content;
+}
+
+template<typename T, typename>
+std::string LineProtocolEncoder::Encode(const std::vector<T>& points)
+{
+    std::string content;
+    EncodeTo(content, points);
+    return content;
+}
+
+template<typename T, typename>
+void LineProtocolEncoder::EncodeTo(std::string& buffer, const T& point)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendPoint(point);
+}
+
+template<typename T, typename>
+void LineProtocolEncoder::EncodeTo(std::string&          buffer,
+                                   const std::vector<T>& points)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendLines(points);
+}
+
+template<typename T>
+void LineProtocolEncoder::EncodeTo(std::string&         buffer,
+                                   boost::span<const T> points)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendLines(points);
+}
+
+template<typename T>
+void LineProtocolEncoder::EncodeTo(std::string&         buffer,
+                                   boost::span<const T> points,
+                                   Precision            precision)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendLines(points, precision);
+}
+
+template<typename T>
+std::size_t LineProtocolEncoder::EncodeSome(std::string&         buffer,
+                                            boost::span<const T> points,
+                                            Precision            precision,
+                                            std::size_t          limit)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    return AppendLines(points, precision, limit);
+}
+
+template<typename T>
+void LineProtocolEncoder::EncodeTo(std::string&            buffer,
+                                   const OrderedPoints<T>& points,
+                                   Precision               precision)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    AppendLines(points, precision);
+}
+
+template<typename T>
+std::size_t LineProtocolEncoder::EncodeSome(std::string&            buffer,
+                                            const OrderedPoints<T>& points,
+                                            Precision               precision,
+                                            std::size_t             limit)
+{
+    BufferBorrower borrower(buffer_, buffer);
+    return AppendLines(points, precision, limit);
+}
+
+template<typename POINT, typename PRECISION>
+void LineProtocolEncoder::AppendGenericPoint(const POINT& point,
+                                             PRECISION    precision)
+{
+    auto& [measurement, fields, time, tags, _, series] = point;
+    if (series.Empty()) {
+        AppendMeasurement(measurement);
+        AppendTags(tags);
+    }
+    else {
+        Append(series.View());
+    }
+    AppendFields(fields);
+    AppendTimestamp(time, precision);
+}
+
+template<typename RANGE>
+void LineProtocolEncoder::AppendLines(const RANGE& points)
+{
+    for (auto& point : points) {
+        AppendPoint(point);
+        Append(ELEMENT_LF);
+    }
+}
+
+template<typename RANGE>
+std::size_t LineProtocolEncoder::AppendLines(const RANGE& points,
+                                             Precision    precision,
+                                             std::size_t  limit)
+{
+    return VisitPrecision(precision, [this, &points, limit](auto constant) {
+        using Element = std::decay_t<decltype(*std::begin(points))>;
+        std::size_t consumed{ 0 };
+        for (auto& point : points) {
+            ++consumed;
+            if (GetPrecision(point) != decltype(constant)::value) { continue; }
+            if constexpr (IsMeasurement_v<Element>) {
+                AppendPoint(point);
+            }
+            else {
+                AppendGenericPoint(point, constant);
+            }
+            Append(ELEMENT_LF);
+            if (buffer_.size() >= limit) { break; }
+        }
+        return consumed;
+    });
+}
+
+template<typename TAGS>
+void LineProtocolEncoder::AppendTags(const TAGS& tags)
+{
+    for (auto& [key, value] : tags) {
+        Append(ELEMENT_COMMA);
+        AppendEscapeString(key, EscapeClass::Tag);
+        Append(ELEMENT_EQUAL);
+        AppendEscapeString(value, EscapeClass::Tag);
+    }
+}
+
+template<typename FIELDS>
+void LineProtocolEncoder::AppendFields(const FIELDS& fields)
+{
+    if (fields.empty()) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "The filed <fields> in Point must not be empty");
+    }
+
+    Append(ELEMENT_SPACE);
+    std::for_each_n(fields.begin(),
+                    fields.size() - 1,
+                    [this](const auto& field) {
+                        AppendField(field.first, field.second);
+                        Append(ELEMENT_COMMA);
+                    });
+    auto& [key, value] = *fields.rbegin();
+    AppendField(key, value);
+}
+
+template<typename T>
+void LineProtocolEncoder::AppendPoint(const T& point)
+{
+    using Traits = MeasurementTraits<T>;
+    static_assert(std::tuple_size_v<std::decay_t<decltype(Traits::fields)>> >
+                      0,
+                  "MeasurementTraits must declare at least one field");
+
+    Append(Traits::measurement.View());
+
+    if constexpr (HasTags<Traits>::value) {
+        std::apply(
+            [this, &point](const auto&... tag) {
+                (AppendSchemaTag(point, tag), ...);
+            },
+            Traits::tags);
+    }
+
+    bool first{ true };
+    std::apply(
+        [this, &point, &first](const auto&... field) {
+            (AppendSchemaField(point, field, first), ...);
+        },
+        Traits::fields);
+    if (first) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        "At least one field of the measurement must be "
+                        "present");
+    }
+
+    if constexpr (HasTime<Traits>::value) {
+        AppendTimestamp(point.*Traits::time,
+                        PrecisionConstant<PrecisionOf<Traits>::value>{});
+    }
+}
+
+template<typename T, typename TAG>
+void LineProtocolEncoder::AppendSchemaTag(const T& point, const TAG& tag)
+{
+    if (auto* value = PresentValue(point.*tag.member)) {
+        Append(tag.key.View());
+        AppendEscapeString(*value, EscapeClass::Tag);
+    }
+}
+
+template<typename T, typename FIELD>
+void LineProtocolEncoder::AppendSchemaField(const T&     point,
+                                            const FIELD& field,
+                                            bool&        first)
+{
+    if (auto* value = PresentValue(point.*field.member)) {
+        Append(first ? ELEMENT_SPACE : ELEMENT_COMMA);
+        Append(field.key.View());
+        AppendFieldValue(*value);
+        first = false;
+    }
+}
+
+template<Precision PRECISION>
+void LineProtocolEncoder::AppendTimestamp(const Point::Time& time,
+                                          PrecisionConstant<PRECISION>)
+{
+    if (auto ticks = TicksOf<PRECISION>(time); ticks != 0) {
+        Append(ELEMENT_SPACE);
+        AppendNumber(ticks);
+    }
+}
+
+template<typename VALUE>
+void LineProtocolEncoder::AppendFieldValue(const VALUE& value)
+{
+    if constexpr (std::is_same_v<VALUE, bool>) {
+        Append(value ? ELEMENT_TRUE : ELEMENT_FALSE);
+    }
+    else if constexpr (std::is_integral_v<VALUE> && std::is_signed_v<VALUE>) {
+        AppendNumber(static_cast<int64_t>(value));
+        Append(ELEMENT_INT);
+    }
+    else if constexpr (std::is_integral_v<VALUE>) {
+        AppendNumber(static_cast<uint64_t>(value));
+        Append(ELEMENT_UINT);
+    }
+    else if constexpr (std::is_floating_point_v<VALUE>) {
+        AppendNumber(static_cast<double>(value));
+    }
+    else {
+        static_assert(std::is_convertible_v<const VALUE&, std::string_view>,
+                      "Field value must be arithmetic or convertible to "
+                      "std::string_view");
+        Append(ELEMENT_DQUOTE);
+        AppendEscapeString(value, EscapeClass::FieldValue);
+        Append(ELEMENT_DQUOTE);
+    }
+}
+
+} // namespace opengemini::impl::enc
@@ -0,0 +1,121 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/enc/LineValidator.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+#include "opengemini/Exception.hpp"
+
+namespace opengemini::impl::enc {
+
+namespace {
+
+constexpr auto NPOS         = std::string_view::npos;
+constexpr auto UNTERMINATED = NPOS - 1;
+
+// Returns the position of the first unescaped space from `pos`, spaces within
+// double quotes are skipped when `quoted` is true, in which case UNTERMINATED
+// is returned for a quote left open.
+inline std::size_t
+FindSeparator(std::string_view line, std::size_t pos, bool quoted)
+{
+    bool inQuotes{ false };
+    for (; pos < line.size(); ++pos) {
+        auto ch = line[pos];
+        if (ch == '\\') { ++pos; }
+        else if (quoted && ch == '"') { inQuotes = !inQuotes; }
+        else if (ch == ' ' && !inQuotes) { return pos; }
+    }
+    return inQuotes ? UNTERMINATED : NPOS;
+}
+
+// Returns the reason why the line is malformed, or nullptr if it is not.
+inline const char* CheckLine(std::string_view line)
+{
+    if (line.front() == ' ' || line.front() == ',') {
+        return "missing measurement";
+    }
+
+    auto keyEnd = FindSeparator(line, 0, false);
+    if (keyEnd == NPOS) { return "missing fields"; }
+
+    auto fieldsEnd = FindSeparator(line, keyEnd + 1, true);
+    if (fieldsEnd == UNTERMINATED) { return "unterminated string field"; }
+
+    auto fields = line.substr(keyEnd + 1, fieldsEnd - keyEnd - 1);
+    if (fields.empty() || fields.find('=') == NPOS) {
+        return "missing fields";
+    }
+    if (fieldsEnd == NPOS) { return nullptr; }
+
+    auto time = line.substr(fieldsEnd + 1);
+    if (!time.empty() && time.front() == '-') { time.remove_prefix(1); }
+    if (time.empty() || !std::all_of(time.begin(), time.end(), [](char ch) {
+            return std::isdigit(static_cast<unsigned char>(ch));
+        })) {
+        return "invalid timestamp";
+    }
+    return nullptr;
+}
+
+} // namespace
+
+OPENGEMINI_INLINE_SPECIFIER
+void ValidateLines(std::string_view lines)
+{
+    for (std::size_t number = 1; !lines.empty(); ++number) {
+        auto end  = lines.find('\n');
+        auto line = lines.substr(0, end);
+        lines.remove_prefix(end == NPOS ? lines.size() : end + 1);
+
+        if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+        if (line.empty() || line.front() == '#') { continue; }
+
+        if (auto reason = CheckLine(line)) {
+            throw Exception(
+                errc::LogicErrors::InvalidArgument,
+                fmt::format("Invalid line protocol at line {}: {}",
+                            number,
+                            reason));
+        }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void SplitLines(std::string_view content, std::vector<std::string_view>& lines)
+{
+    while (!content.empty()) {
+        // Quotes only delimit string values within the field set, which is the
+        // second section of a line.
+        std::size_t pos{ 0 };
+        std::size_t section{ 0 };
+        bool        inQuotes{ false };
+        for (; pos < content.size(); ++pos) {
+            auto ch = content[pos];
+            if (ch == '\\') { ++pos; }
+            else if (ch == '"' && section == 1) { inQuotes = !inQuotes; }
+            else if (inQuotes) { continue; }
+            else if (ch == ' ') { ++section; }
+            else if (ch == '\n') { break; }
+        }
+
+        auto end = std::min(pos + 1, content.size());
+        lines.push_back(content.substr(0, end));
+        content.remove_prefix(end);
+    }
+}
+
+} // namespace opengemini::impl::enc
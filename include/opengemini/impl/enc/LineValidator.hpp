@@ -0,0 +1,45 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_ENC_LINEVALIDATOR_HPP
+#define OPENGEMINI_IMPL_ENC_LINEVALIDATOR_HPP
+
+#include <string_view>
+#include <vector>
+
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::enc {
+
+//
+// Checks the framing of content already encoded in line protocol, i.e. that
+// each line has a measurement, a non-empty field set and an optional integral
+// timestamp, without parsing the values. Empty lines and comments are skipped.
+// Throws InvalidArgument naming the first malformed line.
+//
+void ValidateLines(std::string_view lines);
+
+//
+// Appends the lines of the content to `lines`, each with its line break. Line
+// breaks within quoted field values do not end a line.
+//
+void SplitLines(std::string_view content, std::vector<std::string_view>& lines);
+
+} // namespace opengemini::impl::enc
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/enc/LineValidator.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_ENC_LINEVALIDATOR_HPP
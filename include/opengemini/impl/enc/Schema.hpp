@@ -0,0 +1,135 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_ENC_SCHEMA_HPP
+#define OPENGEMINI_IMPL_ENC_SCHEMA_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "opengemini/Precision.hpp"
+#include "opengemini/impl/enc/Escape.hpp"
+
+namespace opengemini::impl::enc {
+
+//
+// A string literal escaped at compile time, optionally surrounded by the
+// separators which always accompany it in the line protocol, so that the
+// encoder can append it as is.
+//
+template<std::size_t N>
+class EscapedString {
+public:
+    constexpr EscapedString(const char (&origin)[N],
+                            EscapeClass cls,
+                            char        lead  = '\0',
+                            char        trail = '\0') noexcept
+    {
+        if (lead != '\0') { data_[size_++] = lead; }
+        for (std::size_t idx = 0; idx + 1 < N; ++idx) {
+            if (NeedsEscape(origin[idx], cls)) { data_[size_++] = '\\'; }
+            data_[size_++] = origin[idx];
+        }
+        if (trail != '\0') { data_[size_++] = trail; }
+    }
+
+    constexpr std::string_view View() const noexcept
+    {
+        return { data_, size_ };
+    }
+
+private:
+    char        data_[2 * N]{};
+    std::size_t size_{ 0 };
+};
+
+template<std::size_t N, typename OWNER, typename VALUE>
+struct TagSchema {
+    EscapedString<N> key; // ",key="
+    VALUE OWNER::*member;
+};
+
+template<std::size_t N, typename OWNER, typename VALUE>
+struct FieldSchema {
+    EscapedString<N> key; // "key="
+    VALUE OWNER::*member;
+};
+
+template<typename T>
+struct IsOptional : std::false_type { };
+
+template<typename T>
+struct IsOptional<std::optional<T>> : std::true_type { };
+
+template<typename T>
+struct RemoveOptional {
+    using type = T;
+};
+
+template<typename T>
+struct RemoveOptional<std::optional<T>> {
+    using type = T;
+};
+
+template<typename T>
+using RemoveOptional_t = typename RemoveOptional<T>::type;
+
+template<typename T>
+inline constexpr bool IsTagValue_v =
+    std::is_convertible_v<const RemoveOptional_t<T>&, std::string_view>;
+
+template<typename T>
+inline constexpr bool IsFieldValue_v =
+    std::is_arithmetic_v<RemoveOptional_t<T>> || IsTagValue_v<T>;
+
+// Returns nullptr if an optional member holds no value.
+template<typename T>
+constexpr const T* PresentValue(const T& value) noexcept
+{
+    return &value;
+}
+
+template<typename T>
+constexpr const T* PresentValue(const std::optional<T>& value) noexcept
+{
+    return value ? &*value : nullptr;
+}
+
+template<typename TRAITS, typename = void>
+struct HasTags : std::false_type { };
+
+template<typename TRAITS>
+struct HasTags<TRAITS, std::void_t<decltype(TRAITS::tags)>> :
+    std::true_type { };
+
+template<typename TRAITS, typename = void>
+struct HasTime : std::false_type { };
+
+template<typename TRAITS>
+struct HasTime<TRAITS, std::void_t<decltype(TRAITS::time)>> :
+    std::true_type { };
+
+template<typename TRAITS, typename = void>
+struct PrecisionOf : std::integral_constant<Precision, Precision::Nanosecond> {
+};
+
+template<typename TRAITS>
+struct PrecisionOf<TRAITS, std::void_t<decltype(TRAITS::precision)>> :
+    std::integral_constant<Precision, TRAITS::precision> { };
+
+} // namespace opengemini::impl::enc
+
+#endif // !OPENGEMINI_IMPL_ENC_SCHEMA_HPP
@@ -0,0 +1,222 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_ENC_SERIESORDER_HPP
+#define OPENGEMINI_IMPL_ENC_SERIESORDER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/core/span.hpp>
+
+#include "opengemini/FlatPoint.hpp"
+#include "opengemini/Point.hpp"
+#include "opengemini/PointView.hpp"
+#include "opengemini/impl/enc/Escape.hpp"
+
+namespace opengemini::impl::enc {
+
+template<typename T>
+inline constexpr bool IsSeriesOrderable_v = std::is_same_v<T, Point> ||
+                                            std::is_same_v<T, FlatPoint> ||
+                                            std::is_same_v<T, PointView>;
+
+//
+// A range of points visited in the given order, so that they can be reordered
+// without being moved. It can be split like a span.
+//
+template<typename T>
+class OrderedPoints {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        iterator(const T* points, const std::size_t* index) noexcept :
+            points_(points),
+            index_(index)
+        { }
+
+        reference operator*() const noexcept { return points_[*index_]; }
+        pointer   operator->() const noexcept { return &points_[*index_]; }
+
+        iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept { return { points_, index_++ }; }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+    private:
+        const T*           points_;
+        const std::size_t* index_;
+    };
+
+public:
+    OrderedPoints(boost::span<const T>           points,
+                  boost::span<const std::size_t> order) noexcept :
+        points_(points),
+        order_(order)
+    { }
+
+    iterator begin() const noexcept
+    {
+        return { points_.data(), order_.data() };
+    }
+
+    iterator end() const noexcept
+    {
+        return { points_.data(), order_.data() + order_.size() };
+    }
+
+    std::size_t size() const noexcept { return order_.size(); }
+
+    OrderedPoints subspan(std::size_t offset) const noexcept
+    {
+        return { points_, order_.subspan(offset) };
+    }
+
+    OrderedPoints subspan(std::size_t offset, std::size_t count) const noexcept
+    {
+        return { points_, order_.subspan(offset, count) };
+    }
+
+private:
+    boost::span<const T>           points_;
+    boost::span<const std::size_t> order_;
+};
+
+//
+// FNV-1a hash of the text of a series key, fed piecewise. Feeding the escaped
+// measurement and tags yields the same hash as feeding the key built from
+// them, without building it.
+//
+class SeriesHash {
+public:
+    void Append(std::string_view text) noexcept
+    {
+        for (auto ch : text) { Mix(ch); }
+    }
+
+    void AppendEscaped(std::string_view text, EscapeClass cls) noexcept
+    {
+        for (auto ch : text) {
+            if (NeedsEscape(ch, cls)) { Mix('\\'); }
+            Mix(ch);
+        }
+    }
+
+    std::uint64_t Value() const noexcept { return value_; }
+
+private:
+    void Mix(char ch) noexcept
+    {
+        value_ ^= static_cast<unsigned char>(ch);
+        value_ *= 0x100000001b3ULL;
+    }
+
+private:
+    std::uint64_t value_{ 0xcbf29ce484222325ULL };
+};
+
+// Hash of the series of a point, that is of the text of its series key, so
+// that a point given a series key and one given the same measurement and tags
+// are grouped together. The key sorts the tags, hence so does the hash.
+template<typename T>
+std::uint64_t HashSeries(const T& point)
+{
+    SeriesHash hash;
+    if (!point.series.Empty()) {
+        hash.Append(point.series.View());
+        return hash.Value();
+    }
+
+    auto appendTag = [&hash](std::string_view key, std::string_view value) {
+        hash.Append(",");
+        hash.AppendEscaped(key, EscapeClass::Tag);
+        hash.Append("=");
+        hash.AppendEscaped(value, EscapeClass::Tag);
+    };
+    hash.AppendEscaped(point.measurement, EscapeClass::Measurement);
+    if constexpr (std::is_same_v<T, PointView>) {
+        // Only these tags are written in the given order.
+        boost::container::small_vector<const PointView::TagView*, 8> tags;
+        for (auto& tag : point.tags) { tags.push_back(&tag); }
+        std::sort(tags.begin(), tags.end(), [](auto* lhs, auto* rhs) {
+            return lhs->first < rhs->first;
+        });
+        for (auto* tag : tags) { appendTag(tag->first, tag->second); }
+    }
+    else {
+        for (auto& [key, value] : point.tags) { appendTag(key, value); }
+    }
+    return hash.Value();
+}
+
+// Returns the indexes of the points grouped by series and ordered by time
+// within each series, points with equal keys keeping their relative order.
+// Only compact keys are sorted, never the points themselves. Series whose
+// hashes collide may end up interleaved, which only weakens the grouping.
+template<typename T>
+std::vector<std::size_t> OrderBySeries(boost::span<const T> points)
+{
+    struct Key {
+        std::uint64_t series;
+        std::int64_t  time;
+        std::size_t   index;
+    };
+
+    std::vector<Key> keys;
+    keys.reserve(points.size());
+    for (std::size_t idx = 0; idx < points.size(); ++idx) {
+        auto& point = points[idx];
+        keys.push_back({ HashSeries(point),
+                         point.time.time_since_epoch().count(),
+                         idx });
+    }
+    std::sort(keys.begin(), keys.end(), [](const Key& lhs, const Key& rhs) {
+        return std::tie(lhs.series, lhs.time, lhs.index) <
+               std::tie(rhs.series, rhs.time, rhs.index);
+    });
+
+    std::vector<std::size_t> order;
+    order.reserve(keys.size());
+    for (auto& key : keys) { order.push_back(key.index); }
+    return order;
+}
+
+} // namespace opengemini::impl::enc
+
+#endif // !OPENGEMINI_IMPL_ENC_SERIESORDER_HPP
@@ -0,0 +1,96 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_ENC_TIMESTAMP_HPP
+#define OPENGEMINI_IMPL_ENC_TIMESTAMP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include "opengemini/Point.hpp"
+#include "opengemini/Precision.hpp"
+
+namespace opengemini::impl::enc {
+
+template<Precision PRECISION>
+using PrecisionConstant = std::integral_constant<Precision, PRECISION>;
+
+template<Precision PRECISION>
+struct DurationOf;
+
+template<>
+struct DurationOf<Precision::Nanosecond> {
+    using type = std::chrono::nanoseconds;
+};
+
+template<>
+struct DurationOf<Precision::Microsecond> {
+    using type = std::chrono::microseconds;
+};
+
+template<>
+struct DurationOf<Precision::Millisecond> {
+    using type = std::chrono::milliseconds;
+};
+
+template<>
+struct DurationOf<Precision::Second> {
+    using type = std::chrono::seconds;
+};
+
+template<>
+struct DurationOf<Precision::Minute> {
+    using type = std::chrono::minutes;
+};
+
+template<>
+struct DurationOf<Precision::Hour> {
+    using type = std::chrono::hours;
+};
+
+// Number of ticks of the precision since the epoch, rounded to the nearest
+// one. Nanoseconds are taken as they are. The other precisions divide by a
+// constant, which compilers turn into a multiplication and shifts, then need
+// a few comparisons to round half to even. BM_EncodePointsPerPrecision measures
+// what that costs for each precision.
+template<Precision PRECISION>
+constexpr int64_t TicksOf(const Point::Time& time) noexcept
+{
+    using Duration = typename DurationOf<PRECISION>::type;
+    return static_cast<int64_t>(
+        std::chrono::round<Duration>(time.time_since_epoch()).count());
+}
+
+// Invokes the function with the precision as a PrecisionConstant, so that a
+// whole batch is dispatched once and its timestamps are converted by code
+// specialized for that precision.
+template<typename FUNCTION>
+decltype(auto) VisitPrecision(Precision precision, FUNCTION&& func)
+{
+    switch (precision) {
+    case Precision::Microsecond:
+        return func(PrecisionConstant<Precision::Microsecond>{});
+    case Precision::Millisecond:
+        return func(PrecisionConstant<Precision::Millisecond>{});
+    case Precision::Second: return func(PrecisionConstant<Precision::Second>{});
+    case Precision::Minute: return func(PrecisionConstant<Precision::Minute>{});
+    case Precision::Hour: return func(PrecisionConstant<Precision::Hour>{});
+    default: return func(PrecisionConstant<Precision::Nanosecond>{});
+    }
+}
+
+} // namespace opengemini::impl::enc
+
+#endif // !OPENGEMINI_IMPL_ENC_TIMESTAMP_HPP
@@ -0,0 +1,82 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_HTTP_BUFFERSBODY_HPP
+#define OPENGEMINI_IMPL_HTTP_BUFFERSBODY_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+
+namespace opengemini::impl::http {
+
+//
+// A body made of several owned buffers, which are handed to the stream as a
+// single buffer sequence, so that they are written with vectored I/O rather
+// than concatenated first.
+//
+struct BuffersBody {
+    using value_type = std::vector<std::string>;
+
+    static std::uint64_t size(const value_type& body) noexcept
+    {
+        std::uint64_t size{ 0 };
+        for (auto& buffer : body) { size += buffer.size(); }
+        return size;
+    }
+
+    class writer {
+    public:
+        using const_buffers_type = std::vector<boost::asio::const_buffer>;
+
+        template<bool IS_REQUEST, typename FIELDS>
+        writer(boost::beast::http::header<IS_REQUEST, FIELDS>&,
+               const value_type& body) :
+            body_(body)
+        { }
+
+        void init(boost::beast::error_code& error)
+        {
+            error.clear();
+            buffers_.clear();
+            buffers_.reserve(body_.size());
+            for (auto& buffer : body_) {
+                if (!buffer.empty()) {
+                    buffers_.emplace_back(buffer.data(), buffer.size());
+                }
+            }
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(boost::beast::error_code& error)
+        {
+            error.clear();
+            if (buffers_.empty()) { return boost::none; }
+            return std::make_pair(std::move(buffers_), false);
+        }
+
+    private:
+        const value_type&  body_;
+        const_buffers_type buffers_;
+    };
+};
+
+} // namespace opengemini::impl::http
+
+#endif // !OPENGEMINI_IMPL_HTTP_BUFFERSBODY_HPP
@@ -0,0 +1,205 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opengemini/impl/http/Gzip.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/util/Preprocessor.hpp"
+
+namespace opengemini::impl::http {
+
+namespace zlib = boost::beast::zlib;
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipCompressor::GzipCompressor(int level)
+{
+    if (level < 0 || level > 9) {
+        throw Exception(errc::LogicErrors::InvalidArgument,
+                        fmt::format("Invalid gzip level {}", level));
+    }
+    stream_.reset(level, 15, 8, zlib::Strategy::normal);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipCompressor::Begin(std::string& output)
+{
+    // Neither a modification time nor a file name, the OS is unknown.
+    static constexpr char header[] = {
+        '\x1f', '\x8b', '\x08', '\x00', '\x00',
+        '\x00', '\x00', '\x00', '\x00', '\xff',
+    };
+
+    stream_.reset();
+    crc_.reset();
+    size_ = 0;
+    output.append(header, sizeof(header));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipCompressor::Update(std::string_view input, std::string& output)
+{
+    crc_.process_bytes(input.data(), input.size());
+    size_ += static_cast<std::uint32_t>(input.size());
+    Deflate(input, output, zlib::Flush::none);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipCompressor::Finish(std::string& output)
+{
+    Deflate({}, output, zlib::Flush::finish);
+
+    // Both the CRC-32 and the size modulo 2^32 are stored in little endian.
+    for (auto value : { crc_.checksum(), size_ }) {
+        for (auto shift = 0; shift < 32; shift += 8) {
+            output.push_back(static_cast<char>((value >> shift) & 0xff));
+        }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipCompressor::Compress(std::string_view input, std::string& output)
+{
+    Begin(output);
+    Update(input, output);
+    Finish(output);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipCompressor::Deflate(std::string_view input,
+                             std::string&     output,
+                             zlib::Flush      flush)
+{
+    zlib::z_params params;
+    params.next_in  = input.data();
+    params.avail_in = input.size();
+    for (;;) {
+        auto offset = output.size();
+        auto room   = std::max<std::size_t>(
+            stream_.upper_bound(params.avail_in), 256);
+        output.resize(offset + room);
+        params.next_out  = output.data() + offset;
+        params.avail_out = room;
+
+        boost::beast::error_code error;
+        stream_.write(params, flush, error);
+        output.resize(offset + room - params.avail_out);
+
+        if (error == zlib::error::end_of_stream) { return; }
+        if (error && error != zlib::error::need_buffers) {
+            throw Exception(
+                errc::RuntimeErrors::Unexpected,
+                fmt::format("Failed to compress body: {}", error.message()));
+        }
+        // Everything is consumed and the output was not filled up, so nothing
+        // is left pending until the member is finished.
+        if (flush != zlib::Flush::finish && params.avail_in == 0 &&
+            params.avail_out != 0) {
+            return;
+        }
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipPool::Lease::Lease(GzipPool&                       pool,
+                       std::unique_ptr<GzipCompressor> compressor) :
+    pool_(&pool),
+    compressor_(std::move(compressor))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipPool::Lease::Lease(Lease&& lease) noexcept :
+    pool_(std::exchange(lease.pool_, nullptr)),
+    compressor_(std::move(lease.compressor_))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipPool::Lease::~Lease()
+{
+    if (pool_) { pool_->Release(std::move(compressor_)); }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipPool::GzipPool(int level, std::size_t maxIdle) :
+    level_(level),
+    maxIdle_(maxIdle)
+{
+    // Validates the level up front rather than on the first request.
+    idle_.push_back(std::make_unique<GzipCompressor>(level_));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipPool::Lease GzipPool::Acquire()
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (!idle_.empty()) {
+            auto compressor = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(*this, std::move(compressor));
+        }
+    }
+
+    return Lease(*this, std::make_unique<GzipCompressor>(level_));
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipPool::Release(std::unique_ptr<GzipCompressor> compressor)
+{
+    std::lock_guard lock(mutex_);
+    if (idle_.size() < maxIdle_) { idle_.push_back(std::move(compressor)); }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+GzipSource::GzipSource(BodySource& source, GzipPool::Lease compressor) :
+    source_(source),
+    compressor_(std::move(compressor))
+{ }
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipSource::Rewind()
+{
+    source_.Rewind();
+    begun_    = false;
+    finished_ = false;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void GzipSource::Next(std::string& chunk)
+{
+    chunk.clear();
+    if (finished_) { return; }
+    if (!begun_) {
+        compressor_->Begin(chunk);
+        begun_ = true;
+    }
+
+    // An empty chunk would end the content, while deflate may hold back all
+    // of the input it is given.
+    do {
+        source_.Next(input_);
+        if (input_.empty()) {
+            compressor_->Finish(chunk);
+            finished_ = true;
+            return;
+        }
+        compressor_->Update(input_, chunk);
+    } while (chunk.empty());
+}
+
+} // namespace opengemini::impl::http
@@ -0,0 +1,132 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_HTTP_GZIP_HPP
+#define OPENGEMINI_IMPL_HTTP_GZIP_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/crc.hpp>
+
+#include "opengemini/impl/http/SourceBody.hpp"
+
+namespace opengemini::impl::http {
+
+//
+// Compresses content into gzip members (RFC 1952), with the deflate
+// implementation of Beast so that zlib is not required. The internal buffers
+// of the deflate stream are kept between members, which makes a compressor
+// worth reusing.
+//
+class GzipCompressor {
+public:
+    explicit GzipCompressor(int level);
+
+    // Starts a new member, appending its header to the output.
+    void Begin(std::string& output);
+
+    // Appends the compressed input to the output. Part of it may be held back
+    // until more input is given or the member is finished.
+    void Update(std::string_view input, std::string& output);
+
+    // Finishes the member, appending the held back data and the trailer.
+    void Finish(std::string& output);
+
+    // Appends the whole input as a single member to the output.
+    void Compress(std::string_view input, std::string& output);
+
+private:
+    void Deflate(std::string_view          input,
+                 std::string&              output,
+                 boost::beast::zlib::Flush flush);
+
+private:
+    boost::beast::zlib::deflate_stream stream_;
+    boost::crc_32_type                 crc_;
+    std::uint32_t                      size_{ 0 };
+};
+
+class GzipPool {
+public:
+    class Lease {
+    public:
+        Lease(GzipPool& pool, std::unique_ptr<GzipCompressor> compressor);
+        ~Lease();
+
+        Lease(Lease&& lease) noexcept;
+
+        GzipCompressor& operator*() noexcept { return *compressor_; }
+        GzipCompressor* operator->() noexcept { return compressor_.get(); }
+
+    private:
+        Lease(const Lease&)                = delete;
+        Lease& operator=(const Lease&)     = delete;
+        Lease& operator=(Lease&&) noexcept = delete;
+
+    private:
+        GzipPool*                       pool_;
+        std::unique_ptr<GzipCompressor> compressor_;
+    };
+
+public:
+    explicit GzipPool(int level, std::size_t maxIdle = 16);
+    ~GzipPool() = default;
+
+    Lease Acquire();
+
+private:
+    GzipPool(const GzipPool&)                = delete;
+    GzipPool(GzipPool&&) noexcept            = delete;
+    GzipPool& operator=(const GzipPool&)     = delete;
+    GzipPool& operator=(GzipPool&&) noexcept = delete;
+
+    void Release(std::unique_ptr<GzipCompressor> compressor);
+
+private:
+    std::mutex                                   mutex_;
+    std::vector<std::unique_ptr<GzipCompressor>> idle_;
+
+    const int         level_;
+    const std::size_t maxIdle_;
+};
+
+// Compresses the content of another source as a single gzip member.
+class GzipSource : public BodySource {
+public:
+    GzipSource(BodySource& source, GzipPool::Lease compressor);
+
+    void Rewind() override;
+    void Next(std::string& chunk) override;
+
+private:
+    BodySource&     source_;
+    GzipPool::Lease compressor_;
+    std::string     input_;
+    bool            begun_{ false };
+    bool            finished_{ false };
+};
+
+} // namespace opengemini::impl::http
+
+#ifndef OPENGEMINI_SEPARATE_COMPILATION
+#    include "opengemini/impl/http/Gzip.cpp"
+#endif // !OPENGEMINI_SEPARATE_COMPILATION
+
+#endif // !OPENGEMINI_IMPL_HTTP_GZIP_HPP
@@ -28,10 +28,10 @@ HttpClient::HttpClient(boost::asio::io_context&  ctx,
     pool_(ctx, connectTimeout)
 { }
 
-OPENGEMINI_INLINE_SPECIFIER
-Response HttpClient::SendRequest(const Endpoint&            endpoint,
-                                 Request                    request,
-                                 boost::asio::yield_context yield)
+template<typename REQUEST>
+Response HttpClient::Send(const Endpoint&            endpoint,
+                          REQUEST&                   request,
+                          boost::asio::yield_context yield)
 {
     namespace beast = boost::beast;
     namespace http  = boost::beast::http;
@@ -73,6 +73,38 @@ Response HttpClient::SendRequest(const Endpoint&            endpoint,
     return response;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpClient::SendRequest(const Endpoint&            endpoint,
+                                 Request&                   request,
+                                 boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpClient::SendStreamed(const Endpoint&            endpoint,
+                                  StreamedRequest&           request,
+                                  boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpClient::SendScattered(const Endpoint&            endpoint,
+                                   ScatteredRequest&          request,
+                                   boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpClient::SendShared(const Endpoint&            endpoint,
+                                SharedRequest&             request,
+                                boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 HttpClient::Pool::Pool(boost::asio::io_context&  ctx,
                        std::chrono::milliseconds connectTimeout) :
@@ -42,8 +42,22 @@ private:
 
 private:
     Response SendRequest(const Endpoint&            endpoint,
-                         Request                    request,
+                         Request&                   request,
                          boost::asio::yield_context yield) override;
+    Response SendStreamed(const Endpoint&            endpoint,
+                          StreamedRequest&           request,
+                          boost::asio::yield_context yield) override;
+    Response SendScattered(const Endpoint&            endpoint,
+                           ScatteredRequest&          request,
+                           boost::asio::yield_context yield) override;
+    Response SendShared(const Endpoint&            endpoint,
+                        SharedRequest&             request,
+                        boost::asio::yield_context yield) override;
+
+    template<typename REQUEST>
+    Response Send(const Endpoint&            endpoint,
+                  REQUEST&                   request,
+                  boost::asio::yield_context yield);
 
 private:
     Pool pool_;
@@ -55,10 +55,10 @@ HttpsClient::HttpsClient(boost::asio::io_context&  ctx,
     }
 }
 
-OPENGEMINI_INLINE_SPECIFIER
-Response HttpsClient::SendRequest(const Endpoint&            endpoint,
-                                  Request                    request,
-                                  boost::asio::yield_context yield)
+template<typename REQUEST>
+Response HttpsClient::Send(const Endpoint&            endpoint,
+                           REQUEST&                   request,
+                           boost::asio::yield_context yield)
 {
     namespace asio  = boost::asio;
     namespace beast = boost::beast;
@@ -101,6 +101,38 @@ Response HttpsClient::SendRequest(const Endpoint&            endpoint,
     return response;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpsClient::SendRequest(const Endpoint&            endpoint,
+                                  Request&                   request,
+                                  boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpsClient::SendStreamed(const Endpoint&            endpoint,
+                                   StreamedRequest&           request,
+                                   boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpsClient::SendScattered(const Endpoint&            endpoint,
+                                    ScatteredRequest&          request,
+                                    boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response HttpsClient::SendShared(const Endpoint&            endpoint,
+                                 SharedRequest&             request,
+                                 boost::asio::yield_context yield)
+{
+    return Send(endpoint, request, yield);
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 HttpsClient::Pool::Pool(boost::asio::io_context&   ctx,
                         std::chrono::milliseconds  connectTimeout,
@@ -14,6 +14,8 @@
 
 #include "opengemini/impl/http/IHttpClient.hpp"
 
+#include <optional>
+
 #include <fmt/format.h>
 
 #include "opengemini/Version.hpp"
@@ -46,7 +48,7 @@ Response IHttpClient::Get(Endpoint                   endpoint,
                                 std::move(target),
                                 {},
                                 boost::beast::http::verb::get);
-    return SendRequest(std::move(endpoint), std::move(request), yield);
+    return SendRequest(endpoint, request, yield);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
@@ -71,9 +73,10 @@ Response IHttpClient::Post(Endpoint                   endpoint,
 {
     auto request = BuildRequest(endpoint.host,
                                 std::move(target),
-                                std::move(body),
+                                {},
                                 boost::beast::http::verb::post);
-    return SendRequest(std::move(endpoint), std::move(request), yield);
+    SetBody(request, body);
+    return SendRequest(endpoint, request, yield);
 }
 
 OPENGEMINI_INLINE_SPECIFIER
@@ -91,6 +94,168 @@ catch (...) {
     return {};
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::PostBorrowed(Endpoint                   endpoint,
+                                   std::string                target,
+                                   std::string&               body,
+                                   boost::asio::yield_context yield)
+{
+    auto request = BuildRequest(endpoint.host,
+                                std::move(target),
+                                {},
+                                boost::beast::http::verb::post);
+    // A compressed body is not lent at all.
+    if (!SetBody(request, body)) {
+        return SendRequest(endpoint, request, yield);
+    }
+
+    try {
+        auto response = SendRequest(endpoint, request, yield);
+        body          = std::move(request.body());
+        return response;
+    }
+    catch (...) {
+        body = std::move(request.body());
+        throw;
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::PostScattered(Endpoint                   endpoint,
+                                    std::string                target,
+                                    std::vector<std::string>&  parts,
+                                    boost::asio::yield_context yield)
+{
+    // Compressing has to go through the parts anyway, so they are not lent.
+    if (gzip_ && BuffersBody::size(parts) >= gzipThreshold_) {
+        auto request = BuildRequest(endpoint.host,
+                                    std::move(target),
+                                    {},
+                                    boost::beast::http::verb::post);
+        Compress(request, parts);
+        return SendRequest(endpoint, request, yield);
+    }
+
+    ScatteredRequest request{ boost::beast::http::verb::post,
+                              std::move(target),
+                              httpProtocolVersion_ };
+    SetHeaders(request, endpoint.host);
+    request.body() = std::move(parts);
+    request.prepare_payload();
+    try {
+        auto response = SendScattered(endpoint, request, yield);
+        parts         = std::move(request.body());
+        return response;
+    }
+    catch (...) {
+        parts = std::move(request.body());
+        throw;
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::PostShared(
+    Endpoint                                        endpoint,
+    std::string                                     target,
+    std::shared_ptr<const std::vector<std::string>> parts,
+    boost::asio::yield_context                      yield)
+{
+    if (gzip_ && SharedBody::size(parts) >= gzipThreshold_) {
+        auto request = BuildRequest(endpoint.host,
+                                    std::move(target),
+                                    {},
+                                    boost::beast::http::verb::post);
+        Compress(request, *parts);
+        return SendRequest(endpoint, request, yield);
+    }
+
+    SharedRequest request{ boost::beast::http::verb::post,
+                           std::move(target),
+                           httpProtocolVersion_ };
+    SetHeaders(request, endpoint.host);
+    request.body() = std::move(parts);
+    request.prepare_payload();
+    return SendShared(endpoint, request, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::PostStreamed(Endpoint                   endpoint,
+                                   std::string                target,
+                                   BodySource&                source,
+                                   boost::asio::yield_context yield)
+{
+    StreamedRequest request{ boost::beast::http::verb::post,
+                             std::move(target),
+                             httpProtocolVersion_ };
+    SetHeaders(request, endpoint.host);
+    request.chunked(true);
+    request.body().source = &source;
+
+    std::optional<GzipSource> compressed;
+    if (gzip_) {
+        request.body().source = &compressed.emplace(source, gzip_->Acquire());
+        request.set(boost::beast::http::field::content_encoding, "gzip");
+    }
+
+    try {
+        return SendStreamed(endpoint, request, yield);
+    }
+    catch (...) {
+        if (auto& error = request.body().error) {
+            std::rethrow_exception(error);
+        }
+        throw;
+    }
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::SendStreamed(const Endpoint&            endpoint,
+                                   StreamedRequest&           request,
+                                   boost::asio::yield_context yield)
+{
+    auto&       source = *request.body().source;
+    std::string body;
+    std::string chunk;
+    source.Rewind();
+    for (source.Next(chunk); !chunk.empty(); source.Next(chunk)) {
+        body.append(chunk);
+    }
+
+    Request whole{ std::move(request.base()), std::move(body) };
+    whole.prepare_payload();
+    return SendRequest(endpoint, whole, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::SendScattered(const Endpoint&            endpoint,
+                                    ScatteredRequest&          request,
+                                    boost::asio::yield_context yield)
+{
+    std::string body;
+    body.reserve(BuffersBody::size(request.body()));
+    for (auto& part : request.body()) { body.append(part); }
+
+    Request whole{ std::move(request.base()), std::move(body) };
+    whole.prepare_payload();
+    return SendRequest(endpoint, whole, yield);
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+Response IHttpClient::SendShared(const Endpoint&            endpoint,
+                                 SharedRequest&             request,
+                                 boost::asio::yield_context yield)
+{
+    std::string body;
+    body.reserve(SharedBody::size(request.body()));
+    if (auto& parts = request.body()) {
+        for (auto& part : *parts) { body.append(part); }
+    }
+
+    Request whole{ std::move(request.base()), std::move(body) };
+    whole.prepare_payload();
+    return SendRequest(endpoint, whole, yield);
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 std::unordered_map<std::string, std::string>&
 IHttpClient::DefaultHeaders() noexcept
@@ -98,6 +263,13 @@ IHttpClient::DefaultHeaders() noexcept
     return headers_;
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+void IHttpClient::EnableGzip(int level, std::size_t threshold)
+{
+    gzip_          = std::make_unique<GzipPool>(level);
+    gzipThreshold_ = threshold;
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 Request IHttpClient::BuildRequest(std::string              host,
                                   std::string              target,
@@ -108,14 +280,50 @@ Request IHttpClient::BuildRequest(std::string              host,
                      std::move(target),
                      httpProtocolVersion_ };
     request.body() = std::move(body);
+    SetHeaders(request, std::move(host));
+    request.prepare_payload();
+
+    return request;
+}
+
+OPENGEMINI_INLINE_SPECIFIER
+void IHttpClient::SetHeaders(boost::beast::http::fields& fields,
+                             std::string                 host) const
+{
     for (const auto& header : headers_) {
-        request.set(header.first, header.second);
+        fields.set(header.first, header.second);
+    }
+    fields.set(boost::beast::http::field::host, std::move(host));
+    fields.set(boost::beast::http::field::user_agent, userAgent_);
+}
+
+// Returns whether the body is moved into the request, rather than compressed
+// into it and left untouched.
+OPENGEMINI_INLINE_SPECIFIER
+bool IHttpClient::SetBody(Request& request, std::string& body) const
+{
+    auto moved = !gzip_ || body.size() < gzipThreshold_;
+    if (!moved) {
+        Compress(request, { &body, 1 });
+        return moved;
     }
-    request.set(boost::beast::http::field::host, std::move(host));
-    request.set(boost::beast::http::field::user_agent, userAgent_);
+
+    request.body() = std::move(body);
     request.prepare_payload();
+    return moved;
+}
 
-    return request;
+OPENGEMINI_INLINE_SPECIFIER
+void IHttpClient::Compress(Request&                       request,
+                           boost::span<const std::string> parts) const
+{
+    auto compressor = gzip_->Acquire();
+    compressor->Begin(request.body());
+    for (auto& part : parts) { compressor->Update(part, request.body()); }
+    compressor->Finish(request.body());
+
+    request.set(boost::beast::http::field::content_encoding, "gzip");
+    request.prepare_payload();
 }
 
 } // namespace opengemini::impl::http
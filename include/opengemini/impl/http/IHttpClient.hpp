@@ -16,20 +16,30 @@
 #define OPENGEMINI_IMPL_HTTP_IHTTPCLIENT_HPP
 
 #include <chrono>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/asio/spawn.hpp>
 #include <boost/beast.hpp>
+#include <boost/core/span.hpp>
 
 #include "opengemini/Endpoint.hpp"
 #include "opengemini/Error.hpp"
 #include "opengemini/impl/comm/TaskSlot.hpp"
+#include "opengemini/impl/http/BuffersBody.hpp"
+#include "opengemini/impl/http/Gzip.hpp"
+#include "opengemini/impl/http/SharedBody.hpp"
+#include "opengemini/impl/http/SourceBody.hpp"
 
 namespace opengemini::impl::http {
 
 using Status   = boost::beast::http::status;
 using Request  = boost::beast::http::request<boost::beast::http::string_body>;
 using Response = boost::beast::http::response<boost::beast::http::string_body>;
+using StreamedRequest  = boost::beast::http::request<SourceBody>;
+using ScatteredRequest = boost::beast::http::request<BuffersBody>;
+using SharedRequest    = boost::beast::http::request<SharedBody>;
 
 class IHttpClient : public TaskSlot {
 public:
@@ -59,18 +69,77 @@ public:
                   boost::asio::yield_context yield,
                   Error&                     error);
 
+    // The body is lent to the request and handed back once the request
+    // completes (or fails), so that its storage can be reused by the caller.
+    Response PostBorrowed(Endpoint                   endpoint,
+                          std::string                target,
+                          std::string&               body,
+                          boost::asio::yield_context yield);
+
+    // The body is the concatenation of the parts, which are lent to the
+    // request like a borrowed body. They are written to the socket as they
+    // are, without being concatenated.
+    Response PostScattered(Endpoint                   endpoint,
+                           std::string                target,
+                           std::vector<std::string>&  parts,
+                           boost::asio::yield_context yield);
+
+    // The body is the concatenation of the parts, which are shared with other
+    // requests and never modified, so that the same content can be posted to
+    // several servers concurrently.
+    Response
+    PostShared(Endpoint                                        endpoint,
+               std::string                                     target,
+               std::shared_ptr<const std::vector<std::string>> parts,
+               boost::asio::yield_context                      yield);
+
+    // The body is produced by the source while it is being sent, with the
+    // chunked transfer coding, so that it is never held as a whole. Errors of
+    // the source are rethrown as they are.
+    Response PostStreamed(Endpoint                   endpoint,
+                          std::string                target,
+                          BodySource&                source,
+                          boost::asio::yield_context yield);
+
     std::unordered_map<std::string, std::string>& DefaultHeaders() noexcept;
 
+    // Posted bodies of at least the threshold size, and all of the streamed
+    // ones, are sent compressed with gzip at the given level.
+    void EnableGzip(int level, std::size_t threshold);
+
 protected:
     virtual Response SendRequest(const Endpoint&            endpoint,
-                                 Request                    request,
+                                 Request&                   request,
                                  boost::asio::yield_context yield) = 0;
 
+    // Sends the whole body at once by default, for clients which cannot
+    // stream it.
+    virtual Response SendStreamed(const Endpoint&            endpoint,
+                                  StreamedRequest&           request,
+                                  boost::asio::yield_context yield);
+
+    // Concatenates the parts by default, for clients which cannot write them
+    // as they are.
+    virtual Response SendScattered(const Endpoint&            endpoint,
+                                   ScatteredRequest&          request,
+                                   boost::asio::yield_context yield);
+
+    // Concatenates the parts by default, for clients which cannot write them
+    // as they are.
+    virtual Response SendShared(const Endpoint&            endpoint,
+                                SharedRequest&             request,
+                                boost::asio::yield_context yield);
+
 private:
     Request BuildRequest(std::string              host,
                          std::string              target,
                          std::string              body,
                          boost::beast::http::verb method) const;
+    void    SetHeaders(boost::beast::http::fields& fields,
+                       std::string                 host) const;
+    bool    SetBody(Request& request, std::string& body) const;
+    void    Compress(Request&                       request,
+                     boost::span<const std::string> parts) const;
 
 protected:
     const std::chrono::milliseconds connectTimeout_;
@@ -78,6 +147,8 @@ protected:
 
 private:
     std::unordered_map<std::string, std::string> headers_;
+    std::unique_ptr<GzipPool>                    gzip_;
+    std::size_t                                  gzipThreshold_{ 0 };
 
     const std::string     userAgent_;
     static constexpr auto httpProtocolVersion_{ 11 };
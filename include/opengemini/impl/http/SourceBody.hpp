@@ -0,0 +1,103 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENGEMINI_IMPL_HTTP_SOURCEBODY_HPP
+#define OPENGEMINI_IMPL_HTTP_SOURCEBODY_HPP
+
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+
+namespace opengemini::impl::http {
+
+// Produces the content of a body part by part.
+class BodySource {
+public:
+    virtual ~BodySource() = default;
+
+    // Restarts from the beginning of the content, since the request may be
+    // sent again on another connection.
+    virtual void Rewind() = 0;
+
+    // Replaces the chunk with the next part of the content, which is left
+    // empty once the content is exhausted.
+    virtual void Next(std::string& chunk) = 0;
+};
+
+//
+// A body produced by a BodySource while it is being sent with the chunked
+// transfer coding, so that only one chunk of it is held at a time. Errors of
+// the source cannot propagate through the serializer, so they fail the write
+// and are kept to be rethrown instead.
+//
+struct SourceBody {
+    struct value_type {
+        BodySource*        source{ nullptr };
+        std::exception_ptr error;
+    };
+
+    class writer {
+    public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template<bool IS_REQUEST, typename FIELDS>
+        writer(boost::beast::http::header<IS_REQUEST, FIELDS>&,
+               value_type& body) :
+            body_(body)
+        { }
+
+        void init(boost::beast::error_code& error)
+        {
+            error.clear();
+            Invoke(error, [this] { body_.source->Rewind(); });
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(boost::beast::error_code& error)
+        {
+            error.clear();
+            Invoke(error, [this] { body_.source->Next(chunk_); });
+            if (error || chunk_.empty()) { return boost::none; }
+            return std::make_pair(
+                const_buffers_type(chunk_.data(), chunk_.size()),
+                true);
+        }
+
+    private:
+        template<typename FUNCTION>
+        void Invoke(boost::beast::error_code& error, const FUNCTION& func)
+        {
+            try {
+                func();
+            }
+            catch (...) {
+                body_.error = std::current_exception();
+                error       = boost::asio::error::operation_aborted;
+            }
+        }
+
+    private:
+        value_type& body_;
+        std::string chunk_;
+    };
+};
+
+} // namespace opengemini::impl::http
+
+#endif // !OPENGEMINI_IMPL_HTTP_SOURCEBODY_HPP
@@ -14,6 +14,7 @@
 
 #include "opengemini/impl/lb/LoadBalancer.hpp"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include <fmt/format.h>
@@ -84,6 +85,18 @@ const Endpoint& LoadBalancer::PickAvailableServer()
     throw Exception(errc::ServerErrors::NoAvailableServer);
 }
 
+OPENGEMINI_INLINE_SPECIFIER
+std::size_t LoadBalancer::CountAvailableServers() const
+{
+    auto available = std::count_if(servers_.begin(),
+                                   servers_.end(),
+                                   [](const Server& server) {
+                                       return server.good.load(
+                                           std::memory_order_relaxed);
+                                   });
+    return static_cast<std::size_t>(available);
+}
+
 OPENGEMINI_INLINE_SPECIFIER
 void LoadBalancer::HealthCheck(boost::asio::yield_context yield)
 {
@@ -55,6 +55,7 @@ public:
 
     const Endpoint& PickServer(std::size_t index) const;
     const Endpoint& PickAvailableServer();
+    std::size_t     CountAvailableServers() const;
 
 private:
     struct Server {
@@ -0,0 +1,85 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_BENCHMARK_STANDINSERVER_HPP
+#define TEST_BENCHMARK_STANDINSERVER_HPP
+
+#include <limits>
+
+#include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/beast/http.hpp>
+
+#include "opengemini/Endpoint.hpp"
+
+namespace opengemini::benchmark {
+
+// A stand-in for the server on the loopback interface, which accepts any
+// request without looking at its body.
+class StandInServer {
+public:
+    explicit StandInServer(boost::asio::io_context& ctx) :
+        acceptor_(ctx, { boost::asio::ip::make_address("127.0.0.1"), 0 })
+    {
+        boost::asio::spawn(acceptor_.get_executor(), [this](auto yield) {
+            boost::beast::error_code error;
+            while (!error) {
+                boost::asio::ip::tcp::socket socket(acceptor_.get_executor());
+                acceptor_.async_accept(socket, yield[error]);
+                if (!error) { Serve(std::move(socket)); }
+            }
+        });
+    }
+
+    ~StandInServer() { acceptor_.close(); }
+
+    Endpoint GetEndpoint() const
+    {
+        return { "127.0.0.1", acceptor_.local_endpoint().port() };
+    }
+
+private:
+    void Serve(boost::asio::ip::tcp::socket socket)
+    {
+        boost::asio::spawn(
+            socket.get_executor(),
+            [socket = std::move(socket)](auto yield) mutable {
+                namespace http = boost::beast::http;
+
+                boost::beast::flat_buffer buffer;
+                boost::beast::error_code  error;
+                for (;;) {
+                    http::request_parser<http::string_body> parser;
+                    parser.body_limit(
+                        std::numeric_limits<std::uint64_t>::max());
+                    http::async_read(socket, buffer, parser, yield[error]);
+                    if (error) { return; }
+
+                    http::response<http::empty_body> response{
+                        http::status::no_content,
+                        parser.get().version()
+                    };
+                    http::async_write(socket, response, yield[error]);
+                    if (error) { return; }
+                }
+            });
+    }
+
+private:
+    boost::asio::ip::tcp::acceptor acceptor_;
+};
+
+} // namespace opengemini::benchmark
+
+#endif // !TEST_BENCHMARK_STANDINSERVER_HPP
@@ -0,0 +1,101 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <future>
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/cli/write/Batcher.hpp"
+#include "opengemini/impl/comm/Context.hpp"
+#include "opengemini/impl/http/HttpClient.hpp"
+
+#include "StandInServer.hpp"
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+using namespace std::chrono_literals;
+
+// Writes small points one at a time, each either sent as its own request (0)
+// or gathered into batches of the given size. Every iteration waits for all of
+// the writes to complete.
+static void BM_WriteSmallPoints(::benchmark::State& state)
+{
+    constexpr std::size_t writes = 1000;
+
+    const auto    batchSize = static_cast<std::size_t>(state.range(0));
+    Context       ctx(2);
+    StandInServer server(ctx());
+
+    auto http = std::make_shared<http::HttpClient>(ctx(), 5s, 5s);
+    auto lb   = lb::LoadBalancer::Construct(ctx(),
+                                          std::vector{ server.GetEndpoint() },
+                                          http);
+    BufferPool        buffers;
+    cli::WriteOptions options{ 0, ctx.Concurrency(), 0, false };
+    cli::Functor      functor{ *http, *lb };
+
+    std::shared_ptr<cli::Batcher> batcher;
+    if (batchSize != 0) {
+        batcher = cli::Batcher::Construct(ctx(),
+                                          functor,
+                                          buffers,
+                                          options,
+                                          BatchConfig{ 1s, batchSize });
+    }
+
+    for (auto _ : state) {
+        std::atomic<std::size_t> pending{ writes };
+        std::promise<void>       done;
+
+        auto complete = [&pending, &done](std::exception_ptr) {
+            if (pending.fetch_sub(1) == 1) { done.set_value(); }
+        };
+
+        for (std::size_t idx = 0; idx < writes; ++idx) {
+            Point point{ "cpu_usage",
+                         { { "usage_user", 12.5 } },
+                         Point::Time{ std::chrono::seconds(idx) },
+                         { { "host", "server-0001" } } };
+            if (batcher) {
+                batcher->Enqueue("test_db_cxx",
+                                 "",
+                                 cli::EncodeEagerly(buffers, point),
+                                 1,
+                                 complete);
+                continue;
+            }
+            boost::asio::spawn(ctx(),
+                               cli::RunWrite<Point>{ functor,
+                                                     buffers,
+                                                     options,
+                                                     "test_db_cxx",
+                                                     "",
+                                                     std::move(point) },
+                               complete);
+        }
+        done.get_future().get();
+    }
+
+    state.SetItemsProcessed(state.iterations() * writes);
+}
+BENCHMARK(BM_WriteSmallPoints)
+    ->Arg(0)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace opengemini::benchmark
@@ -0,0 +1,98 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "opengemini/impl/comm/Context.hpp"
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+
+namespace {
+
+std::vector<Point> GeneratePoints(std::size_t num)
+{
+    std::vector<Point> points;
+    points.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        points.push_back({ "cpu_usage",
+                           { { "usage_user", 12.345678901234 + idx },
+                             { "usage_system", 3.1415926 },
+                             { "procs", static_cast<int64_t>(idx) },
+                             { "uptime", static_cast<uint64_t>(idx) * 1000 },
+                             { "healthy", true },
+                             { "status", "running, \"ok\"" } },
+                           Point::Time{ std::chrono::seconds(1700000000) +
+                                        std::chrono::nanoseconds(idx) },
+                           { { "host", "server-0001" },
+                             { "region", "cn-north 1" },
+                             { "rack", "r=12" } } });
+    }
+    return points;
+}
+
+} // namespace
+
+// Encodes a large vector split into one chunk per thread of the context, the
+// single-threaded case is the serial encoding which the others scale against.
+static void BM_EncodePointsInParallel(::benchmark::State& state)
+{
+    const auto points  = GeneratePoints(state.range(0));
+    const auto threads = static_cast<std::size_t>(state.range(1));
+    Context    ctx(threads);
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        std::vector<BufferPool::Lease> parts;
+        boost::asio::spawn(
+            ctx(),
+            [&](auto yield) {
+                if (threads == 1) {
+                    auto& content = parts.emplace_back(buffers.Acquire());
+                    enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+                    return;
+                }
+                cli::EncodeInParallel(parts,
+                                      boost::span<const Point>(points),
+                                      Precision::Nanosecond,
+                                      threads,
+                                      buffers,
+                                      yield);
+            },
+            boost::asio::use_future)
+            .get();
+        bytes = 0;
+        for (auto& part : parts) { bytes += part->size(); }
+        ::benchmark::DoNotOptimize(parts.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["threads"] = static_cast<double>(ctx.Concurrency());
+}
+BENCHMARK(BM_EncodePointsInParallel)
+    ->ArgsProduct({ { 500000 },
+                    ::benchmark::CreateRange(
+                        1,
+                        std::max(std::thread::hardware_concurrency(), 1u),
+                        2) })
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace opengemini::benchmark
@@ -0,0 +1,176 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/cli/write/Batcher.hpp"
+#include "opengemini/impl/comm/Context.hpp"
+#include "opengemini/impl/comm/MpscRing.hpp"
+#include "opengemini/impl/http/HttpClient.hpp"
+
+#include "StandInServer.hpp"
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+using namespace std::chrono_literals;
+
+namespace {
+
+// The queue the ring replaces, a deque guarded by a mutex.
+template<typename T>
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t capacity) : capacity_(capacity) { }
+
+    bool TryPush(T& value)
+    {
+        std::lock_guard lock(mutex_);
+        if (queue_.size() == capacity_) { return false; }
+        queue_.push_back(std::move(value));
+        return true;
+    }
+
+    bool TryPop(T& value)
+    {
+        std::lock_guard lock(mutex_);
+        if (queue_.empty()) { return false; }
+        value = std::move(queue_.front());
+        queue_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex    mutex_;
+    std::deque<T> queue_;
+    std::size_t   capacity_;
+};
+
+// A queue shared by the producer threads of a benchmark, emptied by a consumer
+// thread of its own.
+template<typename QUEUE>
+class Consumed {
+public:
+    Consumed() :
+        consumer_([this] {
+            std::size_t value{ 0 };
+            while (running_.load(std::memory_order_relaxed)) {
+                if (!queue.TryPop(value)) { std::this_thread::yield(); }
+            }
+        })
+    { }
+
+    ~Consumed()
+    {
+        running_ = false;
+        consumer_.join();
+    }
+
+    QUEUE queue{ 1024 };
+
+private:
+    std::atomic<bool> running_{ true };
+    std::thread       consumer_;
+};
+
+template<typename QUEUE>
+std::unique_ptr<Consumed<QUEUE>> shared;
+
+} // namespace
+
+// Pushes from every thread of the benchmark into one queue, either the ring or
+// the locked queue.
+template<typename QUEUE>
+static void BM_Submit(::benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        shared<QUEUE> = std::make_unique<Consumed<QUEUE>>();
+    }
+
+    for (auto _ : state) {
+        std::size_t value{ 42 };
+        while (!shared<QUEUE>->queue.TryPush(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (state.thread_index() == 0) { shared<QUEUE>.reset(); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Submit, MpscRing<std::size_t>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Submit, LockedQueue<std::size_t>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+namespace {
+
+struct Client {
+    Client() :
+        ctx(2),
+        server(ctx()),
+        http(std::make_shared<http::HttpClient>(ctx(), 5s, 5s)),
+        lb(lb::LoadBalancer::Construct(ctx(),
+                                       std::vector{ server.GetEndpoint() },
+                                       http)),
+        batcher(cli::Batcher::Construct(ctx(),
+                                        cli::Functor{ *http, *lb },
+                                        buffers,
+                                        options,
+                                        BatchConfig{ 1s, 10000 }))
+    { }
+
+    ~Client() { batcher->Close(); }
+
+    BufferPool                        buffers;
+    cli::WriteOptions                 options{ 0, 2, 0, false };
+    Context                           ctx;
+    StandInServer                     server;
+    std::shared_ptr<http::HttpClient> http;
+    std::shared_ptr<lb::LoadBalancer> lb;
+    std::shared_ptr<cli::Batcher>     batcher;
+};
+
+std::unique_ptr<Client> client;
+
+} // namespace
+
+// Submits a point from every thread of the benchmark to the batcher, which
+// sends batches of 10000 points to the loopback stand-in server.
+static void BM_SubmitToBatcher(::benchmark::State& state)
+{
+    if (state.thread_index() == 0) { client = std::make_unique<Client>(); }
+
+    for (auto _ : state) {
+        client->batcher->Enqueue(
+            "test_db_cxx",
+            "",
+            cli::PrepareRawLines(client->buffers, { "cpu,host=a usage=1\n" }),
+            1,
+            [](std::exception_ptr) { });
+    }
+
+    if (state.thread_index() == 0) { client.reset(); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SubmitToBatcher)->ThreadRange(1, 64)->UseRealTime();
+
+} // namespace opengemini::benchmark
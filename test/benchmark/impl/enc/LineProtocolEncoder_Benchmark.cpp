@@ -0,0 +1,461 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/comm/BufferPool.hpp"
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+
+namespace {
+
+// Counts the heap allocations made by the benchmarks.
+std::atomic<std::size_t> allocations{ 0 };
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto* ptr = std::malloc(size); ptr) { return ptr; }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace opengemini::benchmark {
+
+struct CpuUsage {
+    std::string host;
+    std::string region;
+    std::string rack;
+    double      usageUser;
+    double      usageSystem;
+    int64_t     procs;
+    uint64_t    uptime;
+    bool        healthy;
+    std::string status;
+    Point::Time time;
+};
+
+} // namespace opengemini::benchmark
+
+template<>
+struct opengemini::MeasurementTraits<opengemini::benchmark::CpuUsage> {
+    using T = opengemini::benchmark::CpuUsage;
+
+    static constexpr auto measurement = schema::Measurement("cpu_usage");
+    static constexpr auto tags =
+        std::make_tuple(schema::Tag("host", &T::host),
+                        schema::Tag("rack", &T::rack),
+                        schema::Tag("region", &T::region));
+    static constexpr auto fields =
+        std::make_tuple(schema::Field("healthy", &T::healthy),
+                        schema::Field("procs", &T::procs),
+                        schema::Field("status", &T::status),
+                        schema::Field("uptime", &T::uptime),
+                        schema::Field("usage_system", &T::usageSystem),
+                        schema::Field("usage_user", &T::usageUser));
+    static constexpr auto time = &T::time;
+};
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+
+namespace {
+
+std::vector<Point> GeneratePoints(std::size_t num)
+{
+    std::vector<Point> points;
+    points.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        points.push_back({ "cpu_usage",
+                           { { "usage_user", 12.345678901234 + idx },
+                             { "usage_system", 3.1415926 },
+                             { "procs", static_cast<int64_t>(idx) },
+                             { "uptime", static_cast<uint64_t>(idx) * 1000 },
+                             { "healthy", true },
+                             { "status", "running, \"ok\"" } },
+                           Point::Time{ std::chrono::seconds(1700000000) +
+                                        std::chrono::nanoseconds(idx) },
+                           { { "host", "server-0001" },
+                             { "region", "cn-north 1" },
+                             { "rack", "r=12" } } });
+    }
+    return points;
+}
+
+std::vector<CpuUsage> GenerateMeasurements(std::size_t num)
+{
+    std::vector<CpuUsage> measurements;
+    measurements.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        measurements.push_back({ "server-0001",
+                                 "cn-north 1",
+                                 "r=12",
+                                 12.345678901234 + idx,
+                                 3.1415926,
+                                 static_cast<int64_t>(idx),
+                                 static_cast<uint64_t>(idx) * 1000,
+                                 true,
+                                 "running, \"ok\"",
+                                 Point::Time{
+                                     std::chrono::seconds(1700000000) +
+                                     std::chrono::nanoseconds(idx) } });
+    }
+    return measurements;
+}
+
+// Points of a fixed set of series, each of them carries many tags.
+std::vector<Point> GenerateTagHeavyPoints(std::size_t num, bool withSeriesKey)
+{
+    constexpr std::size_t SERIES_NUM{ 100 };
+
+    std::vector<std::map<std::string, std::string>> tagSets;
+    std::vector<SeriesKey>                          seriesKeys;
+    for (std::size_t idx = 0; idx < SERIES_NUM; ++idx) {
+        auto& tags = tagSets.emplace_back();
+        tags.emplace("host", "server-" + std::to_string(idx));
+        tags.emplace("region", "cn-north 1");
+        tags.emplace("zone", "cn-north-1a");
+        tags.emplace("rack", "r=12");
+        tags.emplace("service", "ingest,api");
+        tags.emplace("team", "storage");
+        tags.emplace("os", "linux 6.1");
+        tags.emplace("arch", "x86_64");
+        seriesKeys.emplace_back("cpu_usage", tags);
+    }
+
+    std::vector<Point> points;
+    points.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        auto& point = points.emplace_back();
+        point.fields.emplace("usage_user", 12.345678901234 + idx);
+        point.time = Point::Time{ std::chrono::seconds(1700000000) +
+                                  std::chrono::nanoseconds(idx) };
+        if (withSeriesKey) {
+            point.series = seriesKeys[idx % SERIES_NUM];
+        }
+        else {
+            point.measurement = "cpu_usage";
+            point.tags        = tagSets[idx % SERIES_NUM];
+        }
+    }
+    return points;
+}
+
+// A typical point with 5 tags and 5 fields, all keys and values fit in the
+// small-string buffer.
+template<typename POINT>
+POINT MakeTypicalPoint(std::size_t idx)
+{
+    POINT point;
+    point.measurement = "cpu_usage";
+    point.fields.emplace("usage_user", 12.345678901234 + idx);
+    point.fields.emplace("usage_system", 3.1415926);
+    point.fields.emplace("procs", static_cast<int64_t>(idx));
+    point.fields.emplace("healthy", true);
+    point.fields.emplace("status", "running");
+    point.time = Point::Time{ std::chrono::seconds(1700000000) +
+                              std::chrono::nanoseconds(idx) };
+    point.tags.emplace("host", "server-0001");
+    point.tags.emplace("region", "cn-north 1");
+    point.tags.emplace("zone", "cn-north-1a");
+    point.tags.emplace("rack", "r=12");
+    point.tags.emplace("os", "linux");
+    return point;
+}
+
+PointBatch GeneratePointBatch(std::size_t num)
+{
+    std::vector<double>      usageUser;
+    std::vector<int64_t>     procs;
+    std::vector<uint64_t>    uptime;
+    std::vector<std::string> status;
+    PointBatch               batch{ "cpu_usage",
+                                    {},
+                                    {},
+                                    { { "host", "server-0001" },
+                                      { "region", "cn-north 1" },
+                                      { "rack", "r=12" } } };
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        usageUser.push_back(12.345678901234 + idx);
+        procs.push_back(static_cast<int64_t>(idx));
+        uptime.push_back(static_cast<uint64_t>(idx) * 1000);
+        status.push_back("running, \"ok\"");
+        batch.times.push_back(Point::Time{ std::chrono::seconds(1700000000) +
+                                           std::chrono::nanoseconds(idx) });
+    }
+    batch.fields.emplace("usage_user", std::move(usageUser));
+    batch.fields.emplace("usage_system", std::vector<double>(num, 3.1415926));
+    batch.fields.emplace("procs", std::move(procs));
+    batch.fields.emplace("uptime", std::move(uptime));
+    batch.fields.emplace("healthy", std::vector<bool>(num, true));
+    batch.fields.emplace("status", std::move(status));
+    return batch;
+}
+
+} // namespace
+
+static void BM_EncodePoints(::benchmark::State& state)
+{
+    const auto points = GeneratePoints(state.range(0));
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = enc::LineProtocolEncoder{}.Encode(points);
+        bytes        = content.size();
+        ::benchmark::DoNotOptimize(content);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_EncodePoints)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_EncodePointsPooled(::benchmark::State& state)
+{
+    const auto points = GeneratePoints(state.range(0));
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_EncodePointsPooled)->Arg(1000)->Arg(10000)->Arg(100000);
+
+
+// Builds and encodes the points in every iteration, which is what a writer
+// pays for each write.
+template<typename POINT>
+static void BM_BuildAndEncodePoints(::benchmark::State& state)
+{
+    const auto num = static_cast<std::size_t>(state.range(0));
+    BufferPool buffers;
+
+    std::size_t allocated{ 0 };
+    for (auto _ : state) {
+        const auto before = allocations.load(std::memory_order_relaxed);
+
+        std::vector<POINT> points;
+        points.reserve(num);
+        for (std::size_t idx = 0; idx < num; ++idx) {
+            points.push_back(MakeTypicalPoint<POINT>(idx));
+        }
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        ::benchmark::DoNotOptimize(content->data());
+
+        allocated += allocations.load(std::memory_order_relaxed) - before;
+    }
+
+    state.SetItemsProcessed(state.iterations() * num);
+    state.counters["allocs_per_point"] = ::benchmark::Counter(
+        static_cast<double>(allocated) / (state.iterations() * num));
+}
+BENCHMARK_TEMPLATE(BM_BuildAndEncodePoints, Point)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_BuildAndEncodePoints, FlatPoint)->Arg(10000);
+
+// Same points as above, but the strings are owned by the caller, as in a
+// collector which keeps them in long-lived buffers, so only views are built.
+static void BM_BuildAndEncodePointViews(::benchmark::State& state)
+{
+    static const std::array<PointView::TagView, 5> tags{
+        { { "host", "server-0001" },
+          { "os", "linux" },
+          { "rack", "r=12" },
+          { "region", "cn-north 1" },
+          { "zone", "cn-north-1a" } }
+    };
+
+    const auto num = static_cast<std::size_t>(state.range(0));
+    BufferPool buffers;
+
+    std::size_t allocated{ 0 };
+    for (auto _ : state) {
+        const auto before = allocations.load(std::memory_order_relaxed);
+
+        std::vector<std::array<PointView::FieldView, 5>> fields;
+        std::vector<PointView>                           points;
+        fields.reserve(num);
+        points.reserve(num);
+        for (std::size_t idx = 0; idx < num; ++idx) {
+            fields.push_back({ { { "healthy", true },
+                                 { "procs", static_cast<int64_t>(idx) },
+                                 { "status", "running" },
+                                 { "usage_system", 3.1415926 },
+                                 { "usage_user", 12.345678901234 + idx } } });
+            points.push_back(
+                { "cpu_usage",
+                  fields.back(),
+                  Point::Time{ std::chrono::seconds(1700000000) +
+                               std::chrono::nanoseconds(idx) },
+                  tags });
+        }
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        ::benchmark::DoNotOptimize(content->data());
+
+        allocated += allocations.load(std::memory_order_relaxed) - before;
+    }
+
+    state.SetItemsProcessed(state.iterations() * num);
+    state.counters["allocs_per_point"] = ::benchmark::Counter(
+        static_cast<double>(allocated) / (state.iterations() * num));
+}
+BENCHMARK(BM_BuildAndEncodePointViews)->Arg(10000);
+
+template<typename POINT>
+static void BM_EncodeTypicalPoints(::benchmark::State& state)
+{
+    std::vector<POINT> points;
+    for (std::int64_t idx = 0; idx < state.range(0); ++idx) {
+        points.push_back(MakeTypicalPoint<POINT>(idx));
+    }
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK_TEMPLATE(BM_EncodeTypicalPoints, Point)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_EncodeTypicalPoints, FlatPoint)->Arg(10000);
+
+static void BM_EncodeTagHeavyPoints(::benchmark::State& state)
+{
+    const auto points = GenerateTagHeavyPoints(state.range(0), state.range(1));
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_EncodeTagHeavyPoints)
+    ->ArgNames({ "points", "series_key" })
+    ->ArgsProduct({ { 10000 }, { false, true } });
+
+static void BM_EncodePointBatch(::benchmark::State& state)
+{
+    const auto batch = GeneratePointBatch(state.range(0));
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, batch);
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_EncodePointBatch)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_EncodeMeasurements(::benchmark::State& state)
+{
+    const auto measurements = GenerateMeasurements(state.range(0));
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        enc::LineProtocolEncoder{}.EncodeTo(*content, measurements);
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_EncodeMeasurements)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Body size and encoding time for each precision, the timestamps being
+// converted either for every point or once for the whole batch as it is done
+// when writing.
+static void BM_EncodePointsPerPrecision(::benchmark::State& state)
+{
+    const auto precision = static_cast<Precision>(state.range(1));
+    const auto perBatch  = state.range(2) != 0;
+
+    auto points = GeneratePoints(state.range(0));
+    for (auto& point : points) { point.precision = precision; }
+    BufferPool buffers;
+
+    std::size_t bytes{ 0 };
+    for (auto _ : state) {
+        auto content = buffers.Acquire();
+        if (perBatch) {
+            enc::LineProtocolEncoder{}.EncodeTo(
+                *content,
+                boost::span<const Point>(points),
+                precision);
+        }
+        else {
+            enc::LineProtocolEncoder{}.EncodeTo(*content, points);
+        }
+        bytes = content->size();
+        ::benchmark::DoNotOptimize(content->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["body_bytes"] = static_cast<double>(bytes);
+    state.counters["bytes_per_point"] =
+        static_cast<double>(bytes) / state.range(0);
+}
+BENCHMARK(BM_EncodePointsPerPrecision)
+    ->ArgNames({ "points", "precision", "per_batch" })
+    ->ArgsProduct({ { 10000 },
+                    ::benchmark::CreateDenseRange(
+                        static_cast<int64_t>(Precision::Nanosecond),
+                        static_cast<int64_t>(Precision::Hour),
+                        1),
+                    { false, true } });
+
+} // namespace opengemini::benchmark
@@ -0,0 +1,91 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+#include "opengemini/impl/enc/SeriesOrder.hpp"
+#include "opengemini/impl/http/Gzip.hpp"
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+
+namespace {
+
+// Points of 64 hosts arriving interleaved, as collected from many sources.
+std::vector<Point> GenerateInterleavedPoints(std::size_t num)
+{
+    std::vector<Point> points;
+    points.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        auto host = static_cast<int64_t>(idx % 64);
+        auto tick = static_cast<int64_t>(idx / 64);
+        points.push_back({ "cpu_usage",
+                           { { "usage_user", 10.0 + host + tick % 8 * 0.25 },
+                             { "usage_system", 3.0 + host % 4 * 0.5 },
+                             { "procs", 200 + host * 3 + tick % 4 },
+                             { "status", "running" } },
+                           Point::Time{ std::chrono::seconds(1700000000) +
+                                        std::chrono::seconds(tick) },
+                           { { "host", "server-" + std::to_string(host) },
+                             { "region", "cn-north-1" } } });
+    }
+    return points;
+}
+
+} // namespace
+
+static void BM_OrderBySeries(::benchmark::State& state)
+{
+    auto points = GenerateInterleavedPoints(state.range(0));
+    for (auto _ : state) {
+        auto order = enc::OrderBySeries(boost::span<const Point>(points));
+        ::benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OrderBySeries)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Encodes the points in arrival order (0) or sorted by series and time (1).
+// The gzipped size of the body stands in for the columnar compression the
+// server gains from receiving the points of each series together.
+static void BM_EncodeSortedBySeries(::benchmark::State& state)
+{
+    auto                     points = GenerateInterleavedPoints(10000);
+    boost::span<const Point> span(points);
+    enc::LineProtocolEncoder encoder;
+    std::string              content;
+    for (auto _ : state) {
+        content.clear();
+        if (state.range(0)) {
+            auto order = enc::OrderBySeries(span);
+            encoder.EncodeTo(content,
+                             enc::OrderedPoints<Point>(span, order),
+                             Precision::Nanosecond);
+        }
+        else {
+            encoder.EncodeTo(content, span, Precision::Nanosecond);
+        }
+        ::benchmark::DoNotOptimize(content.data());
+    }
+
+    std::string gzipped;
+    http::GzipCompressor(1).Compress(content, gzipped);
+    state.SetBytesProcessed(state.iterations() * content.size());
+    state.counters["gzipped"] = gzipped.size();
+}
+BENCHMARK(BM_EncodeSortedBySeries)->Arg(0)->Arg(1);
+
+} // namespace opengemini::benchmark
@@ -0,0 +1,115 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "opengemini/impl/comm/Context.hpp"
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+#include "opengemini/impl/http/Gzip.hpp"
+#include "opengemini/impl/http/HttpClient.hpp"
+
+#include "StandInServer.hpp"
+
+namespace opengemini::benchmark {
+
+using namespace opengemini::impl;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string GenerateLines(std::size_t num)
+{
+    std::vector<Point> points;
+    points.reserve(num);
+    for (std::size_t idx = 0; idx < num; ++idx) {
+        points.push_back({ "cpu_usage",
+                           { { "usage_user", 12.345678901234 + idx },
+                             { "usage_system", 3.1415926 },
+                             { "procs", static_cast<int64_t>(idx % 300) },
+                             { "healthy", true },
+                             { "status", "running" } },
+                           Point::Time{ std::chrono::seconds(1700000000) +
+                                        std::chrono::seconds(idx) },
+                           { { "host", "server-" + std::to_string(idx % 64) },
+                             { "region", "cn-north-1" } } });
+    }
+
+    std::string lines;
+    enc::LineProtocolEncoder{}.EncodeTo(lines, points);
+    return lines;
+}
+
+} // namespace
+
+// The CPU spent on compressing a body of line protocol at each level, against
+// the bytes it saves.
+static void BM_GzipCompress(::benchmark::State& state)
+{
+    const auto           lines = GenerateLines(state.range(0));
+    http::GzipCompressor compressor(static_cast<int>(state.range(1)));
+
+    std::string member;
+    for (auto _ : state) {
+        member.clear();
+        compressor.Compress(lines, member);
+        ::benchmark::DoNotOptimize(member.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * lines.size());
+    state.counters["ratio"] =
+        static_cast<double>(lines.size()) / static_cast<double>(member.size());
+}
+BENCHMARK(BM_GzipCompress)
+    ->ArgsProduct({ { 10000 }, { 0, 1, 3, 6, 9 } })
+    ->Unit(::benchmark::kMillisecond);
+
+// Posts a body of line protocol to the stand-in server, compressed at each
+// level or not at all (-1). On the loopback interface sending is so cheap that
+// this mostly shows the cost of compressing; the bytes sent per post tell how
+// much it would save on a real network.
+static void BM_PostGzipped(::benchmark::State& state)
+{
+    const auto    lines = GenerateLines(state.range(0));
+    const auto    level = static_cast<int>(state.range(1));
+    Context       ctx(1);
+    StandInServer server(ctx());
+
+    http::HttpClient client(ctx(), 5s, 5s);
+    if (level >= 0) { client.EnableGzip(level, 0); }
+    auto endpoint = server.GetEndpoint();
+
+    for (auto _ : state) {
+        boost::asio::spawn(
+            ctx(),
+            [&](auto yield) {
+                auto response = client.Post(endpoint, "/write", lines, yield);
+                ::benchmark::DoNotOptimize(response.result());
+            },
+            boost::asio::use_future)
+            .get();
+    }
+
+    http::GzipCompressor compressor(level >= 0 ? level : 0);
+    std::string          member;
+    compressor.Compress(lines, member);
+    state.SetBytesProcessed(state.iterations() * lines.size());
+    state.counters["sent_bytes"] =
+        static_cast<double>(level >= 0 ? member.size() : lines.size());
+}
+BENCHMARK(BM_PostGzipped)
+    ->ArgsProduct({ { 10000 }, { -1, 1, 6 } })
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace opengemini::benchmark
@@ -27,11 +27,24 @@ TEST(ClientConfigBuilderTest, BasicUsage)
             .AppendAddress({ "127.0.0.1", 8086 })
             .AppendAddresses({ { "localhost", 1234 }, { "dummy-host", 18086 } })
             .EnableGzip(true)
+            .GzipLevel(1)
+            .GzipThreshold(4096)
             .AuthCredential("dummyuser", "dummypass")
             .ReadWriteTimeout(3500ms)
             .ConnectTimeout(20s)
             .BatchConfig(1min, 10000)
+            .AdaptiveBatchConfig(1000, 50000, 250ms)
             .ConcurrencyHint(12)
+            .ParallelEncodingThreshold(500)
+            .WriteChunkSize(64 * 1024)
+            .SortPointsBySeries(true)
+            .WriteBudget(64 * 1024 * 1024, WriteBudgetPolicy::DropOldest)
+            .SpillConfig("spill", 256 * 1024 * 1024)
+            .RetryConfig(5, 200ms)
+            .BisectRejectedWrites(true)
+            .FanOutThreshold(5000)
+            .AppendReplica({ { "127.0.0.2", 8086 } })
+            .RollupConfig(10s)
             .Finalize();
 
     auto endpointPred = [](const Endpoint&  endpoint,
@@ -44,7 +57,12 @@ TEST(ClientConfigBuilderTest, BasicUsage)
     EXPECT_PRED3(endpointPred, conf.addresses[2], "dummy-host", 18086);
 
     EXPECT_EQ(conf.gzipEnabled, true);
+    EXPECT_EQ(conf.gzipLevel, 1);
+    EXPECT_EQ(conf.gzipThreshold, 4096);
     EXPECT_EQ(conf.concurrencyHint, 12);
+    EXPECT_EQ(conf.parallelEncodingThreshold, 500);
+    EXPECT_EQ(conf.writeChunkSize, 64 * 1024);
+    EXPECT_TRUE(conf.sortPointsBySeries);
 
     const auto& [username, password] =
         std::get<AuthCredential>(conf.authConfig.value());
@@ -56,6 +74,26 @@ TEST(ClientConfigBuilderTest, BasicUsage)
 
     EXPECT_EQ(conf.batchConfig->batchSize, 10000);
     EXPECT_EQ(conf.batchConfig->batchInterval, 1min);
+    EXPECT_EQ(conf.adaptiveBatchConfig->minBatchSize, 1000);
+    EXPECT_EQ(conf.adaptiveBatchConfig->maxBatchSize, 50000);
+    EXPECT_EQ(conf.adaptiveBatchConfig->maxInFlight, 4);
+    EXPECT_EQ(conf.adaptiveBatchConfig->targetLatency, 250ms);
+
+    EXPECT_EQ(conf.writeBudget->maxBytes, 64 * 1024 * 1024);
+    EXPECT_EQ(conf.writeBudget->policy, WriteBudgetPolicy::DropOldest);
+
+    EXPECT_EQ(conf.spillConfig->directory, "spill");
+    EXPECT_EQ(conf.spillConfig->maxBytes, 256 * 1024 * 1024);
+
+    EXPECT_EQ(conf.retryConfig->maxAttempts, 5);
+    EXPECT_EQ(conf.retryConfig->initialBackoff, 200ms);
+    EXPECT_TRUE(conf.bisectRejectedWrites);
+    EXPECT_EQ(conf.fanOutThreshold, 5000);
+    ASSERT_EQ(conf.replicas.size(), 1);
+    EXPECT_EQ(conf.replicas[0].addresses[0].host, "127.0.0.2");
+    EXPECT_FALSE(conf.replicas[0].authConfig.has_value());
+    EXPECT_EQ(conf.rollupConfig->window, 10s);
+    EXPECT_EQ(conf.rollupConfig->aggregates.size(), 5);
 }
 
 #ifdef OPENGEMINI_ENABLE_SSL_SUPPORT
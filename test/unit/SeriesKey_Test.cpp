@@ -0,0 +1,50 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "opengemini/SeriesKey.hpp"
+#include "test/ExpectThrowAs.hpp"
+
+namespace opengemini::test {
+
+TEST(SeriesKeyTest, SerializeMeasurementAndSortedTags)
+{
+    SeriesKey key{ "cpu usage", { { "rack", "r=1" }, { "host", "a,b" } } };
+    EXPECT_FALSE(key.Empty());
+    EXPECT_EQ(key.View(), R"(cpu\ usage,host=a\,b,rack=r\=1)");
+
+    EXPECT_EQ(SeriesKey{ "cpu" }.View(), "cpu");
+}
+
+TEST(SeriesKeyTest, EmptyKey)
+{
+    SeriesKey key;
+    EXPECT_TRUE(key.Empty());
+    EXPECT_TRUE(key.View().empty());
+}
+
+TEST(SeriesKeyTest, CopiesShareStorage)
+{
+    SeriesKey key{ "cpu", { { "host", "server-0001" } } };
+    SeriesKey copy{ key };
+    EXPECT_EQ(copy.View().data(), key.View().data());
+}
+
+TEST(SeriesKeyTest, WithEmptyMeasurement)
+{
+    EXPECT_THROW_AS(SeriesKey{ "" }, errc::LogicErrors::InvalidArgument);
+}
+
+} // namespace opengemini::test
@@ -0,0 +1,130 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/BatchController.hpp"
+#include "test/ExpectThrowAs.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+namespace {
+
+const Endpoint first{ "127.0.0.1", 1234 };
+const Endpoint second{ "127.0.0.1", 5678 };
+
+} // namespace
+
+TEST(BatchControllerTest, ConstructWithInvalidConfig)
+{
+    EXPECT_THROW_AS(
+        (cli::BatchController(AdaptiveBatchConfig{ 0, 10, 4, 1s }, 10)),
+        errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(
+        (cli::BatchController(AdaptiveBatchConfig{ 20, 10, 4, 1s }, 10)),
+        errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(
+        (cli::BatchController(AdaptiveBatchConfig{ 1, 10, 0, 1s }, 10)),
+        errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(
+        (cli::BatchController(AdaptiveBatchConfig{ 1, 10, 4, 0s }, 10)),
+        errc::LogicErrors::InvalidArgument);
+}
+
+TEST(BatchControllerTest, StartWithinBounds)
+{
+    cli::BatchController below(AdaptiveBatchConfig{ 100, 200, 4, 1s }, 10);
+    EXPECT_EQ(below.BatchSize(), 100);
+    EXPECT_EQ(below.MaxInFlight(), 1);
+
+    cli::BatchController above(AdaptiveBatchConfig{ 100, 200, 4, 1s }, 1000);
+    EXPECT_EQ(above.BatchSize(), 200);
+}
+
+TEST(BatchControllerTest, GrowWhileOnTime)
+{
+    cli::BatchController controller(AdaptiveBatchConfig{ 100, 260, 3, 1s },
+                                    100);
+
+    controller.Observe(first, 10ms, false);
+    EXPECT_EQ(controller.BatchSize(), 110);
+    EXPECT_EQ(controller.MaxInFlight(), 2);
+
+    // One more in flight per round of requests.
+    controller.Observe(first, 10ms, false);
+    EXPECT_EQ(controller.MaxInFlight(), 2);
+    controller.Observe(second, 10ms, false);
+    EXPECT_EQ(controller.BatchSize(), 130);
+    EXPECT_EQ(controller.MaxInFlight(), 3);
+
+    for (int idx = 0; idx < 20; ++idx) {
+        controller.Observe(first, 10ms, false);
+    }
+    EXPECT_EQ(controller.BatchSize(), 260);
+    EXPECT_EQ(controller.MaxInFlight(), 3);
+}
+
+TEST(BatchControllerTest, HalveOncePerRoundTrip)
+{
+    cli::BatchController controller(AdaptiveBatchConfig{ 10, 1000, 8, 100ms },
+                                    800);
+    for (int idx = 0; idx < 20; ++idx) {
+        controller.Observe(first, 10ms, false);
+    }
+    EXPECT_EQ(controller.BatchSize(), 1000);
+    EXPECT_EQ(controller.MaxInFlight(), 6);
+
+    controller.Observe(first, 200ms, false);
+    EXPECT_EQ(controller.BatchSize(), 500);
+    EXPECT_EQ(controller.MaxInFlight(), 3);
+
+    // Sent before the previous halving.
+    controller.Observe(second, 1h, true);
+    EXPECT_EQ(controller.BatchSize(), 500);
+    EXPECT_EQ(controller.MaxInFlight(), 3);
+
+    controller.Observe(second, 0ms, true);
+    EXPECT_EQ(controller.BatchSize(), 250);
+    EXPECT_EQ(controller.MaxInFlight(), 1);
+
+    for (int idx = 0; idx < 10; ++idx) {
+        controller.Observe(first, 0ms, true);
+    }
+    EXPECT_EQ(controller.BatchSize(), 10);
+    EXPECT_EQ(controller.MaxInFlight(), 1);
+}
+
+TEST(BatchControllerTest, ObservePerEndpoint)
+{
+    cli::BatchController controller(AdaptiveBatchConfig{ 10, 100, 4, 1s }, 10);
+    controller.Observe(first, 800us, false);
+    controller.Observe(first, 1600us, false);
+    controller.Observe(second, 2s, false);
+
+    auto endpoints = controller.Endpoints();
+    ASSERT_EQ(endpoints.size(), 2);
+    EXPECT_EQ(endpoints[0].endpoint, first);
+    EXPECT_EQ(endpoints[0].latency, 900us);
+    EXPECT_EQ(endpoints[0].requests, 2);
+    EXPECT_EQ(endpoints[0].overloaded, 0);
+    EXPECT_EQ(endpoints[1].endpoint, second);
+    EXPECT_EQ(endpoints[1].latency, 2s);
+    EXPECT_EQ(endpoints[1].requests, 1);
+    EXPECT_EQ(endpoints[1].overloaded, 1);
+}
+
+} // namespace opengemini::test
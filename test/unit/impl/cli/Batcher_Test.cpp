@@ -0,0 +1,449 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/Batcher.hpp"
+#include "test/ExpectThrowAs.hpp"
+#include "test/MockIHttpClient.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class BatcherTestFixture : public TestFixtureWithContext {
+protected:
+    BatcherTestFixture() :
+        TestFixtureWithContext(2),
+        mockHttp_(std::make_shared<MockIHttpClient>(ctx_())),
+        lb_(lb::LoadBalancer::Construct(ctx_(),
+                                        std::vector<Endpoint>{
+                                            { "127.0.0.1", 1234 } },
+                                        mockHttp_))
+    {
+        ON_CALL(*mockHttp_, SendRequest)
+            .WillByDefault([this](const Endpoint&,
+                                  http::Request& request,
+                                  boost::asio::yield_context) {
+                std::lock_guard lock(mutex_);
+                requests_.emplace_back(std::string(request.target()),
+                                       request.body());
+                return http::Response{ http::Status::no_content, 11, "{}" };
+            });
+    }
+
+    std::shared_ptr<cli::Batcher>
+    Construct(std::chrono::milliseconds          interval,
+              std::size_t                        size,
+              std::optional<AdaptiveBatchConfig> adaptive = std::nullopt)
+    {
+        return cli::Batcher::Construct(ctx_(),
+                                       cli::Functor{ *mockHttp_, *lb_ },
+                                       buffers_,
+                                       options_,
+                                       BatchConfig{ interval, size },
+                                       budget_,
+                                       adaptive);
+    }
+
+    std::future<void> Write(cli::Batcher& batcher,
+                            std::string   database,
+                            std::string   lines)
+    {
+        auto points  = cli::CountPoints(RawLines{ lines });
+        auto promise = std::make_shared<std::promise<void>>();
+        auto future  = promise->get_future();
+        batcher.Enqueue(std::move(database),
+                        "test_rp_cxx",
+                        cli::PrepareRawLines(buffers_, { std::move(lines) }),
+                        points,
+                        [promise](std::exception_ptr ex) {
+                            if (ex) { promise->set_exception(ex); }
+                            else { promise->set_value(); }
+                        });
+        return future;
+    }
+
+    std::vector<std::pair<std::string, std::string>> Requests()
+    {
+        std::lock_guard lock(mutex_);
+        return requests_;
+    }
+
+protected:
+    std::shared_ptr<MockIHttpClient>  mockHttp_;
+    std::shared_ptr<lb::LoadBalancer> lb_;
+    BufferPool                        buffers_;
+    cli::WriteOptions                 options_{ 0, 1, 0, false };
+    cli::WriteBudget*                 budget_{ nullptr };
+
+    std::mutex                                       mutex_;
+    std::vector<std::pair<std::string, std::string>> requests_;
+};
+
+TEST_F(BatcherTestFixture, ConstructWithInvalidConfig)
+{
+    EXPECT_THROW_AS((std::ignore = Construct(0ms, 10)),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS((std::ignore = Construct(1s, 0)),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS((std::ignore = Construct(
+                         1s,
+                         10,
+                         AdaptiveBatchConfig{ 100, 10, 4, 1s })),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(BatcherTestFixture, SendWhenFull)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    auto batcher = Construct(1h, 4);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\ntest a=2i\n");
+    auto second  = Write(*batcher, "test_db_cxx", "test a=3i");
+    EXPECT_EQ(first.wait_for(50ms), std::future_status::timeout);
+
+    auto third = Write(*batcher, "test_db_cxx", "test a=4i\n");
+    first.get();
+    second.get();
+    third.get();
+
+    auto requests = Requests();
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].first,
+              "/write?db=test_db_cxx&rp=test_rp_cxx&precision=ns");
+    EXPECT_EQ(requests[0].second,
+              "test a=1i\ntest a=2i\ntest a=3i\ntest a=4i\n");
+}
+
+TEST_F(BatcherTestFixture, SendUntimedPointBatchWhenFull)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    // Rows of a batch without times are counted by its columns.
+    PointBatch batch{ "test", { { "a", std::vector<int64_t>{ 1, 2 } } } };
+    ASSERT_EQ(cli::CountPoints(batch), 2);
+
+    auto batcher = Construct(1h, 2);
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future  = promise->get_future();
+    batcher->Enqueue("test_db_cxx",
+                     "test_rp_cxx",
+                     cli::EncodeEagerly(buffers_, batch),
+                     cli::CountPoints(batch),
+                     [promise](std::exception_ptr ex) {
+                         if (ex) { promise->set_exception(ex); }
+                         else { promise->set_value(); }
+                     });
+    ASSERT_EQ(future.wait_for(1s), std::future_status::ready);
+    future.get();
+
+    auto requests = Requests();
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].second, "test a=1i\ntest a=2i\n");
+}
+
+TEST_F(BatcherTestFixture, SendWhenExpired)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(2);
+
+    auto batcher = Construct(20ms, 1000);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    auto second  = Write(*batcher, "test_db_cxx", "test a=2i\n");
+    first.get();
+    second.get();
+
+    // A new batch is started by the next write.
+    Write(*batcher, "test_db_cxx", "test a=3i\n").get();
+
+    auto requests = Requests();
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].second, "test a=1i\ntest a=2i\n");
+    EXPECT_EQ(requests[1].second, "test a=3i\n");
+}
+
+TEST_F(BatcherTestFixture, WriteFromMultipleThreads)
+{
+    constexpr std::size_t writers = 8;
+    constexpr std::size_t writes  = 500;
+
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(writers * writes / 1000);
+
+    auto                     batcher = Construct(1h, 1000);
+    std::vector<std::thread> threads;
+    for (std::size_t writer = 0; writer < writers; ++writer) {
+        threads.emplace_back([this, &batcher] {
+            std::vector<std::future<void>> futures;
+            for (std::size_t idx = 0; idx < writes; ++idx) {
+                futures.push_back(
+                    Write(*batcher, "test_db_cxx", "test a=1i\n"));
+            }
+            for (auto& future : futures) { future.get(); }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    std::size_t lines{ 0 };
+    for (auto& [target, body] : Requests()) {
+        lines += std::count(body.begin(), body.end(), '\n');
+    }
+    EXPECT_EQ(lines, writers * writes);
+}
+
+TEST_F(BatcherTestFixture, FillRingOnContextThread)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(3);
+
+    // The drainer posted by the first write cannot run on the only thread of
+    // the context before the writes there return.
+    impl::Context single(1);
+    auto batcher = cli::Batcher::Construct(single(),
+                                           cli::Functor{ *mockHttp_, *lb_ },
+                                           buffers_,
+                                           options_,
+                                           BatchConfig{ 1h, 1000 });
+
+    std::promise<std::vector<std::future<void>>> written;
+    boost::asio::post(single(), [this, &batcher, &written] {
+        std::vector<std::future<void>> futures;
+        for (std::size_t idx = 0; idx < 2500; ++idx) {
+            futures.push_back(Write(*batcher, "test_db_cxx", "test a=1i\n"));
+        }
+        batcher->Close();
+        written.set_value(std::move(futures));
+    });
+    for (auto& future : written.get_future().get()) { future.get(); }
+
+    std::size_t lines{ 0 };
+    for (auto& [target, body] : Requests()) {
+        lines += std::count(body.begin(), body.end(), '\n');
+    }
+    EXPECT_EQ(lines, 2500);
+}
+
+TEST_F(BatcherTestFixture, BatchPerDatabase)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(2);
+
+    auto batcher = Construct(1h, 2);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    auto second  = Write(*batcher, "other_db_cxx", "test a=2i\n");
+    EXPECT_EQ(first.wait_for(50ms), std::future_status::timeout);
+
+    batcher->Close();
+    first.get();
+    second.get();
+
+    auto requests = Requests();
+    ASSERT_EQ(requests.size(), 2);
+    std::sort(requests.begin(), requests.end());
+    EXPECT_EQ(requests[0].first,
+              "/write?db=other_db_cxx&rp=test_rp_cxx&precision=ns");
+    EXPECT_EQ(requests[0].second, "test a=2i\n");
+    EXPECT_EQ(requests[1].first,
+              "/write?db=test_db_cxx&rp=test_rp_cxx&precision=ns");
+    EXPECT_EQ(requests[1].second, "test a=1i\n");
+}
+
+TEST_F(BatcherTestFixture, FailWriteAfterClose)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 30, WriteBudgetPolicy::Fail });
+    budget_      = &budget;
+    auto batcher = Construct(1h, 10);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    batcher->Close();
+    first.get();
+
+    EXPECT_THROW_AS(Write(*batcher, "test_db_cxx", "test a=2i\n").get(),
+                    errc::RuntimeErrors::WriteDropped);
+    EXPECT_EQ(Requests().size(), 1);
+    EXPECT_EQ(budget.Statistics().bytes, 0);
+}
+
+TEST_F(BatcherTestFixture, FailEveryWriteOfBatch)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest)
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::internal_server_error, 11, "{}" }));
+
+    auto batcher = Construct(1h, 2);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    auto second  = Write(*batcher, "test_db_cxx", "test a=2i\n");
+    EXPECT_THROW_AS(first.get(), errc::ServerErrors::UnexpectedStatusCode);
+    EXPECT_THROW_AS(second.get(), errc::ServerErrors::UnexpectedStatusCode);
+}
+
+TEST_F(BatcherTestFixture, FailInvalidWriteAlone)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    auto batcher = Construct(1h, 2);
+    auto valid   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    EXPECT_THROW_AS(Write(*batcher, "", "test a=2i\n").get(),
+                    errc::LogicErrors::InvalidArgument);
+
+    auto promise = std::make_shared<std::promise<void>>();
+    batcher->Enqueue("test_db_cxx",
+                     "test_rp_cxx",
+                     cli::PrepareRawLines(buffers_, { "test 2\n", true }),
+                     1,
+                     [promise](std::exception_ptr ex) {
+                         if (ex) { promise->set_exception(ex); }
+                         else { promise->set_value(); }
+                     });
+    EXPECT_THROW_AS(promise->get_future().get(),
+                    errc::LogicErrors::InvalidArgument);
+
+    EXPECT_EQ(valid.wait_for(50ms), std::future_status::timeout);
+    batcher->Close();
+    valid.get();
+}
+
+TEST_F(BatcherTestFixture, ChargeBatchesToBudget)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 30, WriteBudgetPolicy::Fail });
+    budget_      = &budget;
+    auto batcher = Construct(1h, 2);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    EXPECT_THROW_AS(
+        Write(*batcher, "test_db_cxx", "test a=2i,b=2i,c=2i,d=2i\n").get(),
+        errc::RuntimeErrors::WriteBudgetExceeded);
+    EXPECT_EQ(budget.Statistics().bytes, 10);
+
+    auto second = Write(*batcher, "test_db_cxx", "test a=3i\n");
+    first.get();
+    second.get();
+    EXPECT_EQ(budget.Statistics().bytes, 0);
+    EXPECT_EQ(budget.Statistics().rejected, 1);
+}
+
+TEST_F(BatcherTestFixture, DropOldestBatchForBudget)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest).Times(1);
+
+    cli::WriteBudget budget(
+        ctx_(),
+        WriteBudgetConfig{ 30, WriteBudgetPolicy::DropOldest });
+    budget_      = &budget;
+    auto batcher = Construct(1h, 10);
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\n");
+    auto second  = Write(*batcher, "test_db_cxx", "test a=2i\n");
+    // Submissions are only dropped once drained into their batch.
+    std::this_thread::sleep_for(50ms);
+
+    auto third = Write(*batcher, "other_db_cxx", "test a=3i\ntest a=4i\n");
+    EXPECT_THROW_AS(first.get(), errc::RuntimeErrors::WriteDropped);
+    EXPECT_THROW_AS(second.get(), errc::RuntimeErrors::WriteDropped);
+
+    batcher->Close();
+    third.get();
+
+    auto requests = Requests();
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].first,
+              "/write?db=other_db_cxx&rp=test_rp_cxx&precision=ns");
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.bytes, 0);
+    EXPECT_EQ(statistics.dropped, 2);
+}
+
+TEST_F(BatcherTestFixture, QueueFullBatchesWhileInFlightAtLimit)
+{
+    std::promise<void> release;
+    auto               released = release.get_future().share();
+    EXPECT_CALL(*mockHttp_, SendRequest)
+        .Times(2)
+        .WillRepeatedly([this, released](const Endpoint&,
+                                         http::Request& request,
+                                         boost::asio::yield_context) {
+            {
+                std::lock_guard lock(mutex_);
+                requests_.emplace_back(std::string(request.target()),
+                                       request.body());
+            }
+            released.wait();
+            return http::Response{ http::Status::no_content, 11, "{}" };
+        });
+
+    auto batcher = Construct(1h, 2, AdaptiveBatchConfig{ 2, 18, 4, 1h });
+    auto first   = Write(*batcher, "test_db_cxx", "test a=1i\ntest a=2i\n");
+    auto second  = Write(*batcher, "other_db_cxx", "test a=3i\ntest a=4i\n");
+    EXPECT_EQ(second.wait_for(50ms), std::future_status::timeout);
+
+    auto statistics = batcher->Statistics();
+    EXPECT_EQ(statistics.batchSize, 2);
+    EXPECT_EQ(statistics.maxInFlight, 1);
+    EXPECT_EQ(statistics.inFlight, 1);
+    EXPECT_EQ(statistics.queued, 1);
+    EXPECT_EQ(Requests().size(), 1);
+
+    release.set_value();
+    first.get();
+    second.get();
+
+    statistics = batcher->Statistics();
+    EXPECT_EQ(statistics.batchSize, 4);
+    EXPECT_EQ(statistics.maxInFlight, 2);
+    EXPECT_EQ(statistics.inFlight, 0);
+    EXPECT_EQ(statistics.queued, 0);
+    ASSERT_EQ(statistics.endpoints.size(), 1);
+    EXPECT_EQ(statistics.endpoints[0].endpoint.port, 1234);
+    EXPECT_EQ(statistics.endpoints[0].requests, 2);
+    EXPECT_EQ(statistics.endpoints[0].overloaded, 0);
+}
+
+TEST_F(BatcherTestFixture, ShrinkBatchesWhenServerOverloaded)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest)
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::service_unavailable, 11, "{}" }))
+        .WillOnce(testing::DoDefault());
+
+    auto batcher = Construct(1h, 4, AdaptiveBatchConfig{ 2, 16, 4, 1h });
+    auto overloaded = Write(*batcher,
+                            "test_db_cxx",
+                            "test a=1i\ntest a=2i\ntest a=3i\ntest a=4i\n");
+    EXPECT_THROW_AS(overloaded.get(), errc::ServerErrors::UnexpectedStatusCode);
+
+    auto statistics = batcher->Statistics();
+    EXPECT_EQ(statistics.batchSize, 2);
+    ASSERT_EQ(statistics.endpoints.size(), 1);
+    EXPECT_EQ(statistics.endpoints[0].overloaded, 1);
+
+    // Sent as soon as it holds as many points as the smaller batch size.
+    Write(*batcher, "test_db_cxx", "test a=5i\ntest a=6i\n").get();
+}
+
+TEST_F(BatcherTestFixture, FixedBatchSizeWithoutAdaptiveConfig)
+{
+    auto statistics = Construct(1h, 4)->Statistics();
+    EXPECT_EQ(statistics.batchSize, 4);
+    EXPECT_EQ(statistics.maxInFlight, 0);
+    EXPECT_TRUE(statistics.endpoints.empty());
+}
+
+} // namespace opengemini::test
@@ -0,0 +1,244 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/Replica.hpp"
+#include "opengemini/impl/cli/write/Write.hpp"
+#include "test/MockIHttpClient.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class ReplicaTestFixture : public TestFixtureWithContext {
+protected:
+    ReplicaTestFixture() : http_(std::make_shared<MockIHttpClient>(ctx_()))
+    {
+        config_.addresses = { { "127.0.0.2", 1 }, { "127.0.0.2", 2 } };
+    }
+
+    std::shared_ptr<cli::Replica>
+    Construct(std::optional<RetryConfig> retry  = std::nullopt,
+              bool                       bisect = false)
+    {
+        return cli::Replica::Construct(ctx_(),
+                                       config_,
+                                       http_,
+                                       buffers_,
+                                       retry,
+                                       bisect,
+                                       10ms);
+    }
+
+    static std::shared_ptr<const std::vector<std::string>>
+    Content(std::vector<std::string> parts)
+    {
+        return std::make_shared<const std::vector<std::string>>(
+            std::move(parts));
+    }
+
+    static bool
+    Replicate(cli::Replica&                                   replica,
+              std::shared_ptr<const std::vector<std::string>> content)
+    {
+        if (!replica.Reserve(http::SharedBody::size(content))) { return false; }
+        replica.Replicate("db",
+                          {},
+                          cli::SharedContent{ Precision::Second, content });
+        return true;
+    }
+
+protected:
+    BufferPool                       buffers_;
+    ReplicaConfig                    config_;
+    std::shared_ptr<MockIHttpClient> http_;
+};
+
+TEST_F(ReplicaTestFixture, ReplicateContent)
+{
+    auto replica = Construct();
+    auto content = Content({ "test a=1i 1\n", "test a=2i 2\n" });
+
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([](const Endpoint&            endpoint,
+                     http::Request&             request,
+                     boost::asio::yield_context) {
+            EXPECT_EQ(endpoint.host, "127.0.0.2");
+            EXPECT_EQ(request.target(), "/write?db=db&rp=&precision=s");
+            EXPECT_EQ(request.body(), "test a=1i 1\ntest a=2i 2\n");
+            return http::Response{ http::Status::no_content, 11 };
+        });
+    EXPECT_TRUE(Replicate(*replica, content));
+    replica->Close();
+
+    auto statistics = replica->Statistics();
+    EXPECT_EQ(statistics.pendingBytes, 0);
+    EXPECT_EQ(statistics.written, 1);
+    EXPECT_EQ(statistics.failed, 0);
+    EXPECT_EQ(statistics.dropped, 0);
+    // The content is left untouched for the other clusters.
+    EXPECT_EQ(*content,
+              (std::vector<std::string>{ "test a=1i 1\n", "test a=2i 2\n" }));
+}
+
+TEST_F(ReplicaTestFixture, RetryOnNextServer)
+{
+    RetryConfig retry;
+    retry.initialBackoff = 1ms;
+    retry.maxBackoff     = 1ms;
+    auto replica         = Construct(retry);
+
+    std::vector<uint16_t> ports;
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([&ports](const Endpoint& endpoint, auto&, auto) {
+            ports.push_back(endpoint.port);
+            return http::Response{ http::Status::service_unavailable, 11 };
+        })
+        .WillOnce([&ports](const Endpoint& endpoint, auto&, auto) {
+            ports.push_back(endpoint.port);
+            return http::Response{ http::Status::no_content, 11 };
+        });
+    Replicate(*replica, Content({ "test a=1i 1\n" }));
+    replica->Close();
+
+    ASSERT_EQ(ports.size(), 2);
+    EXPECT_NE(ports[0], ports[1]);
+    EXPECT_EQ(replica->Statistics().written, 1);
+}
+
+TEST_F(ReplicaTestFixture, CountFailedWrites)
+{
+    auto replica = Construct();
+
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::bad_request, 11 }));
+    Replicate(*replica, Content({ "test a=1i 1\n" }));
+    replica->Close();
+
+    auto statistics = replica->Statistics();
+    EXPECT_EQ(statistics.written, 0);
+    EXPECT_EQ(statistics.failed, 1);
+}
+
+TEST_F(ReplicaTestFixture, ResendWhenClusterIsBack)
+{
+    auto replica = Construct();
+
+    boost::system::error_code refused(boost::asio::error::connection_refused);
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::Throw(Exception(refused)))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11 }));
+    Replicate(*replica, Content({ "test a=1i 1\n" }));
+    for (auto cnt = 0; cnt < 100 && replica->Statistics().written == 0;
+         ++cnt) {
+        std::this_thread::sleep_for(10ms);
+    }
+    replica->Close();
+
+    auto statistics = replica->Statistics();
+    EXPECT_EQ(statistics.pendingBytes, 0);
+    EXPECT_EQ(statistics.written, 1);
+    EXPECT_EQ(statistics.failed, 0);
+}
+
+TEST_F(ReplicaTestFixture, FailHeldWritesOnClose)
+{
+    auto replica = Construct();
+
+    boost::system::error_code refused(boost::asio::error::connection_refused);
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillRepeatedly(testing::Throw(Exception(refused)));
+    Replicate(*replica, Content({ "test a=1i 1\n" }));
+    std::this_thread::sleep_for(50ms);
+
+    // Still held, since the cluster could not be reached.
+    EXPECT_EQ(replica->Statistics().pendingBytes, 12);
+    replica->Close();
+
+    auto statistics = replica->Statistics();
+    EXPECT_EQ(statistics.pendingBytes, 0);
+    EXPECT_EQ(statistics.written, 0);
+    EXPECT_EQ(statistics.failed, 1);
+}
+
+TEST_F(ReplicaTestFixture, DropWhenPendingBytesExceeded)
+{
+    config_.maxPendingBytes = 20;
+    auto replica            = Construct();
+
+    std::promise<void> release;
+    auto               released = release.get_future().share();
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([released](auto&, auto&, auto) {
+            released.wait();
+            return http::Response{ http::Status::no_content, 11 };
+        });
+
+    // The slow cluster does not hold back the writes, the second one is
+    // dropped since the first one is still pending.
+    EXPECT_TRUE(Replicate(*replica, Content({ "test a=1i 1\n" })));
+    EXPECT_FALSE(Replicate(*replica, Content({ "test a=2i 2\n" })));
+    auto statistics = replica->Statistics();
+    EXPECT_EQ(statistics.pendingBytes, 12);
+    EXPECT_EQ(statistics.dropped, 1);
+
+    release.set_value();
+    replica->Close();
+    statistics = replica->Statistics();
+    EXPECT_EQ(statistics.pendingBytes, 0);
+    EXPECT_EQ(statistics.written, 1);
+    EXPECT_EQ(statistics.dropped, 1);
+}
+
+TEST_F(ReplicaTestFixture, BisectRejectedContent)
+{
+    auto replica = Construct(std::nullopt, true);
+
+    std::mutex               mutex;
+    std::vector<std::string> bodies;
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(3)
+        .WillRepeatedly([&](auto&, http::Request& request, auto) {
+            std::lock_guard lock(mutex);
+            bodies.push_back(request.body());
+            auto bad = request.body().find("bad") != std::string::npos;
+            return http::Response{ bad ? http::Status::bad_request
+                                       : http::Status::no_content,
+                                   11 };
+        });
+    Replicate(*replica, Content({ "test a=1i 1\n", "test bad 2\n" }));
+    replica->Close();
+
+    // The line which is not rejected is written on its own, the write only
+    // failing for the rejected one, as it does on the primary cluster.
+    std::sort(bodies.begin(), bodies.end());
+    EXPECT_EQ(bodies,
+              (std::vector<std::string>{ "test a=1i 1\n",
+                                         "test a=1i 1\ntest bad 2\n",
+                                         "test bad 2\n" }));
+    EXPECT_EQ(replica->Statistics().failed, 1);
+}
+
+} // namespace opengemini::test
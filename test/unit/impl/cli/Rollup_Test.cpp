@@ -0,0 +1,276 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/Rollup.hpp"
+#include "opengemini/impl/cli/write/WriteBudget.hpp"
+#include "test/ExpectThrowAs.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class RollupTestFixture : public TestFixtureWithContext {
+protected:
+    struct Emitted {
+        std::string        database;
+        std::string        retentionPolicy;
+        std::vector<Point> points;
+    };
+
+    RollupTestFixture() { config_.window = 1s; }
+
+    std::shared_ptr<cli::Rollup> Construct(std::size_t shards = 4)
+    {
+        return cli::Rollup::Construct(
+            ctx_(),
+            config_,
+            shards,
+            [this](std::string          database,
+                   std::string          retentionPolicy,
+                   std::vector<Point>   points,
+                   cli::Rollup::Handler handler) {
+                if (budget_) {
+                    budget_->Acquire(points.size());
+                    budget_->Release(points.size());
+                }
+                {
+                    std::lock_guard lock(mutex_);
+                    emitted_.push_back({ std::move(database),
+                                         std::move(retentionPolicy),
+                                         std::move(points) });
+                }
+                handler(nullptr);
+            });
+    }
+
+    static Point Sample(std::string host, Point::Field value, Point::Time time)
+    {
+        Point point{ "test", { { "value", std::move(value) } }, time };
+        point.tags["host"] = std::move(host);
+        return point;
+    }
+
+protected:
+    RollupConfig         config_;
+    std::mutex           mutex_;
+    std::vector<Emitted> emitted_;
+    cli::WriteBudget*    budget_{ nullptr };
+};
+
+TEST_F(RollupTestFixture, ConstructWithInvalidConfig)
+{
+    config_.window = 0s;
+    EXPECT_THROW_AS(Construct(), errc::LogicErrors::InvalidArgument);
+
+    config_.window = 1s;
+    config_.aggregates.clear();
+    EXPECT_THROW_AS(Construct(), errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(RollupTestFixture, RollUpPerSeriesAndWindow)
+{
+    auto       rollup = Construct();
+    const auto start  = Point::Time{ 10s };
+
+    rollup->Add("db", "rp", Sample("a", int64_t{ 3 }, start + 100ms));
+    rollup->Add("db", "rp", Sample("a", int64_t{ 1 }, start + 300ms));
+    rollup->Add("db", "rp", Sample("a", int64_t{ 5 }, start + 200ms));
+    rollup->Add("db", "rp", Sample("b", 2.5, start + 100ms));
+    rollup->Add("db", "rp", Sample("a", int64_t{ 7 }, start + 1s));
+
+    rollup->Flush(start + 1s);
+    ASSERT_EQ(emitted_.size(), 1);
+    EXPECT_EQ(emitted_[0].database, "db");
+    EXPECT_EQ(emitted_[0].retentionPolicy, "rp");
+
+    auto& points = emitted_[0].points;
+    ASSERT_EQ(points.size(), 2);
+    std::sort(points.begin(), points.end(), [](auto& lhs, auto& rhs) {
+        return lhs.tags.at("host") < rhs.tags.at("host");
+    });
+
+    EXPECT_EQ(points[0].measurement, "test");
+    EXPECT_EQ(points[0].time, start);
+    EXPECT_EQ(points[0].fields,
+              (std::map<std::string, Point::Field>{
+                  { "value_sum", int64_t{ 9 } },
+                  { "value_count", int64_t{ 3 } },
+                  { "value_min", int64_t{ 1 } },
+                  { "value_max", int64_t{ 5 } },
+                  { "value_last", int64_t{ 1 } } }));
+    EXPECT_EQ(points[1].fields.at("value_sum"), Point::Field{ 2.5 });
+    EXPECT_EQ(points[1].fields.at("value_count"), Point::Field{ int64_t{ 1 } });
+
+    // The next window is only emitted once it has ended.
+    rollup->Flush(start + 2s);
+    ASSERT_EQ(emitted_.size(), 2);
+    ASSERT_EQ(emitted_[1].points.size(), 1);
+    EXPECT_EQ(emitted_[1].points[0].time, start + 1s);
+
+    auto statistics = rollup->Statistics();
+    EXPECT_EQ(statistics.points, 5);
+    EXPECT_EQ(statistics.written, 3);
+    EXPECT_EQ(statistics.late, 0);
+}
+
+TEST_F(RollupTestFixture, MergeShardsOfThreads)
+{
+    auto       rollup = Construct(4);
+    const auto start  = Point::Time{ 10s };
+
+    std::vector<std::thread> threads;
+    for (auto idx = 0; idx < 4; ++idx) {
+        threads.emplace_back([&rollup, start, idx] {
+            for (auto value = 1; value <= 100; ++value) {
+                rollup->Add("db",
+                            {},
+                            Sample("a",
+                                   int64_t{ value },
+                                   start + std::chrono::milliseconds(idx)));
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    rollup->Flush(start + 1s);
+    ASSERT_EQ(emitted_.size(), 1);
+    ASSERT_EQ(emitted_[0].points.size(), 1);
+    auto& fields = emitted_[0].points[0].fields;
+    EXPECT_EQ(fields.at("value_sum"), Point::Field{ int64_t{ 4 * 5050 } });
+    EXPECT_EQ(fields.at("value_count"), Point::Field{ int64_t{ 400 } });
+    EXPECT_EQ(fields.at("value_min"), Point::Field{ int64_t{ 1 } });
+    EXPECT_EQ(fields.at("value_max"), Point::Field{ int64_t{ 100 } });
+    EXPECT_EQ(fields.at("value_last"), Point::Field{ int64_t{ 100 } });
+}
+
+TEST_F(RollupTestFixture, MixedAndNonNumericFields)
+{
+    config_.aggregates = { RollupAggregate::Sum, RollupAggregate::Last };
+    auto       rollup  = Construct();
+    const auto start   = Point::Time{ 10s };
+
+    rollup->Add("db", {}, Sample("a", int64_t{ 1 }, start));
+    rollup->Add("db", {}, Sample("a", 0.5, start + 1ms));
+    rollup->Add("db", {}, Sample("b", std::string("up"), start));
+    rollup->Add("db", {}, Sample("b", std::string("down"), start + 1ms));
+
+    rollup->Flush(start + 1s);
+    ASSERT_EQ(emitted_.size(), 1);
+    auto& points = emitted_[0].points;
+    ASSERT_EQ(points.size(), 2);
+    std::sort(points.begin(), points.end(), [](auto& lhs, auto& rhs) {
+        return lhs.tags.at("host") < rhs.tags.at("host");
+    });
+
+    EXPECT_EQ(points[0].fields,
+              (std::map<std::string, Point::Field>{
+                  { "value_sum", 1.5 },
+                  { "value_last", 0.5 } }));
+    EXPECT_EQ(points[1].fields,
+              (std::map<std::string, Point::Field>{
+                  { "value_last", std::string("down") } }));
+}
+
+TEST_F(RollupTestFixture, KeepLastOfNonNumericFieldsAlways)
+{
+    config_.aggregates = { RollupAggregate::Sum, RollupAggregate::Max };
+    auto       rollup  = Construct();
+    const auto start   = Point::Time{ 10s };
+
+    rollup->Add("db", {}, Sample("a", 2.5, start));
+    rollup->Add("db", {}, Sample("b", true, start));
+    rollup->Add("db", {}, Sample("b", false, start + 1ms));
+
+    rollup->Flush(start + 1s);
+    ASSERT_EQ(emitted_.size(), 1);
+    auto& points = emitted_[0].points;
+    ASSERT_EQ(points.size(), 2);
+    std::sort(points.begin(), points.end(), [](auto& lhs, auto& rhs) {
+        return lhs.tags.at("host") < rhs.tags.at("host");
+    });
+
+    // Last is not among the aggregates, hence only numeric fields go without.
+    EXPECT_EQ(points[0].fields,
+              (std::map<std::string, Point::Field>{ { "value_sum", 2.5 },
+                                                    { "value_max", 2.5 } }));
+    EXPECT_EQ(points[1].fields,
+              (std::map<std::string, Point::Field>{ { "value_last", false } }));
+}
+
+TEST_F(RollupTestFixture, DropLatePoints)
+{
+    auto       rollup = Construct();
+    const auto start  = Point::Time{ 10s };
+
+    rollup->Add("db", {}, Sample("a", int64_t{ 1 }, start));
+    rollup->Flush(start + 1s);
+    rollup->Add("db", {}, Sample("a", int64_t{ 2 }, start + 500ms));
+    rollup->Add("db", {}, Sample("a", int64_t{ 3 }, start + 1s));
+
+    auto statistics = rollup->Statistics();
+    EXPECT_EQ(statistics.points, 2);
+    EXPECT_EQ(statistics.late, 1);
+
+    EXPECT_THROW_AS(rollup->Add("db", {}, Point{ "test" }),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(RollupTestFixture, StopEmitsWindowsLeft)
+{
+    auto rollup = Construct();
+    rollup->Start();
+    rollup->Add("db", {}, Sample("a", int64_t{ 1 }, Point::Time{}));
+    rollup->Stop();
+
+    ASSERT_EQ(emitted_.size(), 1);
+    ASSERT_EQ(emitted_[0].points.size(), 1);
+    EXPECT_GT(emitted_[0].points[0].time, Point::Time{});
+    EXPECT_EQ(rollup->Statistics().written, 1);
+}
+
+TEST_F(RollupTestFixture, WaitForRoomInBlockingBudget)
+{
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 10, WriteBudgetPolicy::Block });
+    budget_ = &budget;
+    budget.Acquire(10);
+
+    config_.window = 20ms;
+    auto rollup    = Construct();
+    rollup->Start();
+    rollup->Add("db", {}, Sample("a", int64_t{ 1 }, Point::Time{}));
+
+    // The window ends meanwhile, its write waiting for room rather than being
+    // refused.
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(budget.Statistics().blocked, 1);
+    EXPECT_EQ(budget.Statistics().rejected, 0);
+
+    budget.Release(10);
+    rollup->Stop();
+    ASSERT_EQ(emitted_.size(), 1);
+    auto statistics = rollup->Statistics();
+    EXPECT_EQ(statistics.written, 1);
+    EXPECT_EQ(statistics.failed, 0);
+}
+
+} // namespace opengemini::test
@@ -0,0 +1,224 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/Spill.hpp"
+#include "test/ExpectThrowAs.hpp"
+#include "test/MockIHttpClient.hpp"
+#include "test/Random.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class SpillTestFixture : public TestFixtureWithContext {
+protected:
+    SpillTestFixture() :
+        directory_(std::filesystem::temp_directory_path() /
+                   ("opengemini-spill-" + GenerateRandomString(10))),
+        http_(std::make_shared<MockIHttpClient>(ctx_())),
+        lb_(lb::LoadBalancer::Construct(ctx_(),
+                                        std::vector<Endpoint>{ { "host", 1 } },
+                                        http_))
+    {
+        config_.directory   = directory_.string();
+        config_.maxBytes    = 4096;
+        config_.segmentSize = 1024;
+        config_.replayRate  = 0;
+    }
+
+    ~SpillTestFixture() { std::filesystem::remove_all(directory_); }
+
+    std::shared_ptr<cli::Spill> Construct()
+    {
+        return cli::Spill::Construct(ctx_(), config_, lb_, http_, 10ms);
+    }
+
+    static bool Append(cli::Spill& spill, std::string_view body)
+    {
+        return spill.Append("db", "rp", Precision::Second, { &body, 1 });
+    }
+
+    // Accepts the replayed writes and keeps their bodies, in order.
+    void Accept()
+    {
+        EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+            .WillRepeatedly([this](auto&, http::Request& request, auto) {
+                EXPECT_EQ(request.target(),
+                          "/write?db=db&rp=rp&precision=s");
+                std::lock_guard lock(mutex_);
+                replayed_.push_back(request.body());
+                return http::Response{ http::Status::no_content, 11 };
+            });
+    }
+
+    static void WaitUntilReplayed(const cli::Spill& spill)
+    {
+        for (auto count = 0; count < 200 && spill.Pending() != 0; ++count) {
+            std::this_thread::sleep_for(10ms);
+        }
+        EXPECT_EQ(spill.Pending(), 0);
+    }
+
+protected:
+    std::filesystem::path             directory_;
+    SpillConfig                       config_;
+    std::shared_ptr<MockIHttpClient>  http_;
+    std::shared_ptr<lb::LoadBalancer> lb_;
+
+    std::mutex               mutex_;
+    std::vector<std::string> replayed_;
+};
+
+TEST_F(SpillTestFixture, ConstructWithInvalidConfig)
+{
+    config_.directory.clear();
+    EXPECT_THROW_AS(Construct(), errc::LogicErrors::InvalidArgument);
+
+    config_.directory = directory_.string();
+    config_.maxBytes  = config_.segmentSize - 1;
+    EXPECT_THROW_AS(Construct(), errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(SpillTestFixture, ReplayInOrder)
+{
+    auto spill = Construct();
+    for (auto body : { "test a=1i 1", "test a=2i 2", "test a=3i 3" }) {
+        ASSERT_TRUE(Append(*spill, body));
+    }
+    EXPECT_GT(spill->Pending(), 0);
+
+    Accept();
+    spill->StartReplay();
+    WaitUntilReplayed(*spill);
+    spill->StopReplay();
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(replayed_,
+              (std::vector<std::string>{ "test a=1i 1",
+                                         "test a=2i 2",
+                                         "test a=3i 3" }));
+}
+
+TEST_F(SpillTestFixture, AppendScatteredContent)
+{
+    auto                          spill = Construct();
+    std::vector<std::string_view> parts{ "test a=1i 1\n", "test a=2i 2" };
+    ASSERT_TRUE(spill->Append("db", "rp", Precision::Second, parts));
+
+    Accept();
+    spill->StartReplay();
+    WaitUntilReplayed(*spill);
+    spill->StopReplay();
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(replayed_,
+              std::vector<std::string>{ "test a=1i 1\ntest a=2i 2" });
+}
+
+TEST_F(SpillTestFixture, RecoverFromSegmentHeaders)
+{
+    {
+        auto spill = Construct();
+        for (auto idx = 0; idx < 50; ++idx) {
+            ASSERT_TRUE(Append(*spill, fmt::format("test a={}i", idx)));
+        }
+    }
+
+    auto spill = Construct();
+    EXPECT_GT(spill->Pending(), 0);
+
+    Accept();
+    spill->StartReplay();
+    WaitUntilReplayed(*spill);
+    spill->StopReplay();
+
+    std::lock_guard lock(mutex_);
+    ASSERT_EQ(replayed_.size(), 50);
+    for (auto idx = 0; idx < 50; ++idx) {
+        EXPECT_EQ(replayed_[idx], fmt::format("test a={}i", idx));
+    }
+}
+
+TEST_F(SpillTestFixture, RefuseWhenQuotaExhausted)
+{
+    auto        spill = Construct();
+    std::string body(600, 'x');
+    for (std::size_t idx = 0; idx < config_.maxBytes / config_.segmentSize;
+         ++idx) {
+        EXPECT_TRUE(Append(*spill, body));
+    }
+    EXPECT_FALSE(Append(*spill, body));
+    EXPECT_FALSE(Append(*spill, std::string(config_.segmentSize, 'x')));
+}
+
+TEST_F(SpillTestFixture, SkipCorruptRecord)
+{
+    {
+        // One record per segment.
+        auto spill = Construct();
+        ASSERT_TRUE(Append(*spill, std::string(600, 'a')));
+        ASSERT_TRUE(Append(*spill, std::string(600, 'b')));
+    }
+
+    std::vector<std::filesystem::path> segments;
+    for (auto& entry : std::filesystem::directory_iterator(directory_)) {
+        segments.push_back(entry.path());
+    }
+    ASSERT_EQ(segments.size(), 2);
+    std::sort(segments.begin(), segments.end());
+    {
+        std::fstream file(segments.front(),
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(400);
+        file.put('c');
+    }
+
+    auto spill = Construct();
+    Accept();
+    spill->StartReplay();
+    WaitUntilReplayed(*spill);
+    spill->StopReplay();
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(replayed_, std::vector<std::string>{ std::string(600, 'b') });
+}
+
+TEST_F(SpillTestFixture, RetryUntilAccepted)
+{
+    auto spill = Construct();
+    ASSERT_TRUE(Append(*spill, "test a=1i"));
+
+    EXPECT_CALL(*http_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::Throw(std::runtime_error("dummy error")))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::service_unavailable, 11 }))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11 }));
+
+    spill->StartReplay();
+    WaitUntilReplayed(*spill);
+    spill->StopReplay();
+}
+
+} // namespace opengemini::test
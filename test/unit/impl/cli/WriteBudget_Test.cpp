@@ -0,0 +1,179 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/cli/write/WriteBudget.hpp"
+#include "test/ExpectThrowAs.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class WriteBudgetTestFixture : public TestFixtureWithContext { };
+
+TEST_F(WriteBudgetTestFixture, ConstructWithInvalidConfig)
+{
+    EXPECT_THROW_AS(
+        (cli::WriteBudget(ctx_(),
+                          WriteBudgetConfig{ 0, WriteBudgetPolicy::Fail })),
+        errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(WriteBudgetTestFixture, FailWhenExceeded)
+{
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 100, WriteBudgetPolicy::Fail });
+    budget.Acquire(60);
+    EXPECT_THROW_AS(budget.Acquire(60),
+                    errc::RuntimeErrors::WriteBudgetExceeded);
+    budget.Acquire(40);
+
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.bytes, 100);
+    EXPECT_EQ(statistics.rejected, 1);
+
+    budget.Release(100);
+    EXPECT_EQ(budget.Statistics().bytes, 0);
+}
+
+TEST_F(WriteBudgetTestFixture, LetLargeWriteThroughAlone)
+{
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 100, WriteBudgetPolicy::Fail });
+    budget.Acquire(500);
+    EXPECT_THROW_AS(budget.Acquire(1),
+                    errc::RuntimeErrors::WriteBudgetExceeded);
+    budget.Release(500);
+    budget.Acquire(1);
+}
+
+TEST_F(WriteBudgetTestFixture, BlockUntilReleased)
+{
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 100, WriteBudgetPolicy::Block });
+    auto ticket = budget.Track({});
+    budget.Acquire(80);
+    ticket->Hold(80);
+
+    auto blocked =
+        std::async(std::launch::async, [&budget] { budget.Acquire(80); });
+    EXPECT_EQ(blocked.wait_for(50ms), std::future_status::timeout);
+
+    ticket.reset();
+    blocked.get();
+
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.bytes, 80);
+    EXPECT_EQ(statistics.blocked, 1);
+}
+
+TEST_F(WriteBudgetTestFixture, NeverBlockThreadsOfContext)
+{
+    cli::WriteBudget budget(ctx_(),
+                            WriteBudgetConfig{ 100, WriteBudgetPolicy::Block });
+    budget.Acquire(80);
+
+    std::promise<void> promise;
+    boost::asio::post(ctx_(), [&budget, &promise] {
+        try {
+            budget.Acquire(80);
+            promise.set_value();
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    });
+    EXPECT_THROW_AS(promise.get_future().get(),
+                    errc::RuntimeErrors::WriteBudgetExceeded);
+    EXPECT_EQ(budget.Statistics().rejected, 1);
+}
+
+TEST_F(WriteBudgetTestFixture, DropOldestQueued)
+{
+    cli::WriteBudget budget(
+        ctx_(),
+        WriteBudgetConfig{ 100, WriteBudgetPolicy::DropOldest });
+
+    std::vector<int>                                       dropped;
+    std::vector<std::shared_ptr<cli::WriteBudget::Ticket>> tickets;
+    for (auto idx = 0; idx < 3; ++idx) {
+        budget.Acquire(30);
+        tickets.push_back(budget.Track([&dropped, idx] {
+            dropped.push_back(idx);
+            return std::size_t{ 2 };
+        }));
+        tickets.back()->Hold(30);
+    }
+
+    // Started writes are no longer dropped.
+    EXPECT_TRUE(tickets[0]->Start());
+    budget.Acquire(30);
+    EXPECT_EQ(dropped, std::vector<int>{ 1 });
+    EXPECT_FALSE(tickets[1]->Start());
+
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.bytes, 90);
+    EXPECT_EQ(statistics.dropped, 2);
+
+    tickets.clear();
+    EXPECT_EQ(budget.Statistics().bytes, 30);
+}
+
+TEST_F(WriteBudgetTestFixture, FailWhenNothingToDrop)
+{
+    cli::WriteBudget budget(
+        ctx_(),
+        WriteBudgetConfig{ 100, WriteBudgetPolicy::DropOldest });
+    auto ticket = budget.Track([] { return std::size_t{ 1 }; });
+    budget.Acquire(80);
+    ticket->Hold(80);
+    EXPECT_TRUE(ticket->Start());
+
+    EXPECT_THROW_AS(budget.Acquire(80),
+                    errc::RuntimeErrors::WriteBudgetExceeded);
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.dropped, 0);
+    EXPECT_EQ(statistics.rejected, 1);
+}
+
+TEST_F(WriteBudgetTestFixture, ReleaseDroppedBytesOnceDiscarded)
+{
+    cli::WriteBudget budget(
+        ctx_(),
+        WriteBudgetConfig{ 100, WriteBudgetPolicy::DropOldest });
+
+    std::size_t held{ 0 };
+    auto        ticket = budget.Charge(80, [&budget, &held] {
+        held = budget.Statistics().bytes;
+        return std::size_t{ 1 };
+    });
+    EXPECT_EQ(budget.Statistics().bytes, 80);
+
+    budget.Acquire(80);
+    EXPECT_EQ(held, 80);
+    EXPECT_FALSE(ticket->Start());
+
+    auto statistics = budget.Statistics();
+    EXPECT_EQ(statistics.bytes, 80);
+    EXPECT_EQ(statistics.dropped, 1);
+}
+
+} // namespace opengemini::test
@@ -12,15 +12,44 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "opengemini/CompletionToken.hpp"
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
 #include "test/ClientImplTestFixture.hpp"
 #include "test/ExpectThrowAs.hpp"
 
 namespace opengemini::test {
 
+struct Sample {
+    std::string host;
+    int64_t     value;
+    Point::Time time;
+};
+
+} // namespace opengemini::test
+
+template<>
+struct opengemini::MeasurementTraits<opengemini::test::Sample> {
+    using T = opengemini::test::Sample;
+
+    static constexpr auto measurement = schema::Measurement("test");
+    static constexpr auto tags = std::make_tuple(schema::Tag("T0", &T::host));
+    static constexpr auto fields =
+        std::make_tuple(schema::Field("a", &T::value));
+    static constexpr auto time = &T::time;
+};
+
+namespace opengemini::test {
+
 using namespace std::string_literals;
 using namespace duration_literals;
 
@@ -35,6 +64,14 @@ MATCHER_P(IsTargetEq,
     return arg.target() == expect;
 }
 
+MATCHER_P(IsBodyEq,
+          expect,
+          "Body"s + (negation ? "is" : "isn't") + " equal to " +
+              testing::PrintToString(expect))
+{
+    return arg.body() == expect;
+}
+
 #define EXPECT_TARGET(TARGET)                                                  \
     EXPECT_CALL(                                                               \
         *mockHttp_,                                                            \
@@ -46,14 +83,14 @@ MATCHER_P(IsTargetEq,
 
 TEST_F(WriteTestFixture, SingleWriteSuccess)
 {
-    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=)");
+    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=&precision=ns)");
     impl_.Write<Point>(
         "test_db_cxx",
         { "test", { { "a", 1 } }, Point::Time{ 1ns }, { { "T0", "0" } } },
         {},
         token::sync);
 
-    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=test_rp_cxx)");
+    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=test_rp_cxx&precision=ns)");
     impl_.Write<Point>(
         "test_db_cxx",
         { "test", { { "a", 1 } }, Point::Time{ 1ns }, { { "T0", "0" } } },
@@ -104,16 +141,138 @@ TEST_F(WriteTestFixture, MultipleWriteSuccess)
         { "test", { { "a", 1 } }, Point::Time{ 1ns }, { { "T0", "0" } } },
     };
 
-    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=)");
+    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=&precision=ns)");
     impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
 
-    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=test_rp_cxx)");
+    EXPECT_TARGET(R"(/write?db=test_db_cxx&rp=test_rp_cxx&precision=ns)");
     impl_.Write<std::vector<Point>>("test_db_cxx",
                                     std::move(points),
                                     "test_rp_cxx",
                                     token::sync);
 }
 
+TEST_F(WriteTestFixture, LargeMultipleWriteEncodedInParallel)
+{
+    // Large enough to be split into chunks with the default threshold.
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 50000; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::nanoseconds(idx) },
+                           { { "T0", std::to_string(idx % 10) } } });
+    }
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq(enc::LineProtocolEncoder{}.Encode(points)),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+    points[points.size() / 2].fields.clear();
+    EXPECT_THROW_AS(impl_.Write<std::vector<Point>>("test_db_cxx",
+                                                    std::move(points),
+                                                    {},
+                                                    token::sync),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(WriteTestFixture, ReturnPartsToPoolAfterFailedWrite)
+{
+    auto  hackImpl           = HackingMember(impl_);
+    auto& writeOptions       = impl_.*(std::get<3>(hackImpl));
+    auto& buffers            = impl_.*(std::get<5>(hackImpl));
+    writeOptions.concurrency = 4;
+
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 50000; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::nanoseconds(idx) } });
+    }
+
+    boost::system::error_code refused(boost::asio::error::connection_refused);
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::Throw(Exception(refused)));
+    EXPECT_THROW(
+        impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync),
+        Exception);
+
+    // The parts were encoded in parallel, and went back to the pool with their
+    // storage although sending them threw.
+    EXPECT_GE(buffers.Acquire()->capacity(), 1024);
+}
+
+TEST_F(WriteTestFixture, MultipleWriteStreamedInChunks)
+{
+    auto& options     = impl_.*(std::get<3>(HackingMember(impl_)));
+    options.chunkSize = 64;
+
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 1000; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::nanoseconds(idx) },
+                           { { "T0", std::to_string(idx % 10) } } });
+    }
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq(enc::LineProtocolEncoder{}.Encode(points)),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
+
+    // Failing to encode a chunk fails the write with the original error.
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+    points[points.size() / 2].fields.clear();
+    EXPECT_THROW_AS(impl_.Write<std::vector<Point>>("test_db_cxx",
+                                                    std::move(points),
+                                                    {},
+                                                    token::sync),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(WriteTestFixture, MultipleWriteSortedBySeries)
+{
+    auto& options        = impl_.*(std::get<3>(HackingMember(impl_)));
+    options.sortBySeries = true;
+
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 30; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::nanoseconds(30 - idx) },
+                           { { "T0", std::to_string(idx % 3) } } });
+    }
+
+    std::vector<Point> sorted;
+    for (auto idx : enc::OrderBySeries(boost::span<const Point>(points))) {
+        sorted.push_back(points[idx]);
+    }
+    auto expect = enc::LineProtocolEncoder{}.Encode(sorted);
+    ASSERT_NE(expect, enc::LineProtocolEncoder{}.Encode(points));
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_, IsBodyEq(expect), testing::_))
+        .Times(2)
+        .WillRepeatedly(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
+
+    // The streamed write sends the same order.
+    options.chunkSize = 8;
+    impl_.Write<std::vector<Point>>("test_db_cxx",
+                                    std::move(points),
+                                    {},
+                                    token::sync);
+}
+
 TEST_F(WriteTestFixture, MultipleWriteWithEmptyPointsVector)
 {
     EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
@@ -151,4 +310,593 @@ TEST_F(WriteTestFixture, MultipleWriteWithInvalidPoints)
         errc::LogicErrors::InvalidArgument);
 }
 
+TEST_F(WriteTestFixture, PointBatchWriteSuccess)
+{
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq("test,T0=0 a=1i 1\ntest,T0=0 a=2i 2\n"),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<PointBatch>("test_db_cxx",
+                            { "test",
+                              { { "a", std::vector<int64_t>{ 1, 2 } } },
+                              { Point::Time{ 1ns }, Point::Time{ 2ns } },
+                              { { "T0", "0" } } },
+                            {},
+                            token::sync);
+}
+
+TEST_F(WriteTestFixture, PointBatchWriteWithInvalidColumns)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+    EXPECT_THROW_AS(
+        impl_.Write<PointBatch>("test_db_cxx",
+                                { "test",
+                                  { { "a", std::vector<int64_t>{ 1, 2 } } },
+                                  { Point::Time{ 1ns } } },
+                                {},
+                                token::sync),
+        errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(WriteTestFixture, FlatPointWriteSuccess)
+{
+    EXPECT_CALL(
+        *mockHttp_,
+        SendRequest(testing::_, IsBodyEq("test,T0=0 a=1i 1"), testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<FlatPoint>(
+        "test_db_cxx",
+        { "test", { { "a", 1 } }, Point::Time{ 1ns }, { { "T0", "0" } } },
+        {},
+        token::sync);
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq("test a=1i 1\ntest a=2i 2\n"),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<std::vector<FlatPoint>>(
+        "test_db_cxx",
+        { { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+          { "test", { { "a", 2 } }, Point::Time{ 2ns } } },
+        {},
+        token::sync);
+}
+
+TEST_F(WriteTestFixture, MeasurementTypeWriteSuccess)
+{
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            testing::AllOf(
+                                IsTargetEq(
+                                    R"(/write?db=test_db_cxx&rp=&precision=ns)"),
+                                IsBodyEq("test,T0=0 a=1i 1")),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<Sample>("test_db_cxx",
+                        { "0", 1, Point::Time{ 1ns } },
+                        {},
+                        token::sync);
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq("test,T0=0 a=1i 1\ntest,T0=1 a=2i 2\n"),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<std::vector<Sample>>(
+        "test_db_cxx",
+        { { "0", 1, Point::Time{ 1ns } }, { "1", 2, Point::Time{ 2ns } } },
+        {},
+        token::sync);
+}
+
+TEST_F(WriteTestFixture, PointViewWriteSuccess)
+{
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq(R"(test,T0=0 a=1i,b="x" 1)"),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+
+    auto write = [this] {
+        std::string                         text{ "x" };
+        std::array<PointView::FieldView, 2> fields{ { { "a", int64_t{ 1 } },
+                                                      { "b", text } } };
+        std::array<PointView::TagView, 1>   tags{ { { "T0", "0" } } };
+        return impl_.Write<PointView>(
+            "test_db_cxx",
+            { "test", fields, Point::Time{ 1ns }, tags },
+            {},
+            token::deferred);
+    }();
+    // The viewed data is gone before the deferred write starts.
+    std::move(write)(token::future).get();
+
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            IsBodyEq("test a=1i 1\ntest a=1i 2\n"),
+                            testing::_))
+        .WillOnce(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    std::array<PointView::FieldView, 1> fields{ { { "a", int64_t{ 1 } } } };
+    impl_.Write<std::vector<PointView>>(
+        "test_db_cxx",
+        { { "test", fields, Point::Time{ 1ns } },
+          { "test", fields, Point::Time{ 2ns } } },
+        {},
+        token::sync);
+}
+
+TEST_F(WriteTestFixture, PointViewWriteWithInvalidPoint)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+
+    // Encoding errors are reported through the completion token.
+    auto write = impl_.Write<PointView>("test_db_cxx",
+                                        { "test_measurement" },
+                                        {},
+                                        token::deferred);
+    EXPECT_THROW_AS(std::move(write)(token::future).get(),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST_F(WriteTestFixture, RawLinesWriteSuccess)
+{
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_,
+                            testing::AllOf(
+                                IsTargetEq(
+                                    R"(/write?db=test_db_cxx&rp=&precision=ns)"),
+                                IsBodyEq("test,T0=0 a=1i 1\ntest a=2i 2\n")),
+                            testing::_))
+        .Times(2)
+        .WillRepeatedly(testing::Return(
+            http::Response{ http::Status::no_content, 11, "{}" }));
+    impl_.Write<RawLines>("test_db_cxx",
+                          { "test,T0=0 a=1i 1\ntest a=2i 2\n", true },
+                          {},
+                          token::sync);
+
+    auto shared = std::make_shared<const std::string>(
+        "test,T0=0 a=1i 1\ntest a=2i 2\n");
+    impl_.Write<RawLines>("test_db_cxx", { shared }, {}, token::sync);
+    EXPECT_EQ(*shared, "test,T0=0 a=1i 1\ntest a=2i 2\n");
+}
+
+TEST_F(WriteTestFixture, RawLinesWriteWithInvalidLines)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+    EXPECT_THROW_AS(impl_.Write<RawLines>("test_db_cxx",
+                                          { "test a=1i 1\ntest 2\n", true },
+                                          {},
+                                          token::sync),
+                    errc::LogicErrors::InvalidArgument);
+
+    // Nothing to be sent.
+    impl_.Write<RawLines>("test_db_cxx", {}, {}, token::sync);
+}
+
+TEST_F(WriteTestFixture, WriteSplitByPrecision)
+{
+    testing::InSequence sequence;
+    for (auto [target, body] :
+         { std::pair{ R"(/write?db=test_db_cxx&rp=&precision=ns)",
+                      "test a=2i 2000000000\n" },
+           std::pair{ R"(/write?db=test_db_cxx&rp=&precision=s)",
+                      "test a=1i 1\ntest a=3i 3\n" },
+           std::pair{ R"(/write?db=test_db_cxx&rp=&precision=ms)",
+                      "test a=1i 1500\n" } }) {
+        EXPECT_CALL(*mockHttp_,
+                    SendRequest(testing::_,
+                                testing::AllOf(IsTargetEq(target),
+                                               IsBodyEq(body)),
+                                testing::_))
+            .WillOnce(testing::Return(
+                http::Response{ http::Status::no_content, 11, "{}" }));
+    }
+
+    // One request per precision, since each carries a single one.
+    impl_.Write<std::vector<Point>>(
+        "test_db_cxx",
+        { { "test", { { "a", 1 } }, Point::Time{ 1s }, {}, Precision::Second },
+          { "test", { { "a", 2 } }, Point::Time{ 2s } },
+          { "test",
+            { { "a", 3 } },
+            Point::Time{ 3s },
+            {},
+            Precision::Second } },
+        {},
+        token::sync);
+
+    impl_.Write<RawLines>("test_db_cxx",
+                          { "test a=1i 1500\n", false, Precision::Millisecond },
+                          {},
+                          token::sync);
+}
+
+TEST_F(WriteTestFixture, WriteRefusedByBudget)
+{
+    auto  hackImpl = HackingMember(impl_);
+    auto& ctx      = impl_.*(std::get<0>(hackImpl));
+    auto& budget   = impl_.*(std::get<4>(hackImpl));
+    budget         = std::make_unique<cli::WriteBudget>(
+        ctx(),
+        WriteBudgetConfig{ 1, WriteBudgetPolicy::Fail });
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([&ctx](const Endpoint&,
+                         http::Request&,
+                         boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer(ctx(), 100ms);
+            timer.async_wait(yield);
+            return http::Response{ http::Status::no_content, 11, "{}" };
+        });
+
+    // The first write is let through alone, and holds the budget until it
+    // completes.
+    std::promise<void> first;
+    impl_.Write<Point>(
+        "test_db_cxx",
+        { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+        {},
+        [&first](std::exception_ptr ex) {
+            if (ex) { first.set_exception(ex); }
+            else { first.set_value(); }
+        });
+    EXPECT_THROW_AS(
+        impl_.Write<Point>("test_db_cxx",
+                           { "test", { { "a", 2 } }, Point::Time{ 2ns } },
+                           {},
+                           token::sync),
+        errc::RuntimeErrors::WriteBudgetExceeded);
+    first.get_future().get();
+
+    auto statistics = impl_.GetWriteBudgetStatistics();
+    EXPECT_EQ(statistics.bytes, 0);
+    EXPECT_EQ(statistics.rejected, 1);
+}
+
+TEST_F(WriteTestFixture, SpillWhenNoServerAvailable)
+{
+    auto  hackImpl     = HackingMember(impl_);
+    auto& ctx          = impl_.*(std::get<0>(hackImpl));
+    auto& lb           = impl_.*(std::get<2>(hackImpl));
+    auto& writeOptions = impl_.*(std::get<3>(hackImpl));
+
+    // Every server turns unavailable after the first health check.
+    EXPECT_CALL(*mockHttp_,
+                SendRequest(testing::_, IsTargetEq("/ping"), testing::_))
+        .WillRepeatedly(testing::Throw(std::runtime_error("dummy error")));
+    std::vector<Endpoint> endpoints{ { "127.0.0.1", 1234 } };
+    lb = lb::LoadBalancer::Construct(ctx(), endpoints, mockHttp_, 10ms);
+    lb->StartHealthCheck();
+    std::this_thread::sleep_for(100ms);
+
+    SpillConfig config;
+    config.directory = (std::filesystem::temp_directory_path() /
+                        "opengemini-write-spill")
+                           .string();
+    auto spill = cli::Spill::Construct(ctx(), config, lb, mockHttp_);
+    writeOptions.spill = spill.get();
+
+    impl_.Write<Point>("test_db_cxx",
+                       { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+                       {},
+                       token::sync);
+    EXPECT_GT(spill->Pending(), 0);
+
+    writeOptions.spill = nullptr;
+    spill.reset();
+    std::filesystem::remove_all(config.directory);
+}
+
+TEST_F(WriteTestFixture, RetryOnAnotherServer)
+{
+    auto  hackImpl     = HackingMember(impl_);
+    auto& writeOptions = impl_.*(std::get<3>(hackImpl));
+    writeOptions.retry = RetryConfig{ 3, 1ms, 1ms };
+
+    std::vector<uint16_t>    ports;
+    std::vector<std::string> bodies;
+    auto record = [&ports, &bodies](const Endpoint&            endpoint,
+                                    http::Request&             request,
+                                    boost::asio::yield_context) {
+        ports.push_back(endpoint.port);
+        bodies.push_back(request.body());
+    };
+    boost::system::error_code refused(boost::asio::error::connection_refused);
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::DoAll(
+            testing::Invoke(record),
+            testing::Return(
+                http::Response{ http::Status::service_unavailable, 11 })))
+        .WillOnce(testing::DoAll(testing::Invoke(record),
+                                 testing::Throw(Exception(refused))))
+        .WillOnce(testing::DoAll(
+            testing::Invoke(record),
+            testing::Return(http::Response{ http::Status::no_content, 11 })));
+
+    impl_.Write<Point>("test_db_cxx",
+                       { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+                       {},
+                       token::sync);
+
+    ASSERT_EQ(ports.size(), 3);
+    EXPECT_NE(ports[0], ports[1]);
+    EXPECT_NE(ports[1], ports[2]);
+    EXPECT_EQ(bodies, std::vector<std::string>(3, "test a=1i 1"));
+}
+
+TEST_F(WriteTestFixture, RetryUntilMaxAttempts)
+{
+    auto  hackImpl     = HackingMember(impl_);
+    auto& writeOptions = impl_.*(std::get<3>(hackImpl));
+    writeOptions.retry = RetryConfig{ 3, 1ms, 1ms };
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(3)
+        .WillRepeatedly(testing::Return(
+            http::Response{ http::Status::internal_server_error, 11 }));
+
+    EXPECT_THROW_AS(
+        impl_.Write<Point>("test_db_cxx",
+                           { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+                           {},
+                           token::sync),
+        errc::ServerErrors::UnexpectedStatusCode);
+}
+
+TEST_F(WriteTestFixture, NoRetryOnClientError)
+{
+    auto  hackImpl     = HackingMember(impl_);
+    auto& writeOptions = impl_.*(std::get<3>(hackImpl));
+    writeOptions.retry = RetryConfig{ 3, 1ms, 1ms };
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(
+            testing::Return(http::Response{ http::Status::bad_request, 11 }));
+
+    EXPECT_THROW_AS(
+        impl_.Write<Point>("test_db_cxx",
+                           { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+                           {},
+                           token::sync),
+        errc::ServerErrors::UnexpectedStatusCode);
+}
+
+TEST(WriteRetryTest, BackoffGrowsWithJitter)
+{
+    RetryConfig retry{ 5, 100ms, 1000ms };
+    for (auto idx = 0; idx < 100; ++idx) {
+        auto first = cli::RetryBackoff(retry, 1);
+        EXPECT_GE(first, 50ms);
+        EXPECT_LE(first, 100ms);
+
+        auto third = cli::RetryBackoff(retry, 3);
+        EXPECT_GE(third, 200ms);
+        EXPECT_LE(third, 400ms);
+
+        auto capped = cli::RetryBackoff(retry, 10);
+        EXPECT_GE(capped, 500ms);
+        EXPECT_LE(capped, 1000ms);
+    }
+}
+
+TEST(WriteRetryTest, ClassifyFailures)
+{
+    EXPECT_TRUE(cli::IsRetryable(http::Status::service_unavailable));
+    EXPECT_TRUE(cli::IsRetryable(http::Status::too_many_requests));
+    EXPECT_FALSE(cli::IsRetryable(http::Status::not_implemented));
+    EXPECT_FALSE(cli::IsRetryable(http::Status::bad_request));
+
+    boost::system::error_code timedOut(boost::asio::error::timed_out);
+    EXPECT_TRUE(cli::IsRetryable(Error{ timedOut }));
+    EXPECT_FALSE(cli::IsRetryable(Error{ errc::LogicErrors::InvalidArgument }));
+    EXPECT_FALSE(
+        cli::IsRetryable(Error{ errc::ServerErrors::NoAvailableServer }));
+}
+
+TEST_F(WriteTestFixture, BisectRejectedWrite)
+{
+    auto  hackImpl      = HackingMember(impl_);
+    auto& writeOptions  = impl_.*(std::get<3>(hackImpl));
+    writeOptions.bisect = true;
+
+    std::vector<Point> points;
+    for (auto value : { 1, -1, 2, 3, -1, 4, 5 }) {
+        points.push_back({ "test", { { "a", value } }, Point::Time{ 1ns } });
+    }
+
+    // Rejects every request holding a negative value.
+    std::atomic<std::size_t> requests{ 0 };
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillRepeatedly([&requests](const Endpoint&,
+                                    http::Request&             request,
+                                    boost::asio::yield_context) {
+            ++requests;
+            if (request.body().find("a=-1i") != std::string::npos) {
+                return http::Response{ http::Status::bad_request,
+                                       11,
+                                       "negative value" };
+            }
+            return http::Response{ http::Status::no_content, 11 };
+        });
+
+    try {
+        impl_.Write<std::vector<Point>>("test_db_cxx",
+                                        points,
+                                        {},
+                                        token::sync);
+        FAIL() << "Rejected points not reported";
+    }
+    catch (const PartialWriteException& ex) {
+        EXPECT_EQ(ex.UnderlyingError().Code(),
+                  errc::ServerErrors::PartialWrite);
+        ASSERT_EQ(ex.Rejected().size(), 2);
+        for (auto& rejected : ex.Rejected()) {
+            EXPECT_EQ(rejected.line, "test a=-1i 1");
+            EXPECT_EQ(rejected.reason, "negative value");
+        }
+    }
+    // The whole 7, its halves of 3 and 4, their halves of 1 and 2 and of 2 and
+    // 2, then the halves of the two pairs holding a rejected point.
+    EXPECT_EQ(requests.load(), 1 + 2 + 4 + 4);
+}
+
+TEST_F(WriteTestFixture, FanOutAcrossServers)
+{
+    auto  hackImpl               = HackingMember(impl_);
+    auto& writeOptions           = impl_.*(std::get<3>(hackImpl));
+    writeOptions.fanOutThreshold = 2;
+
+    std::mutex                                    mutex;
+    std::vector<std::pair<uint16_t, std::string>> requests;
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(2)
+        .WillRepeatedly([&mutex, &requests](const Endpoint&            endpoint,
+                                            http::Request&             request,
+                                            boost::asio::yield_context) {
+            std::lock_guard lock(mutex);
+            requests.emplace_back(endpoint.port, request.body());
+            return http::Response{ http::Status::no_content, 11 };
+        });
+
+    std::vector<Point> points;
+    for (auto value : { 1, 2, 3, 4, 5 }) {
+        points.push_back({ "test", { { "a", value } }, Point::Time{ 1ns } });
+    }
+    impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
+
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_NE(requests[0].first, requests[1].first);
+    std::sort(requests.begin(),
+              requests.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.second < rhs.second;
+              });
+    EXPECT_EQ(requests[0].second, "test a=1i 1\ntest a=2i 1\n");
+    EXPECT_EQ(requests[1].second, "test a=3i 1\ntest a=4i 1\ntest a=5i 1\n");
+}
+
+TEST_F(WriteTestFixture, FanOutReportsFailedParts)
+{
+    auto  hackImpl               = HackingMember(impl_);
+    auto& writeOptions           = impl_.*(std::get<3>(hackImpl));
+    writeOptions.fanOutThreshold = 2;
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(2)
+        .WillRepeatedly([](const Endpoint&,
+                           http::Request&             request,
+                           boost::asio::yield_context) {
+            if (request.body().find("a=5i") != std::string::npos) {
+                return http::Response{ http::Status::internal_server_error,
+                                       11 };
+            }
+            return http::Response{ http::Status::no_content, 11 };
+        });
+
+    try {
+        impl_.Write<RawLines>("test_db_cxx",
+                              { "test a=1i 1\ntest a=2i 1\ntest a=3i 1\n"
+                                "test a=4i 1\ntest a=5i 1\ntest a=6i 1\n" },
+                              {},
+                              token::sync);
+        FAIL() << "Failed part not reported";
+    }
+    catch (const FanOutException& ex) {
+        EXPECT_EQ(ex.UnderlyingError().Code(),
+                  errc::ServerErrors::UnexpectedStatusCode);
+        ASSERT_EQ(ex.Failed().size(), 1);
+        EXPECT_EQ(ex.Failed()[0].firstLine, 3);
+        EXPECT_EQ(ex.Failed()[0].lines, 3);
+        EXPECT_EQ(ex.Failed()[0].error.Code(),
+                  errc::ServerErrors::UnexpectedStatusCode);
+    }
+}
+
+TEST_F(WriteTestFixture, NoFanOutBelowTwiceThreshold)
+{
+    auto  hackImpl               = HackingMember(impl_);
+    auto& writeOptions           = impl_.*(std::get<3>(hackImpl));
+    writeOptions.fanOutThreshold = 3;
+
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(http::Response{ http::Status::no_content,
+                                                  11 }));
+    impl_.Write<RawLines>("test_db_cxx",
+                          { "test a=1i 1\ntest a=2i 1\ntest a=3i 1\n"
+                            "test a=4i 1\ntest a=5i 1\n" },
+                          {},
+                          token::sync);
+}
+
+TEST_F(WriteTestFixture, ReplicateWrites)
+{
+    auto  hackImpl     = HackingMember(impl_);
+    auto& ctx          = impl_.*(std::get<0>(hackImpl));
+    auto& writeOptions = impl_.*(std::get<3>(hackImpl));
+
+    BufferPool buffers;
+    auto       mirrorHttp = std::make_shared<MockIHttpClient>(ctx());
+    auto       replica    = cli::Replica::Construct(
+        ctx(),
+        ReplicaConfig{ { { "127.0.0.2", 1234 } } },
+        mirrorHttp,
+        buffers,
+        std::nullopt,
+        false);
+    writeOptions.replicas.push_back(replica.get());
+
+    const std::string body{ "test a=1i 1\ntest a=2i 1\n" };
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([&body](const Endpoint&, http::Request& request, auto) {
+            EXPECT_EQ(request.body(), body);
+            return http::Response{ http::Status::no_content, 11 };
+        });
+    EXPECT_CALL(*mirrorHttp, SendRequest(testing::_, testing::_, testing::_))
+        .WillOnce([&body](const Endpoint&            endpoint,
+                          http::Request&             request,
+                          boost::asio::yield_context) {
+            EXPECT_EQ(endpoint.host, "127.0.0.2");
+            EXPECT_EQ(request.target(),
+                      "/write?db=test_db_cxx&rp=&precision=ns");
+            EXPECT_EQ(request.body(), body);
+            return http::Response{ http::Status::no_content, 11 };
+        });
+
+    std::vector<Point> points;
+    for (auto value : { 1, 2 }) {
+        points.push_back({ "test", { { "a", value } }, Point::Time{ 1ns } });
+    }
+    impl_.Write<std::vector<Point>>("test_db_cxx", points, {}, token::sync);
+    replica->Close();
+    writeOptions.replicas.clear();
+
+    EXPECT_EQ(replica->Statistics().written, 1);
+}
+
+TEST_F(WriteTestFixture, AggregateWithoutRollup)
+{
+    EXPECT_CALL(*mockHttp_, SendRequest(testing::_, testing::_, testing::_))
+        .Times(0);
+    EXPECT_THROW_AS(impl_.Aggregate("test_db_cxx",
+                                    { "test",
+                                      { { "a", 1 } },
+                                      Point::Time{ 1ns } },
+                                    {}),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_EQ(impl_.GetRollupStatistics().points, 0);
+}
+
 } // namespace opengemini::test
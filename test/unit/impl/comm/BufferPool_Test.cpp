@@ -0,0 +1,96 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/comm/BufferPool.hpp"
+
+namespace opengemini::test {
+
+using namespace opengemini::impl;
+
+TEST(BufferPoolTest, ReuseReleasedBuffer)
+{
+    BufferPool  pool;
+    const char* storage{ nullptr };
+    {
+        auto buffer = pool.Acquire();
+        buffer->assign(1024, 'x');
+        storage = buffer->data();
+    }
+
+    auto buffer = pool.Acquire();
+    EXPECT_TRUE(buffer->empty());
+    EXPECT_GE(buffer->capacity(), 1024);
+    EXPECT_EQ(buffer->data(), storage);
+}
+
+TEST(BufferPoolTest, ReserveFromRecentSizes)
+{
+    BufferPool pool(0);
+    for (auto cnt = 0; cnt < 64; ++cnt) { pool.Acquire()->assign(4096, 'x'); }
+
+    EXPECT_NEAR(pool.ExpectedSize(), 4096, 64);
+    EXPECT_GE(pool.Acquire()->capacity(), 4096);
+}
+
+TEST(BufferPoolTest, DropOversizedBuffer)
+{
+    BufferPool pool(16, 1024);
+    pool.Acquire()->assign(4096, 'x');
+    pool.Acquire()->assign(16, 'x');
+
+    // The oversized buffer was dropped, and new ones never reserve more than
+    // the capacity limit.
+    EXPECT_LE(pool.Acquire()->capacity(), 1024);
+    EXPECT_LE(pool.Acquire()->capacity(), 1024);
+}
+
+TEST(BufferPoolTest, IgnoreBufferMovedOut)
+{
+    BufferPool  pool(1);
+    const char* storage{ nullptr };
+    {
+        auto kept = pool.Acquire();
+        kept->assign(4096, 'x');
+        storage = kept->data();
+
+        auto moved = pool.Acquire();
+        moved->assign(4096, 'x');
+        auto taken = std::move(*moved);
+    }
+
+    // The buffer left without storage neither replaced the idle one nor
+    // dragged the expected size down.
+    EXPECT_EQ(pool.ExpectedSize(), 4096);
+    auto buffer = pool.Acquire();
+    EXPECT_GE(buffer->capacity(), 4096);
+    EXPECT_EQ(buffer->data(), storage);
+}
+
+TEST(BufferPoolTest, MovedLeaseReleasesOnce)
+{
+    BufferPool pool(1);
+    {
+        auto lease1 = pool.Acquire();
+        lease1->assign(128, 'x');
+        auto lease2 = std::move(lease1);
+    }
+
+    auto lease1 = pool.Acquire();
+    auto lease2 = pool.Acquire();
+    EXPECT_NE(lease1->data(), lease2->data());
+}
+
+} // namespace opengemini::test
@@ -0,0 +1,87 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/comm/MpscRing.hpp"
+
+namespace opengemini::test {
+
+using namespace opengemini::impl;
+
+TEST(MpscRingTest, PopInPushOrder)
+{
+    MpscRing<std::string> ring(3);
+    EXPECT_EQ(ring.Capacity(), 4);
+    EXPECT_TRUE(ring.Empty());
+
+    for (auto round = 0; round < 3; ++round) {
+        for (auto idx = 0; idx < 4; ++idx) {
+            auto value = std::to_string(idx);
+            EXPECT_TRUE(ring.TryPush(value));
+            EXPECT_TRUE(value.empty());
+        }
+
+        std::string value = "rejected";
+        EXPECT_FALSE(ring.TryPush(value));
+        EXPECT_EQ(value, "rejected");
+
+        for (auto idx = 0; idx < 4; ++idx) {
+            EXPECT_FALSE(ring.Empty());
+            EXPECT_TRUE(ring.TryPop(value));
+            EXPECT_EQ(value, std::to_string(idx));
+        }
+        EXPECT_TRUE(ring.Empty());
+        EXPECT_FALSE(ring.TryPop(value));
+    }
+}
+
+TEST(MpscRingTest, PushFromMultipleThreads)
+{
+    constexpr std::size_t producers = 8;
+    constexpr std::size_t pushes    = 5000;
+
+    MpscRing<std::pair<std::size_t, std::size_t>> ring(64);
+    std::vector<std::thread>                      threads;
+    for (std::size_t producer = 0; producer < producers; ++producer) {
+        threads.emplace_back([&ring, producer] {
+            for (std::size_t idx = 0; idx < pushes; ++idx) {
+                std::pair value{ producer, idx };
+                while (!ring.TryPush(value)) { std::this_thread::yield(); }
+            }
+        });
+    }
+
+    // Every value is popped once, in the order of its producer.
+    std::vector<std::size_t> next(producers, 0);
+    for (std::size_t popped = 0; popped < producers * pushes;) {
+        std::pair<std::size_t, std::size_t> value;
+        if (!ring.TryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value.second, next[value.first]++);
+        ++popped;
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    EXPECT_TRUE(ring.Empty());
+    for (auto count : next) { EXPECT_EQ(count, pushes); }
+}
+
+} // namespace opengemini::test
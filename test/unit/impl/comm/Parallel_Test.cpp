@@ -0,0 +1,117 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/comm/Parallel.hpp"
+#include "test/ExpectThrowAs.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace std::chrono_literals;
+using namespace opengemini::impl;
+
+class ParallelTestFixture : public TestFixtureWithContext {
+protected:
+    ParallelTestFixture() : TestFixtureWithContext(4) { }
+
+    template<typename TASK>
+    void Run(std::size_t count, const TASK& task)
+    {
+        boost::asio::spawn(
+            ctx_(),
+            [&](auto yield) {
+                RunInParallel(ctx_().get_executor(), count, task, yield);
+            },
+            boost::asio::use_future)
+            .get();
+    }
+};
+
+TEST_F(ParallelTestFixture, RunEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> runs(100);
+    Run(runs.size(), [&runs](std::size_t index) { ++runs[index]; });
+    for (auto& run : runs) { EXPECT_EQ(run, 1); }
+
+    Run(0, [](std::size_t) { FAIL(); });
+}
+
+TEST_F(ParallelTestFixture, RunOnMultipleThreads)
+{
+    std::mutex                mutex;
+    std::set<std::thread::id> threads;
+    Run(8, [&](std::size_t) {
+        std::this_thread::sleep_for(20ms);
+        std::lock_guard lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    });
+    EXPECT_GT(threads.size(), 1);
+}
+
+TEST_F(ParallelTestFixture, RethrowFirstException)
+{
+    std::atomic<int> runs{ 0 };
+    EXPECT_THROW_AS(Run(8,
+                        [&runs](std::size_t index) {
+                            ++runs;
+                            if (index % 2) {
+                                throw Exception(
+                                    errc::LogicErrors::InvalidArgument,
+                                    "odd index");
+                            }
+                        }),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_EQ(runs, 8);
+}
+
+TEST_F(ParallelTestFixture, SpawnCoroutinesWhichSuspend)
+{
+    std::atomic<int> runs{ 0 };
+    auto             start = std::chrono::steady_clock::now();
+    EXPECT_THROW_AS(
+        boost::asio::spawn(
+            ctx_(),
+            [&](auto yield) {
+                SpawnInParallel(
+                    ctx_().get_executor(),
+                    8,
+                    [&](std::size_t index, boost::asio::yield_context yield) {
+                        boost::asio::steady_timer timer(ctx_(), 50ms);
+                        timer.async_wait(yield);
+                        ++runs;
+                        if (index == 3) {
+                            throw Exception(errc::LogicErrors::InvalidArgument,
+                                            "third index");
+                        }
+                    },
+                    yield);
+            },
+            boost::asio::use_future)
+            .get(),
+        errc::LogicErrors::InvalidArgument);
+    EXPECT_EQ(runs, 8);
+    // The timers run concurrently, rather than one after another.
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 8 * 50ms);
+}
+
+} // namespace opengemini::test
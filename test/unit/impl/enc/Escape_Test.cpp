@@ -0,0 +1,111 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/enc/Escape.hpp"
+
+namespace opengemini::test {
+
+using namespace opengemini::impl;
+
+namespace {
+
+constexpr std::pair<enc::EscapeClass, std::string_view> ESCAPES[]{
+    { enc::EscapeClass::Measurement, ", " },
+    { enc::EscapeClass::Tag, ",= " },
+    { enc::EscapeClass::FieldKey, ",= " },
+    { enc::EscapeClass::FieldValue, R"("\)" },
+};
+
+std::vector<std::string> GenerateFuzzedStrings()
+{
+    // Dense strings draw from the whole dictionary, including bytes outside of
+    // ASCII and NUL which must never be escaped. Sparse strings contain a
+    // special character only once in a while, so that the SIMD paths also see
+    // long clean runs before the first match.
+    constexpr char dict[]{ "abcdefghijklmnopqrstuvwxyz0123456789"
+                           ",= \"\\\xff\x80" };
+    constexpr std::string_view specials{ ",= \"\\" };
+
+    std::mt19937                               engine(20240601);
+    std::uniform_int_distribution<std::size_t> denseGen(0, sizeof(dict) - 1);
+    std::uniform_int_distribution<std::size_t> sparseGen(0, 63);
+
+    std::vector<std::string> strings;
+    for (std::size_t length = 0; length <= 130; ++length) {
+        for (auto round = 0; round < 20; ++round) {
+            std::string str(length, 'x');
+            for (auto& ch : str) {
+                if (round % 2) { ch = dict[denseGen(engine)]; }
+                else if (auto idx = sparseGen(engine); idx < specials.size()) {
+                    ch = specials[idx];
+                }
+            }
+            strings.push_back(std::move(str));
+        }
+    }
+    return strings;
+}
+
+void ExpectSameAsReference(enc::detail::FindEscapeFunc func)
+{
+    for (const auto& str : GenerateFuzzedStrings()) {
+        for (auto [cls, escapes] : ESCAPES) {
+            auto expect = std::string_view(str).find_first_of(escapes);
+            if (expect == std::string_view::npos) { expect = str.size(); }
+            EXPECT_EQ(func(str, cls), expect) << "string: " << str;
+
+            // Unaligned views into the same storage.
+            if (str.size() > 3) {
+                auto view   = std::string_view(str).substr(3);
+                auto expect = view.find_first_of(escapes);
+                if (expect == std::string_view::npos) { expect = view.size(); }
+                EXPECT_EQ(func(view, cls), expect) << "string: " << view;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(EscapeTest, Scalar)
+{
+    ExpectSameAsReference(&enc::detail::FindEscapeScalar);
+}
+
+TEST(EscapeTest, Sse2)
+{
+    auto func = enc::detail::FindEscapeSse2();
+    if (!func) { GTEST_SKIP() << "SSE2 not supported"; }
+    ExpectSameAsReference(func);
+}
+
+TEST(EscapeTest, Avx2)
+{
+    auto func = enc::detail::FindEscapeAvx2();
+    if (!func) { GTEST_SKIP() << "AVX2 not supported"; }
+    ExpectSameAsReference(func);
+}
+
+TEST(EscapeTest, RuntimeDispatch)
+{
+    ExpectSameAsReference(&enc::FindEscape);
+}
+
+} // namespace opengemini::test
@@ -12,6 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <limits>
+#include <optional>
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "opengemini/impl/enc/LineProtocolEncoder.hpp"
@@ -21,6 +26,54 @@ using namespace std::chrono_literals;
 
 namespace opengemini::test {
 
+struct CpuUsage {
+    std::string                host;
+    std::optional<std::string> rack;
+    double                     usage;
+    int64_t                    procs;
+    uint32_t                   threads;
+    bool                       healthy;
+    std::string                status;
+    std::optional<double>      load;
+    Point::Time                time;
+};
+
+struct Heartbeat {
+    std::optional<int64_t> seq;
+};
+
+} // namespace opengemini::test
+
+template<>
+struct opengemini::MeasurementTraits<opengemini::test::CpuUsage> {
+    using T = opengemini::test::CpuUsage;
+
+    static constexpr auto measurement = schema::Measurement("cpu usage");
+    static constexpr auto tags =
+        std::make_tuple(schema::Tag("host", &T::host),
+                        schema::Tag("rack,id", &T::rack));
+    static constexpr auto fields =
+        std::make_tuple(schema::Field("usage", &T::usage),
+                        schema::Field("procs", &T::procs),
+                        schema::Field("threads", &T::threads),
+                        schema::Field("healthy", &T::healthy),
+                        schema::Field("status=", &T::status),
+                        schema::Field("load", &T::load));
+    static constexpr auto time = &T::time;
+};
+
+template<>
+struct opengemini::MeasurementTraits<opengemini::test::Heartbeat> {
+    using T = opengemini::test::Heartbeat;
+
+    static constexpr auto measurement = schema::Measurement("heartbeat");
+    static constexpr auto fields =
+        std::make_tuple(schema::Field("seq", &T::seq));
+    static constexpr auto precision = Precision::Second;
+};
+
+namespace opengemini::test {
+
 using namespace opengemini::impl;
 
 TEST(LineProtocolEncoderTest, WithoutEscapedChars)
@@ -167,7 +220,19 @@ TEST(LineProtocolEncoderTest, WithDifferentFieldTypes)
                                                   { { "a", 12.345678901234 } },
                                                   Point::Time{ 1ns },
                                                   { { "T0", "0" } } }),
-              R"(test,T0=0 a=12.3457 1)");
+              R"(test,T0=0 a=12.345678901234 1)");
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode({ "test",
+                                                  { { "a", 0.1 + 0.2 } },
+                                                  Point::Time{ 1ns },
+                                                  { { "T0", "0" } } }),
+              R"(test,T0=0 a=0.30000000000000004 1)");
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode({ "test",
+                                                  { { "a", -1e21 } },
+                                                  Point::Time{ 1ns },
+                                                  { { "T0", "0" } } }),
+              R"(test,T0=0 a=-1e+21 1)");
 
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode({ "test",
                                                   { { "a", 12345 } },
@@ -182,6 +247,13 @@ TEST(LineProtocolEncoderTest, WithDifferentFieldTypes)
                                             { { "T0", "0" } } }),
         R"(test,T0=0 a=12345678901234567890u 1)");
 
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(
+                  { "test",
+                    { { "a", std::numeric_limits<int64_t>::min() } },
+                    Point::Time{ 1ns },
+                    { { "T0", "0" } } }),
+              R"(test,T0=0 a=-9223372036854775808i 1)");
+
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode({ "test",
                                                   { { "a", true } },
                                                   Point::Time{ 1ns },
@@ -240,23 +312,23 @@ TEST(LineProtocolEncoderTest, WithDifferentPrecision)
 
     point.precision = Precision::Hour;
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point),
-              "test,T0=0 a=1i 3600000000000");
+              "test,T0=0 a=1i 1");
 
     point.precision = Precision::Minute;
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point),
-              "test,T0=0 a=1i 3720000000000");
+              "test,T0=0 a=1i 62");
 
     point.precision = Precision::Second;
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point),
-              "test,T0=0 a=1i 3723000000000");
+              "test,T0=0 a=1i 3723");
 
     point.precision = Precision::Millisecond;
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point),
-              "test,T0=0 a=1i 3723004000000");
+              "test,T0=0 a=1i 3723004");
 
     point.precision = Precision::Microsecond;
     EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point),
-              "test,T0=0 a=1i 3723004005000");
+              "test,T0=0 a=1i 3723004005");
 }
 
 TEST(LineProtocolEncoderTest, WithEmptyMeasurement)
@@ -335,10 +407,337 @@ TEST(LineProtocolEncoderTest, WithMultiPoints)
         "1\n");
 }
 
+TEST(LineProtocolEncoderTest, WithFuzzedEscapedChars)
+{
+    // Escapes character by character, which is how the encoder used to work
+    // before the block-wise scanning was introduced.
+    auto escape = [](std::string_view origin, std::string_view escapes) {
+        std::string result;
+        for (auto ch : origin) {
+            if (escapes.find(ch) != escapes.npos) { result.push_back('\\'); }
+            result.push_back(ch);
+        }
+        return result;
+    };
+
+    constexpr std::string_view dict{ "abcdefghijklmnopqrstuvwxyz,= \"\\" };
+    std::mt19937                               engine(20240601);
+    std::uniform_int_distribution<std::size_t> charGen(0, dict.size() - 1);
+    std::uniform_int_distribution<std::size_t> lengthGen(1, 80);
+
+    auto generate = [&] {
+        std::string str(lengthGen(engine), 'x');
+        for (auto& ch : str) { ch = dict[charGen(engine)]; }
+        return str;
+    };
+
+    for (auto round = 0; round < 500; ++round) {
+        Point point{ generate(),
+                     { { generate(), generate() } },
+                     Point::Time{ 1ns },
+                     { { generate(), generate() } } };
+
+        auto& [tagKey, tagValue]     = *point.tags.begin();
+        auto& [fieldKey, fieldValue] = *point.fields.begin();
+
+        auto expect =
+            fmt::format(R"({},{}={} {}="{}" 1)",
+                        escape(point.measurement, ", "),
+                        escape(tagKey, ",= "),
+                        escape(tagValue, ",= "),
+                        escape(fieldKey, ",= "),
+                        escape(std::get<std::string>(fieldValue), R"("\)"));
+
+        EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point), expect);
+    }
+}
+
+TEST(LineProtocolEncoderTest, EncodeToCallerBuffer)
+{
+    std::string buffer{ "prefix\n" };
+    buffer.reserve(1024);
+    const auto* storage = buffer.data();
+
+    enc::LineProtocolEncoder{}.EncodeTo(
+        buffer,
+        { { "test", { { "a", 1 } }, Point::Time{ 1ns } },
+          { "test", { { "a", 2 } }, Point::Time{ 2ns } } });
+    EXPECT_EQ(buffer, "prefix\ntest a=1i 1\ntest a=2i 2\n");
+    EXPECT_EQ(buffer.data(), storage);
+
+    buffer.clear();
+    EXPECT_THROW_AS(enc::LineProtocolEncoder{}.EncodeTo(buffer, Point{}),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_EQ(buffer.data(), storage);
+}
+
 TEST(LineProtocolEncoderTest, WithMultiPointsActuallyEmpty)
 {
     EXPECT_TRUE(
         enc::LineProtocolEncoder{}.Encode(std::vector<Point>{}).empty());
 }
 
+TEST(LineProtocolEncoderTest, WithPointBatch)
+{
+    PointBatch batch{ "test measurement",
+                      { { "a", std::vector<int64_t>{ 1, -2 } },
+                        { "b", std::vector<double>{ 0.5, 1e21 } },
+                        { "c", std::vector<uint64_t>{ 3, 4 } },
+                        { "d", std::vector<std::string>{ "x\"y", "z" } },
+                        { "e e", std::vector<bool>{ true, false } } },
+                      { Point::Time{ 1ns }, Point::Time{ 2ns } },
+                      { { "T0", "0" }, { "T 1", "1" } },
+                      { { "R", { "r,0", "" } } } };
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(batch),
+              R"(test\ measurement,T\ 1=1,T0=0,R=r\,0 a=1i,b=0.5,c=3u,)"
+              R"(d="x\"y",e\ e=T 1)"
+              "\n"
+              R"(test\ measurement,T\ 1=1,T0=0 a=-2i,b=1e+21,c=4u,d="z",)"
+              R"(e\ e=F 2)"
+              "\n");
+}
+
+TEST(LineProtocolEncoderTest, WithPointBatchMatchesPoints)
+{
+    PointBatch          batch{ "test", {}, {}, { { "T0", "0" } } };
+    std::vector<Point>  points;
+    std::vector<double> values;
+    for (auto idx = 0; idx < 100; ++idx) {
+        values.push_back(idx * 0.25);
+        batch.times.push_back(Point::Time{ std::chrono::seconds(idx) });
+        points.push_back({ "test",
+                           { { "a", idx * 0.25 } },
+                           Point::Time{ std::chrono::seconds(idx) },
+                           { { "T0", "0" } },
+                           Precision::Second });
+    }
+    batch.fields.emplace("a", std::move(values));
+    batch.precision = Precision::Second;
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(batch),
+              enc::LineProtocolEncoder{}.Encode(points));
+}
+
+TEST(LineProtocolEncoderTest, WithPointBatchWithoutTimes)
+{
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(PointBatch{
+                  "test", { { "a", std::vector<int64_t>{ 1, 2 } } } }),
+              "test a=1i\ntest a=2i\n");
+
+    EXPECT_TRUE(enc::LineProtocolEncoder{}
+                    .Encode(PointBatch{
+                        "test", { { "a", std::vector<int64_t>{} } } })
+                    .empty());
+}
+
+TEST(LineProtocolEncoderTest, WithInvalidPointBatch)
+{
+    std::string buffer{ "prefix" };
+    auto        encodeTo = [&buffer](const PointBatch& batch) {
+        enc::LineProtocolEncoder{}.EncodeTo(buffer, batch);
+    };
+
+    EXPECT_THROW_AS(encodeTo({ "test" }), errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(encodeTo({ {}, { { "a", std::vector<bool>{ true } } } }),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(encodeTo({ "test",
+                               { { "a", std::vector<bool>{ true } },
+                                 { "b", std::vector<bool>{} } } }),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(encodeTo({ "test",
+                               { { "a", std::vector<bool>{ true } } },
+                               { Point::Time{ 1ns }, Point::Time{ 2ns } } }),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_THROW_AS(encodeTo({ "test",
+                               { { "a", std::vector<bool>{ true } } },
+                               {},
+                               {},
+                               { { "R", { "0", "1" } } } }),
+                    errc::LogicErrors::InvalidArgument);
+    EXPECT_EQ(buffer, "prefix");
+}
+
+TEST(LineProtocolEncoderTest, WithSeriesKey)
+{
+    Point point{ "test measurement",
+                 { { "a", 1 } },
+                 Point::Time{ 1ns },
+                 { { "T 0", "0" }, { "T1", "1,1" } } };
+    auto  expected = enc::LineProtocolEncoder{}.Encode(point);
+
+    point.series = SeriesKey{ point.measurement, point.tags };
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point), expected);
+
+    // The measurement and tags of the point are ignored once a series key is
+    // attached.
+    point.measurement.clear();
+    point.tags.clear();
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(point), expected);
+}
+
+TEST(LineProtocolEncoderTest, WithPointBatchWithSeriesKey)
+{
+    PointBatch batch{ {},
+                      { { "a", std::vector<int64_t>{ 1, 2 } } },
+                      { Point::Time{ 1ns }, Point::Time{ 2ns } },
+                      {},
+                      { { "R", { "0", "" } } } };
+    batch.series = SeriesKey{ "test", { { "T0", "0" } } };
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(batch),
+              "test,T0=0,R=0 a=1i 1\ntest,T0=0 a=2i 2\n");
+}
+
+TEST(LineProtocolEncoderTest, WithFlatPoint)
+{
+    FlatPoint flat{ "test measurement",
+                    { { "b", "x\"y" }, { "a", 1 }, { "c", 0.5 } },
+                    Point::Time{ 1ns },
+                    { { "T1", "1,1" }, { "T 0", "0" } } };
+    Point     point{ "test measurement",
+                     { { "b", "x\"y" }, { "a", 1 }, { "c", 0.5 } },
+                     Point::Time{ 1ns },
+                     { { "T1", "1,1" }, { "T 0", "0" } } };
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(flat),
+              enc::LineProtocolEncoder{}.Encode(point));
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(std::vector{ flat, flat }),
+              enc::LineProtocolEncoder{}.Encode(std::vector{ point, point }));
+
+    flat.series = SeriesKey{ "test" };
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(flat),
+              R"(test a=1i,b="x\"y",c=0.5 1)");
+
+    EXPECT_THROW_AS(enc::LineProtocolEncoder{}.Encode(FlatPoint{ "test" }),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST(LineProtocolEncoderTest, WithPointView)
+{
+    std::string name{ "test measurement" };
+    std::string text{ "x\"y" };
+
+    std::array<PointView::FieldView, 3> fields{ { { "a", int64_t{ 1 } },
+                                                  { "b", text },
+                                                  { "c", 0.5 } } };
+    std::array<PointView::TagView, 2>   tags{ { { "T 0", "0" },
+                                                { "T1", "1,1" } } };
+
+    PointView view{ name, fields, Point::Time{ 1ns }, tags };
+    Point     point{ "test measurement",
+                     { { "b", "x\"y" }, { "a", 1 }, { "c", 0.5 } },
+                     Point::Time{ 1ns },
+                     { { "T1", "1,1" }, { "T 0", "0" } } };
+
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(view),
+              R"(test\ measurement,T\ 0=0,T1=1\,1 a=1i,b="x\"y",c=0.5 1)");
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(std::vector{ view }),
+              enc::LineProtocolEncoder{}.Encode(std::vector{ point }));
+
+    std::array<PointView::FieldView, 2> typed{ { { "u", uint64_t{ 2 } },
+                                                 { "ok", true } } };
+    view.fields = typed;
+    view.series = SeriesKey{ "test" };
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(view), "test u=2u,ok=T 1");
+
+    EXPECT_THROW_AS(enc::LineProtocolEncoder{}.Encode(PointView{ name }),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST(LineProtocolEncoderTest, SchemaKeysEscapedAtCompileTime)
+{
+    using Traits = MeasurementTraits<CpuUsage>;
+    static_assert(Traits::measurement.View() == R"(cpu\ usage)");
+    static_assert(std::get<1>(Traits::tags).key.View() == R"(,rack\,id=)");
+    static_assert(std::get<4>(Traits::fields).key.View() == R"(status\==)");
+
+    static_assert(IsMeasurement_v<CpuUsage>);
+    static_assert(!IsMeasurement_v<Point>);
+}
+
+TEST(LineProtocolEncoderTest, WithMeasurementType)
+{
+    CpuUsage usage{ "server 1", "r1",  12.5, -3, 8, true, R"(ok "1")",
+                    0.75,       Point::Time{ 1ns } };
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(usage),
+              R"(cpu\ usage,host=server\ 1,rack\,id=r1 usage=12.5,procs=-3i,)"
+              R"(threads=8u,healthy=T,status\=="ok \"1\"",load=0.75 1)");
+
+    usage.rack.reset();
+    usage.load.reset();
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(usage),
+              R"(cpu\ usage,host=server\ 1 usage=12.5,procs=-3i,)"
+              R"(threads=8u,healthy=T,status\=="ok \"1\"" 1)");
+}
+
+TEST(LineProtocolEncoderTest, WithMultiMeasurementTypes)
+{
+    EXPECT_EQ(enc::LineProtocolEncoder{}.Encode(
+                  std::vector<Heartbeat>{ { 1 }, { 3 } }),
+              "heartbeat seq=1i\nheartbeat seq=3i\n");
+
+    std::string buffer;
+    EXPECT_THROW_AS(enc::LineProtocolEncoder{}.EncodeTo(
+                        buffer,
+                        std::vector<Heartbeat>{ { 1 }, { std::nullopt } }),
+                    errc::LogicErrors::InvalidArgument);
+}
+
+TEST(LineProtocolEncoderTest, OnlyPointsOfGivenPrecision)
+{
+    std::vector<Point> points{
+        { "test", { { "a", 1 } }, Point::Time{ 1s }, {}, Precision::Second },
+        { "test", { { "a", 2 } }, Point::Time{ 2s } },
+        { "test", { { "a", 3 } }, Point::Time{ 3s }, {}, Precision::Second },
+    };
+    const boost::span<const Point> range(points);
+
+    std::string seconds;
+    enc::LineProtocolEncoder{}.EncodeTo(seconds, range, Precision::Second);
+    EXPECT_EQ(seconds, "test a=1i 1\ntest a=3i 3\n");
+
+    std::string nanoseconds;
+    enc::LineProtocolEncoder{}.EncodeTo(nanoseconds,
+                                        range,
+                                        Precision::Nanosecond);
+    EXPECT_EQ(nanoseconds, "test a=2i 2000000000\n");
+
+    std::string hours;
+    enc::LineProtocolEncoder{}.EncodeTo(hours, range, Precision::Hour);
+    EXPECT_TRUE(hours.empty());
+
+    EXPECT_EQ(enc::GetPrecision(points[0]), Precision::Second);
+    EXPECT_EQ(enc::GetPrecision(Heartbeat{}), Precision::Second);
+    EXPECT_EQ(enc::GetPrecision(CpuUsage{}), Precision::Nanosecond);
+}
+
+TEST(LineProtocolEncoderTest, EncodeInChunks)
+{
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 100; ++idx) {
+        points.push_back(
+            { "test", { { "a", idx } }, Point::Time{ 1ns * idx } });
+    }
+    points[50].precision = Precision::Second;
+    boost::span<const Point> rest(points);
+
+    std::string whole;
+    std::string chunk;
+    while (!rest.empty()) {
+        chunk.clear();
+        auto consumed = enc::LineProtocolEncoder{}.EncodeSome(
+            chunk,
+            rest,
+            Precision::Nanosecond,
+            64);
+        ASSERT_GT(consumed, 0);
+        rest = rest.subspan(consumed);
+        EXPECT_TRUE(chunk.size() >= 64 || rest.empty());
+        whole += chunk;
+    }
+    points.erase(points.begin() + 50);
+    EXPECT_EQ(whole, enc::LineProtocolEncoder{}.Encode(points));
+}
+
 } // namespace opengemini::test
@@ -0,0 +1,78 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/enc/LineValidator.hpp"
+#include "test/ExpectThrowAs.hpp"
+
+namespace opengemini::test {
+
+using namespace opengemini::impl;
+
+TEST(LineValidatorTest, AcceptsWellFramedLines)
+{
+    EXPECT_NO_THROW(enc::ValidateLines(""));
+    EXPECT_NO_THROW(enc::ValidateLines("test a=1i"));
+    EXPECT_NO_THROW(enc::ValidateLines("test,T0=0 a=1i,b=2 1\ntest a=T -1\n"));
+    EXPECT_NO_THROW(enc::ValidateLines("# comment\n\r\n\ntest a=1i 1\r\n"));
+    EXPECT_NO_THROW(enc::ValidateLines(R"(test\ measurement,T\ 0=0 a=1i)"));
+    EXPECT_NO_THROW(enc::ValidateLines(R"(test a="x y",b="z\" w" 1)"));
+}
+
+TEST(LineValidatorTest, RejectsMalformedLines)
+{
+    for (auto lines : { " a=1i 1",
+                        ",T0=0 a=1i 1",
+                        "test",
+                        "test ",
+                        "test  a=1i",
+                        R"(test\ a=1i)",
+                        "test,T0=0 1",
+                        "test a=1i ",
+                        "test a=1i 1s",
+                        R"(test a="x y 1)",
+                        "test a=1i 1 2" }) {
+        SCOPED_TRACE(lines);
+        EXPECT_THROW_AS(enc::ValidateLines(lines),
+                        errc::LogicErrors::InvalidArgument);
+    }
+
+    try {
+        enc::ValidateLines("test a=1i 1\n\ntest a=2i 2\ntest 3\n");
+        FAIL() << "Malformed line accepted";
+    }
+    catch (const Exception& exception) {
+        EXPECT_NE(std::string(exception.what()).find("line 4"),
+                  std::string::npos);
+    }
+}
+
+TEST(LineValidatorTest, SplitLinesKeepingQuotedLineBreaks)
+{
+    std::vector<std::string_view> lines;
+    enc::SplitLines("test a=1i 1\n"
+                    "test,T0=\"x\" a=\"y\nz\",b=\"\\\"\n\" 2\n"
+                    "test a=3i 3",
+                    lines);
+    EXPECT_EQ(lines,
+              (std::vector<std::string_view>{
+                  "test a=1i 1\n",
+                  "test,T0=\"x\" a=\"y\nz\",b=\"\\\"\n\" 2\n",
+                  "test a=3i 3" }));
+}
+
+} // namespace opengemini::test
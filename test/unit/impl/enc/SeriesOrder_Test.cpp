@@ -0,0 +1,137 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "opengemini/impl/enc/LineProtocolEncoder.hpp"
+#include "opengemini/impl/enc/SeriesOrder.hpp"
+
+namespace opengemini::test {
+
+using namespace opengemini::impl;
+using namespace std::chrono_literals;
+
+TEST(SeriesOrderTest, GroupsBySeriesAndOrdersByTime)
+{
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 12; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::seconds(12 - idx / 2) },
+                           { { "T0", std::to_string(idx % 3) } } });
+    }
+
+    auto order = enc::OrderBySeries(boost::span<const Point>(points));
+    ASSERT_EQ(order.size(), points.size());
+
+    std::vector<std::string> seen;
+    for (std::size_t idx = 0; idx < order.size(); ++idx) {
+        auto& point = points[order[idx]];
+        auto& tag   = point.tags.at("T0");
+        if (seen.empty() || seen.back() != tag) {
+            EXPECT_EQ(std::count(seen.begin(), seen.end(), tag), 0)
+                << "Series " << tag << " is split";
+            seen.push_back(tag);
+            continue;
+        }
+
+        // Ordered by time, then by the original position for equal times.
+        auto& previous = points[order[idx - 1]];
+        EXPECT_TRUE(previous.time < point.time ||
+                    (previous.time == point.time &&
+                     order[idx - 1] < order[idx]));
+    }
+    EXPECT_EQ(seen.size(), 3);
+}
+
+TEST(SeriesOrderTest, IgnoresOrderOfTags)
+{
+    std::array<PointView::FieldView, 1> fields{ { { "a", int64_t{ 1 } } } };
+    std::array<PointView::TagView, 2>   ab{ { { "a", "0" }, { "b", "1" } } };
+    std::array<PointView::TagView, 2>   ba{ { { "b", "1" }, { "a", "0" } } };
+    std::array<PointView::TagView, 1>   other{ { { "a", "1" } } };
+
+    std::vector<PointView> points{ { "test", fields, Point::Time{ 3s }, ab },
+                                   { "test", fields, Point::Time{ 1s }, other },
+                                   { "test", fields, Point::Time{ 2s }, ba },
+                                   { "test", fields, Point::Time{ 4s }, other },
+                                   { "test", fields, Point::Time{ 1s }, ab } };
+
+    auto order = enc::OrderBySeries(boost::span<const PointView>(points));
+    std::vector<std::size_t> expect;
+    if (order.front() == 1) { expect = { 1, 3, 4, 2, 0 }; }
+    else { expect = { 4, 2, 0, 1, 3 }; }
+    EXPECT_EQ(order, expect);
+}
+
+TEST(SeriesOrderTest, GroupsSeriesKeyWithSameTags)
+{
+    const std::map<std::string, std::string> tags{ { "b", "1" },
+                                                   { "a", "x y" } };
+    const SeriesKey                          series("te,st", tags);
+
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 6; ++idx) {
+        Point point{ "", { { "a", idx } }, Point::Time{ 6s - idx * 1s } };
+        if (idx % 3 == 1) { point.series = series; }
+        else if (idx % 3 == 2) {
+            point.measurement = "te,st";
+            point.tags        = tags;
+        }
+        else {
+            point.measurement = "te,st";
+            point.tags        = { { "a", "x" } };
+        }
+        points.push_back(std::move(point));
+    }
+
+    auto order = enc::OrderBySeries(boost::span<const Point>(points));
+    std::vector<std::size_t> expect;
+    if (order.front() == 5) { expect = { 5, 4, 2, 1, 3, 0 }; }
+    else { expect = { 3, 0, 5, 4, 2, 1 }; }
+    EXPECT_EQ(order, expect);
+}
+
+TEST(SeriesOrderTest, EncodeOrderedPoints)
+{
+    std::vector<Point> points;
+    for (auto idx = 0; idx < 4; ++idx) {
+        points.push_back({ "test",
+                           { { "a", idx } },
+                           Point::Time{ std::chrono::seconds(idx) },
+                           {},
+                           Precision::Second });
+    }
+    std::vector<std::size_t> order{ 3, 1, 2, 0 };
+    enc::OrderedPoints<Point> ordered(boost::span<const Point>(points), order);
+
+    std::string content;
+    enc::LineProtocolEncoder{}.EncodeTo(content,
+                                        ordered.subspan(1),
+                                        Precision::Second);
+    EXPECT_EQ(content, "test a=1i 1\ntest a=2i 2\ntest a=0i\n");
+
+    content.clear();
+    auto consumed = enc::LineProtocolEncoder{}.EncodeSome(content,
+                                                          ordered,
+                                                          Precision::Second,
+                                                          1);
+    EXPECT_EQ(consumed, 1);
+    EXPECT_EQ(content, "test a=3i 3\n");
+}
+
+} // namespace opengemini::test
@@ -0,0 +1,252 @@
+// Copyright 2024 openGemini Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <boost/beast/zlib/inflate_stream.hpp>
+
+#include "opengemini/Exception.hpp"
+#include "opengemini/impl/http/Gzip.hpp"
+#include "test/MockIHttpClient.hpp"
+#include "test/Random.hpp"
+#include "test/TestFixtureWithContext.hpp"
+
+namespace opengemini::test {
+
+using namespace impl::http;
+
+namespace {
+
+std::uint32_t ReadLittleEndian(std::string_view bytes)
+{
+    std::uint32_t value = 0;
+    for (auto idx = 4; idx-- > 0;) {
+        value = value << 8 | static_cast<unsigned char>(bytes[idx]);
+    }
+    return value;
+}
+
+// Decompresses a single gzip member, checking its header and trailer.
+std::string Gunzip(std::string_view member)
+{
+    namespace zlib = boost::beast::zlib;
+
+    EXPECT_GE(member.size(), 18);
+    EXPECT_EQ(member.substr(0, 3), std::string_view("\x1f\x8b\x08", 3));
+    auto deflated = member.substr(10, member.size() - 18);
+
+    auto size = ReadLittleEndian(member.substr(member.size() - 4));
+    std::string          content(size, '\0');
+    zlib::inflate_stream stream;
+    zlib::z_params       params;
+    params.next_in   = deflated.data();
+    params.avail_in  = deflated.size();
+    params.next_out  = content.data();
+    params.avail_out = content.size();
+
+    boost::beast::error_code error;
+    stream.write(params, zlib::Flush::finish, error);
+    EXPECT_EQ(error, zlib::error::end_of_stream);
+    EXPECT_EQ(params.avail_in, 0);
+    EXPECT_EQ(params.avail_out, 0);
+
+    boost::crc_32_type crc;
+    crc.process_bytes(content.data(), content.size());
+    EXPECT_EQ(crc.checksum(),
+              ReadLittleEndian(member.substr(member.size() - 8)));
+    return content;
+}
+
+std::string GenerateLines(std::size_t count)
+{
+    std::string lines;
+    for (auto idx = 0u; idx < count; ++idx) {
+        lines += "cpu,host=" + GenerateRandomString(8)
+                 + " usage=" + std::to_string(GenerateRandomNumber(0, 100))
+                 + "\n";
+    }
+    return lines;
+}
+
+class StringSource : public BodySource {
+public:
+    StringSource(std::string content, std::size_t chunkSize) :
+        content_(std::move(content)),
+        chunkSize_(chunkSize)
+    { }
+
+    void Rewind() override { offset_ = 0; }
+
+    void Next(std::string& chunk) override
+    {
+        chunk = content_.substr(offset_, chunkSize_);
+        offset_ += chunk.size();
+    }
+
+private:
+    std::string content_;
+    std::size_t chunkSize_;
+    std::size_t offset_{ 0 };
+};
+
+} // namespace
+
+TEST(GzipCompressorTest, CompressRoundTrip)
+{
+    GzipCompressor compressor(6);
+    for (auto content :
+         { std::string{}, GenerateLines(1), GenerateLines(5000) }) {
+        std::string member;
+        compressor.Compress(content, member);
+        EXPECT_EQ(Gunzip(member), content);
+    }
+}
+
+TEST(GzipCompressorTest, CompressIncrementally)
+{
+    GzipCompressor compressor(1);
+    auto           content = GenerateLines(5000);
+
+    std::string member;
+    compressor.Begin(member);
+    for (auto offset = 0u; offset < content.size(); offset += 1000) {
+        compressor.Update(std::string_view(content).substr(offset, 1000),
+                          member);
+    }
+    compressor.Finish(member);
+    EXPECT_EQ(Gunzip(member), content);
+    EXPECT_LT(member.size(), content.size() / 2);
+}
+
+TEST(GzipCompressorTest, InvalidLevel)
+{
+    EXPECT_THROW(GzipCompressor(10), Exception);
+    EXPECT_THROW(GzipPool(-1), Exception);
+}
+
+TEST(GzipSourceTest, CompressOtherSource)
+{
+    GzipPool     pool(6);
+    auto         content = GenerateLines(5000);
+    StringSource source(content, 4096);
+    GzipSource   gzip(source, pool.Acquire());
+
+    for (auto round = 0; round < 2; ++round) {
+        std::string member;
+        std::string chunk;
+        gzip.Rewind();
+        for (gzip.Next(chunk); !chunk.empty(); gzip.Next(chunk)) {
+            member += chunk;
+        }
+        EXPECT_EQ(Gunzip(member), content);
+    }
+}
+
+class IHttpClientGzipTest : public TestFixtureWithContext {
+protected:
+    IHttpClientGzipTest() : http_(ctx_()) { http_.EnableGzip(6, 64); }
+
+    template<typename FUNCTION>
+    void Spawn(FUNCTION func)
+    {
+        boost::asio::spawn(ctx_(), func, boost::asio::use_future).get();
+    }
+
+protected:
+    MockIHttpClient http_;
+    Endpoint        endpoint_{ "localhost", 8086 };
+};
+
+TEST_F(IHttpClientGzipTest, CompressOnlyLargeBodies)
+{
+    using boost::beast::http::field;
+
+    auto small = GenerateLines(1).substr(0, 63);
+    auto large = GenerateLines(100);
+
+    EXPECT_CALL(http_, SendRequest)
+        .WillOnce([&](auto&&, Request& request, auto&&) {
+            EXPECT_EQ(request.count(field::content_encoding), 0);
+            EXPECT_EQ(request.body(), small);
+            return Response{};
+        })
+        .WillOnce([&](auto&&, Request& request, auto&&) {
+            EXPECT_EQ(request[field::content_encoding], "gzip");
+            EXPECT_EQ(request[field::content_length],
+                      std::to_string(request.body().size()));
+            EXPECT_EQ(Gunzip(request.body()), large);
+            return Response{};
+        });
+
+    Spawn([&](auto yield) {
+        http_.Post(endpoint_, "/write", small, yield);
+        http_.Post(endpoint_, "/write", large, yield);
+    });
+}
+
+TEST_F(IHttpClientGzipTest, BorrowedBodyIsKept)
+{
+    auto lines = GenerateLines(100);
+    auto body  = lines;
+
+    EXPECT_CALL(http_, SendRequest)
+        .WillOnce([&](auto&&, Request& request, auto&&) {
+            EXPECT_EQ(Gunzip(request.body()), lines);
+            return Response{};
+        });
+
+    Spawn([&](auto yield) {
+        http_.PostBorrowed(endpoint_, "/write", body, yield);
+    });
+    EXPECT_EQ(body, lines);
+}
+
+TEST_F(IHttpClientGzipTest, CompressScatteredBody)
+{
+    std::vector<std::string> parts{ GenerateLines(50), {}, GenerateLines(50) };
+    auto                     lent = parts;
+
+    EXPECT_CALL(http_, SendRequest)
+        .WillOnce([&](auto&&, Request& request, auto&&) {
+            EXPECT_EQ(Gunzip(request.body()), parts[0] + parts[2]);
+            return Response{};
+        });
+
+    Spawn([&](auto yield) {
+        http_.PostScattered(endpoint_, "/write", lent, yield);
+    });
+    EXPECT_EQ(lent, parts);
+}
+
+TEST_F(IHttpClientGzipTest, CompressStreamedBody)
+{
+    using boost::beast::http::field;
+
+    auto         lines = GenerateLines(1000);
+    StringSource source(lines, 1024);
+
+    EXPECT_CALL(http_, SendRequest)
+        .WillOnce([&](auto&&, Request& request, auto&&) {
+            EXPECT_EQ(request[field::content_encoding], "gzip");
+            EXPECT_EQ(Gunzip(request.body()), lines);
+            return Response{};
+        });
+
+    Spawn([&](auto yield) {
+        http_.PostStreamed(endpoint_, "/write", source, yield);
+    });
+}
+
+} // namespace opengemini::test
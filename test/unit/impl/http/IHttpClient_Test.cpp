@@ -70,6 +70,34 @@ protected:
             .get();
     }
 
+    template<typename... Args>
+    Response DoPostScattered(const std::unique_ptr<IHttpClient>& client,
+                             Args&&... args)
+    {
+        return boost::asio::spawn(
+                   ctx_(),
+                   [&](auto yield) {
+                       return client->PostScattered(std::forward<Args>(args)...,
+                                                    yield);
+                   },
+                   boost::asio::use_future)
+            .get();
+    }
+
+    template<typename... Args>
+    Response DoPostShared(const std::unique_ptr<IHttpClient>& client,
+                          Args&&... args)
+    {
+        return boost::asio::spawn(
+                   ctx_(),
+                   [&](auto yield) {
+                       return client->PostShared(std::forward<Args>(args)...,
+                                                 yield);
+                   },
+                   boost::asio::use_future)
+            .get();
+    }
+
 protected:
     std::vector<std::pair<std::unique_ptr<IHttpClient>, Endpoint>> clients_;
 };
@@ -93,6 +121,34 @@ TEST_F(IHttpClientTestFixture, PostRequest)
     }
 }
 
+TEST_F(IHttpClientTestFixture, PostScatteredRequest)
+{
+    const std::vector<std::string> parts{ test::GenerateRandomString(16),
+                                          {},
+                                          test::GenerateRandomString(32) };
+    for (auto& [client, endpoint] : clients_) {
+        auto lent = parts;
+        auto rsp  = DoPostScattered(client, endpoint, "/anything", lent);
+        EXPECT_EQ(rsp.result_int(), 200);
+        EXPECT_THAT(rsp.body(), testing::HasSubstr(parts[0] + parts[2]));
+        EXPECT_EQ(lent, parts);
+    }
+}
+
+TEST_F(IHttpClientTestFixture, PostSharedRequest)
+{
+    auto parts = std::make_shared<const std::vector<std::string>>(
+        std::vector<std::string>{ test::GenerateRandomString(16),
+                                  {},
+                                  test::GenerateRandomString(32) });
+    for (auto& [client, endpoint] : clients_) {
+        auto rsp = DoPostShared(client, endpoint, "/anything", parts);
+        EXPECT_EQ(rsp.result_int(), 200);
+        EXPECT_THAT(rsp.body(),
+                    testing::HasSubstr((*parts)[0] + (*parts)[2]));
+    }
+}
+
 TEST_F(IHttpClientTestFixture, CallFromMultiThreads)
 {
     std::vector<std::future<void>> futures;
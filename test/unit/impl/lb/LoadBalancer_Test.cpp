@@ -104,6 +104,7 @@ TEST_F(LoadBalancerTestFixture, HealthCheckAllAvailable)
     lb->StartHealthCheck();
     std::this_thread::sleep_for(500ms);
 
+    EXPECT_EQ(lb->CountAvailableServers(), endpoints_.size());
     for (const auto& endpoint : endpoints_) {
         EXPECT_EQ(lb->PickAvailableServer(), endpoint);
     }
@@ -120,6 +121,7 @@ TEST_F(LoadBalancerTestFixture, HealthCheckAllUnavailable)
     lb->StartHealthCheck();
     std::this_thread::sleep_for(500ms);
 
+    EXPECT_EQ(lb->CountAvailableServers(), 0);
     EXPECT_THROW_AS(lb->PickAvailableServer(),
                     errc::ServerErrors::NoAvailableServer);
 }
@@ -155,6 +157,8 @@ TEST_F(LoadBalancerTestFixture, HealthCheckPartiallyAvailable)
     lb->StartHealthCheck();
     std::this_thread::sleep_for(500ms);
 
+    EXPECT_EQ(lb->CountAvailableServers(),
+              endpoints_.size() - unavailableEndpoints.size());
     std::vector<std::future<Endpoint>> futures;
     for (std::size_t cnt = 0; cnt < endpoints_.size() * 2; ++cnt) {
         futures.emplace_back(
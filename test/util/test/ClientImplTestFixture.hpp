@@ -27,9 +27,12 @@ namespace opengemini::test {
 using namespace opengemini::impl;
 
 OPENGEMINI_TEST_MEMBER_HACKER(ClientImpl,
-                              &ClientImpl::ctx_,  // 0
-                              &ClientImpl::http_, // 1
-                              &ClientImpl::lb_)   // 2
+                              &ClientImpl::ctx_,          // 0
+                              &ClientImpl::http_,         // 1
+                              &ClientImpl::lb_,           // 2
+                              &ClientImpl::writeOptions_, // 3
+                              &ClientImpl::budget_,       // 4
+                              &ClientImpl::buffers_)      // 5
 
 class ClientImplTestFixture : public testing::Test {
 protected:
@@ -34,7 +34,7 @@ public:
     MOCK_METHOD(impl::http::Response,
                 SendRequest,
                 (const Endpoint&,
-                 impl::http::Request,
+                 impl::http::Request&,
                  boost::asio::yield_context),
                 (override));
 };